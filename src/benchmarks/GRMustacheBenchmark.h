@@ -0,0 +1,92 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The result of a benchmark: the average cost of one operation.
+ */
+@interface GRMustacheBenchmarkResult : NSObject {
+@private
+    NSString *_name;
+    NSString *_phase;
+    NSUInteger _iterations;
+    double _nanosecondsPerOperation;
+    double _allocationsPerOperation;
+    double _bytesPerOperation;
+    NSUInteger _inputLength;
+    NSUInteger _tokenCount;
+}
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSString *phase;
+@property (nonatomic) NSUInteger iterations;
+@property (nonatomic) double nanosecondsPerOperation;
+@property (nonatomic) double allocationsPerOperation;
+@property (nonatomic) double bytesPerOperation;
+
+/**
+ * The number of UTF-8 bytes processed by one operation, or 0 if the benchmark
+ * does not measure throughput.
+ */
+@property (nonatomic) NSUInteger inputLength;
+
+/**
+ * The number of tokens processed by one operation, or 0 if the benchmark does
+ * not measure throughput.
+ */
+@property (nonatomic) NSUInteger tokenCount;
+
+/**
+ * The throughput in MB/s (10^6 bytes per second), derived from inputLength.
+ */
+@property (nonatomic, readonly) double megabytesPerSecond;
+
+/**
+ * The throughput in tokens per second, derived from tokenCount.
+ */
+@property (nonatomic, readonly) double tokensPerSecond;
+
+/**
+ * A dictionary suitable for NSJSONSerialization, with the keys `benchmark`,
+ * `phase`, `iterations`, `ns_per_op`, `allocs_per_op`, and `bytes_per_op`.
+ * Throughput benchmarks also have the `mb_per_s` and `tokens_per_s` keys.
+ */
+- (NSDictionary *)JSONObject;
+@end
+
+/**
+ * Runs an operation repeatedly, and measures its average cost.
+ */
+@interface GRMustacheBenchmark : NSObject
+
+/**
+ * Runs _block_ until both _minimumIterations_ and _minimumDuration_ are
+ * reached, and returns the average cost of one run.
+ *
+ * The block runs once before measurement starts, so that lazy
+ * initializations do not pollute the result. Each run is wrapped in its own
+ * autorelease pool, so that autoreleased objects are accounted to the run that
+ * created them.
+ */
++ (GRMustacheBenchmarkResult *)benchmarkWithName:(NSString *)name phase:(NSString *)phase minimumIterations:(NSUInteger)minimumIterations minimumDuration:(NSTimeInterval)minimumDuration block:(void(^)(void))block;
+
+@end
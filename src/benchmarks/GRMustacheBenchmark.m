@@ -0,0 +1,110 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheBenchmark.h"
+#import "GRMustacheInstrumentation_private.h"
+
+@implementation GRMustacheBenchmarkResult
+@synthesize name=_name;
+@synthesize phase=_phase;
+@synthesize iterations=_iterations;
+@synthesize nanosecondsPerOperation=_nanosecondsPerOperation;
+@synthesize allocationsPerOperation=_allocationsPerOperation;
+@synthesize bytesPerOperation=_bytesPerOperation;
+@synthesize inputLength=_inputLength;
+@synthesize tokenCount=_tokenCount;
+
+- (void)dealloc
+{
+    [_name release];
+    [_phase release];
+    [super dealloc];
+}
+
+- (double)megabytesPerSecond
+{
+    return (_nanosecondsPerOperation > 0) ? (double)_inputLength * 1e3 / _nanosecondsPerOperation : 0;
+}
+
+- (double)tokensPerSecond
+{
+    return (_nanosecondsPerOperation > 0) ? (double)_tokenCount * 1e9 / _nanosecondsPerOperation : 0;
+}
+
+- (NSDictionary *)JSONObject
+{
+    NSMutableDictionary *JSONObject = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+                                       _name, @"benchmark",
+                                       _phase, @"phase",
+                                       [NSNumber numberWithUnsignedInteger:_iterations], @"iterations",
+                                       [NSNumber numberWithDouble:_nanosecondsPerOperation], @"ns_per_op",
+                                       [NSNumber numberWithDouble:_allocationsPerOperation], @"allocs_per_op",
+                                       [NSNumber numberWithDouble:_bytesPerOperation], @"bytes_per_op",
+                                       nil];
+    if (_inputLength > 0) {
+        [JSONObject setObject:[NSNumber numberWithDouble:self.megabytesPerSecond] forKey:@"mb_per_s"];
+    }
+    if (_tokenCount > 0) {
+        [JSONObject setObject:[NSNumber numberWithDouble:self.tokensPerSecond] forKey:@"tokens_per_s"];
+    }
+    return JSONObject;
+}
+
+@end
+
+@implementation GRMustacheBenchmark
+
++ (GRMustacheBenchmarkResult *)benchmarkWithName:(NSString *)name phase:(NSString *)phase minimumIterations:(NSUInteger)minimumIterations minimumDuration:(NSTimeInterval)minimumDuration block:(void(^)(void))block
+{
+    GRMustacheInstrumentationStartCountingAllocations();
+    
+    // Warm up
+    @autoreleasepool {
+        block();
+    }
+    
+    uint64_t minimumNanoseconds = (uint64_t)(minimumDuration * 1e9);
+    NSUInteger iterations = 0;
+    uint64_t start = GRMustacheInstrumentationNanoseconds();
+    uint64_t elapsed = 0;
+    GRMustacheAllocationStats startStats = GRMustacheInstrumentationAllocationStats();
+    while (iterations < minimumIterations || elapsed < minimumNanoseconds) {
+        @autoreleasepool {
+            block();
+        }
+        ++iterations;
+        elapsed = GRMustacheInstrumentationNanoseconds() - start;
+    }
+    GRMustacheAllocationStats endStats = GRMustacheInstrumentationAllocationStats();
+    GRMustacheInstrumentationStopCountingAllocations();
+    
+    GRMustacheBenchmarkResult *result = [[[GRMustacheBenchmarkResult alloc] init] autorelease];
+    result.name = name;
+    result.phase = phase;
+    result.iterations = iterations;
+    result.nanosecondsPerOperation = (double)elapsed / iterations;
+    result.allocationsPerOperation = (double)(endStats.count - startStats.count) / iterations;
+    result.bytesPerOperation = (double)(endStats.bytes - startStats.bytes) / iterations;
+    return result;
+}
+
+@end
@@ -0,0 +1,92 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The shapes of generated templates.
+ */
+typedef NS_ENUM(NSUInteger, GRMustacheBenchmarkTemplateShape) {
+    /**
+     * Long runs of text, with a variable tag every few kilobytes.
+     */
+    GRMustacheBenchmarkTemplateShapeTextHeavy,
+    
+    /**
+     * Variable, section, inverted section and comment tags, with little text
+     * in between.
+     */
+    GRMustacheBenchmarkTemplateShapeTagDense,
+    
+    /**
+     * Tags that use custom delimiters, switched with `{{=<% %>=}}` and
+     * similar set delimiters tags.
+     */
+    GRMustacheBenchmarkTemplateShapeSetDelimiters,
+    
+    /**
+     * Long scoped expressions and nested filter calls, such as
+     * `{{ f(g(a.b.c, d), e) }}`.
+     */
+    GRMustacheBenchmarkTemplateShapeNestedFilters,
+    
+    /**
+     * Unescaped variable tags: `{{{name}}}` and `{{& name}}`.
+     */
+    GRMustacheBenchmarkTemplateShapeTripleMustache,
+};
+
+/**
+ * The number of values of GRMustacheBenchmarkTemplateShape.
+ */
+extern const NSUInteger GRMustacheBenchmarkTemplateShapeCount;
+
+/**
+ * Generates synthetic, valid Mustache templates.
+ *
+ * Generation is deterministic: two generators created with the same seed
+ * generate the same templates, on all platforms.
+ */
+@interface GRMustacheBenchmarkTemplateGenerator : NSObject {
+@private
+    uint64_t _state;
+}
+
+/**
+ * Returns a generator seeded with _seed_.
+ */
++ (instancetype)generatorWithSeed:(uint64_t)seed;
+
+/**
+ * Returns the name of a shape, such as `text_heavy`, for benchmark reports.
+ */
++ (NSString *)nameOfShape:(GRMustacheBenchmarkTemplateShape)shape;
+
+/**
+ * Returns a template of the given shape, whose length is at least _length_.
+ *
+ * The template does not embed any partial, so that it can be compiled by any
+ * template repository.
+ */
+- (NSString *)templateStringWithShape:(GRMustacheBenchmarkTemplateShape)shape minimumLength:(NSUInteger)length;
+
+@end
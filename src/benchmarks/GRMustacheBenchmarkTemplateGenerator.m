@@ -0,0 +1,262 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheBenchmarkTemplateGenerator.h"
+
+const NSUInteger GRMustacheBenchmarkTemplateShapeCount = GRMustacheBenchmarkTemplateShapeTripleMustache + 1;
+
+static NSString * const GRMustacheBenchmarkWords[] = {
+    @"lorem", @"ipsum", @"dolor", @"sit", @"amet", @"consectetur", @"adipisicing", @"elit",
+    @"sed", @"do", @"eiusmod", @"tempor", @"incididunt", @"ut", @"labore", @"et",
+};
+static const NSUInteger GRMustacheBenchmarkWordCount = sizeof(GRMustacheBenchmarkWords) / sizeof(NSString *);
+
+static NSString * const GRMustacheBenchmarkIdentifiers[] = {
+    @"name", @"title", @"items", @"price", @"user", @"description", @"date", @"count",
+};
+static const NSUInteger GRMustacheBenchmarkIdentifierCount = sizeof(GRMustacheBenchmarkIdentifiers) / sizeof(NSString *);
+
+static NSString * const GRMustacheBenchmarkFilters[] = {
+    @"uppercase", @"lowercase", @"capitalized", @"isBlank", @"isEmpty", @"format",
+};
+static const NSUInteger GRMustacheBenchmarkFilterCount = sizeof(GRMustacheBenchmarkFilters) / sizeof(NSString *);
+
+// Delimiter pairs used by the set delimiters shape, after the default ones.
+static NSString * const GRMustacheBenchmarkDelimiters[][2] = {
+    { @"<%", @"%>" },
+    { @"[[", @"]]" },
+    { @"<?mustache", @"?>" },
+};
+static const NSUInteger GRMustacheBenchmarkDelimiterCount = sizeof(GRMustacheBenchmarkDelimiters) / sizeof(GRMustacheBenchmarkDelimiters[0]);
+
+@interface GRMustacheBenchmarkTemplateGenerator()
+- (id)initWithSeed:(uint64_t)seed;
+- (NSUInteger)randomIntegerLessThan:(NSUInteger)bound;
+- (NSString *)word;
+- (NSString *)identifier;
+- (NSString *)scopedIdentifier;
+- (NSString *)expressionWithDepth:(NSUInteger)depth;
+- (void)appendTextHeavyBlockToString:(NSMutableString *)string;
+- (void)appendTagDenseBlockToString:(NSMutableString *)string startDelimiter:(NSString *)start endDelimiter:(NSString *)end;
+- (void)appendSetDelimitersBlockToString:(NSMutableString *)string;
+- (void)appendNestedFiltersBlockToString:(NSMutableString *)string;
+- (void)appendTripleMustacheBlockToString:(NSMutableString *)string;
+@end
+
+@implementation GRMustacheBenchmarkTemplateGenerator
+
++ (instancetype)generatorWithSeed:(uint64_t)seed
+{
+    return [[[self alloc] initWithSeed:seed] autorelease];
+}
+
++ (NSString *)nameOfShape:(GRMustacheBenchmarkTemplateShape)shape
+{
+    switch (shape) {
+        case GRMustacheBenchmarkTemplateShapeTextHeavy:
+            return @"text_heavy";
+        case GRMustacheBenchmarkTemplateShapeTagDense:
+            return @"tag_dense";
+        case GRMustacheBenchmarkTemplateShapeSetDelimiters:
+            return @"set_delimiters";
+        case GRMustacheBenchmarkTemplateShapeNestedFilters:
+            return @"nested_filters";
+        case GRMustacheBenchmarkTemplateShapeTripleMustache:
+            return @"triple_mustache";
+    }
+    return nil;
+}
+
+- (id)initWithSeed:(uint64_t)seed
+{
+    self = [super init];
+    if (self) {
+        // xorshift generators must not be seeded with zero.
+        _state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    }
+    return self;
+}
+
+- (NSString *)templateStringWithShape:(GRMustacheBenchmarkTemplateShape)shape minimumLength:(NSUInteger)length
+{
+    NSMutableString *string = [NSMutableString stringWithCapacity:length];
+    while (string.length < length) {
+        switch (shape) {
+            case GRMustacheBenchmarkTemplateShapeTextHeavy:
+                [self appendTextHeavyBlockToString:string];
+                break;
+            case GRMustacheBenchmarkTemplateShapeTagDense:
+                [self appendTagDenseBlockToString:string startDelimiter:@"{{" endDelimiter:@"}}"];
+                break;
+            case GRMustacheBenchmarkTemplateShapeSetDelimiters:
+                [self appendSetDelimitersBlockToString:string];
+                break;
+            case GRMustacheBenchmarkTemplateShapeNestedFilters:
+                [self appendNestedFiltersBlockToString:string];
+                break;
+            case GRMustacheBenchmarkTemplateShapeTripleMustache:
+                [self appendTripleMustacheBlockToString:string];
+                break;
+        }
+    }
+    return string;
+}
+
+
+#pragma mark - Private
+
+- (NSUInteger)randomIntegerLessThan:(NSUInteger)bound
+{
+    // xorshift64*
+    _state ^= _state >> 12;
+    _state ^= _state << 25;
+    _state ^= _state >> 27;
+    return (NSUInteger)((_state * 2685821657736338717ULL) >> 32) % bound;
+}
+
+- (NSString *)word
+{
+    return GRMustacheBenchmarkWords[[self randomIntegerLessThan:GRMustacheBenchmarkWordCount]];
+}
+
+- (NSString *)identifier
+{
+    return GRMustacheBenchmarkIdentifiers[[self randomIntegerLessThan:GRMustacheBenchmarkIdentifierCount]];
+}
+
+- (NSString *)scopedIdentifier
+{
+    NSMutableString *expression = [NSMutableString stringWithString:[self identifier]];
+    NSUInteger componentCount = [self randomIntegerLessThan:3];
+    for (NSUInteger i = 0; i < componentCount; ++i) {
+        [expression appendFormat:@".%@", [self identifier]];
+    }
+    return expression;
+}
+
+- (NSString *)expressionWithDepth:(NSUInteger)depth
+{
+    if (depth == 0) {
+        return [self scopedIdentifier];
+    }
+    NSString *filter = GRMustacheBenchmarkFilters[[self randomIntegerLessThan:GRMustacheBenchmarkFilterCount]];
+    NSMutableString *expression = [NSMutableString stringWithFormat:@"%@(%@", filter, [self expressionWithDepth:depth - 1]];
+    NSUInteger extraArgumentCount = [self randomIntegerLessThan:3];
+    for (NSUInteger i = 0; i < extraArgumentCount; ++i) {
+        [expression appendFormat:@", %@", [self expressionWithDepth:[self randomIntegerLessThan:depth]]];
+    }
+    [expression appendString:@")"];
+    return expression;
+}
+
+- (void)appendTextHeavyBlockToString:(NSMutableString *)string
+{
+    // About 2 KB of text, then a variable tag.
+    NSUInteger start = string.length;
+    while (string.length - start < 2048) {
+        NSUInteger wordCount = 8 + [self randomIntegerLessThan:8];
+        for (NSUInteger i = 0; i < wordCount; ++i) {
+            [string appendString:[self word]];
+            [string appendString:@" "];
+        }
+        [string appendString:@"\n"];
+    }
+    [string appendFormat:@"<p>{{%@}}</p>\n", [self identifier]];
+}
+
+- (void)appendTagDenseBlockToString:(NSMutableString *)string startDelimiter:(NSString *)start endDelimiter:(NSString *)end
+{
+    // A balanced sequence of about 64 tags.
+    NSMutableArray *openSections = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 64; ++i) {
+        NSUInteger dice = [self randomIntegerLessThan:20];
+        if (dice < 8) {
+            [string appendFormat:@"%@%@%@", start, [self scopedIdentifier], end];
+        } else if (dice < 11 && openSections.count < 4) {
+            NSString *expression = [self scopedIdentifier];
+            [openSections addObject:expression];
+            [string appendFormat:@"%@#%@%@", start, expression, end];
+        } else if (dice < 13 && openSections.count < 4) {
+            NSString *expression = [self identifier];
+            [openSections addObject:expression];
+            [string appendFormat:@"%@^%@%@", start, expression, end];
+        } else if (dice < 17 && openSections.count > 0) {
+            [string appendFormat:@"%@/%@%@", start, [openSections lastObject], end];
+            [openSections removeLastObject];
+        } else if (dice < 18) {
+            [string appendFormat:@"%@! %@ %@%@", start, [self word], [self word], end];
+        } else {
+            [string appendFormat:@"<%@>", [self word]];
+        }
+        if ([self randomIntegerLessThan:4] == 0) {
+            [string appendString:@"\n"];
+        }
+    }
+    while (openSections.count > 0) {
+        [string appendFormat:@"%@/%@%@", start, [openSections lastObject], end];
+        [openSections removeLastObject];
+    }
+    [string appendString:@"\n"];
+}
+
+- (void)appendSetDelimitersBlockToString:(NSMutableString *)string
+{
+    // Switch to custom delimiters, render dense tags, and switch back.
+    NSUInteger index = [self randomIntegerLessThan:GRMustacheBenchmarkDelimiterCount];
+    NSString *start = GRMustacheBenchmarkDelimiters[index][0];
+    NSString *end = GRMustacheBenchmarkDelimiters[index][1];
+    [string appendFormat:@"{{=%@ %@=}}", start, end];
+    [self appendTagDenseBlockToString:string startDelimiter:start endDelimiter:end];
+    [string appendFormat:@"%@& %@ %@", start, [self scopedIdentifier], end];
+    [string appendFormat:@"%@={{ }}=%@\n", start, end];
+}
+
+- (void)appendNestedFiltersBlockToString:(NSMutableString *)string
+{
+    NSUInteger depth = 3 + [self randomIntegerLessThan:4];
+    if ([self randomIntegerLessThan:4] == 0) {
+        NSString *expression = [self expressionWithDepth:depth];
+        [string appendFormat:@"{{# %@ }}{{ %@ }}{{/ %@ }}\n", expression, [self expressionWithDepth:1], expression];
+    } else {
+        [string appendFormat:@"<td>{{ %@ }}</td>\n", [self expressionWithDepth:depth]];
+    }
+}
+
+- (void)appendTripleMustacheBlockToString:(NSMutableString *)string
+{
+    switch ([self randomIntegerLessThan:3]) {
+        case 0:
+            [string appendFormat:@"<div>{{{%@}}}</div>", [self scopedIdentifier]];
+            break;
+        case 1:
+            [string appendFormat:@"<div>{{& %@ }}</div>", [self scopedIdentifier]];
+            break;
+        default:
+            [string appendFormat:@"<div>{{%@}}</div>", [self scopedIdentifier]];
+            break;
+    }
+    if ([self randomIntegerLessThan:4] == 0) {
+        [string appendString:@"\n"];
+    }
+}
+
+@end
@@ -0,0 +1,58 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A benchmark workload: a set of templates, and the data they render.
+ *
+ * All templates of a workload live in a dictionary-based template repository.
+ * The rendered template is named `main`, other templates are its partials.
+ */
+@interface GRMustacheBenchmarkWorkload : NSObject {
+@private
+    NSString *_name;
+    NSDictionary *_templates;
+    id _data;
+}
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, retain) NSDictionary *templates;
+@property (nonatomic, retain) id data;
+
+/**
+ * The workloads, in the order they should be reported:
+ *
+ * - `flat_text`: a 1 MB template made of text and a few variable tags.
+ * - `deep_nesting`: 200 nested sections.
+ * - `large_list`: a 100,000 items list.
+ * - `heavy_filters`: chained filters over 10,000 items.
+ * - `layout`: template inheritance through `{{<layout}}`.
+ * - `localized`: localized sections over 1,000 items.
+ */
++ (NSArray *)workloads;
+
+/**
+ * The template string of the rendered template.
+ */
+@property (nonatomic, readonly) NSString *mainTemplateString;
+
+@end
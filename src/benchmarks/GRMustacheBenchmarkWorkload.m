@@ -0,0 +1,176 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheBenchmarkWorkload.h"
+
+@interface GRMustacheBenchmarkWorkload()
++ (instancetype)workloadWithName:(NSString *)name templates:(NSDictionary *)templates data:(id)data;
++ (instancetype)flatTextWorkload;
++ (instancetype)deepNestingWorkload;
++ (instancetype)largeListWorkload;
++ (instancetype)heavyFiltersWorkload;
++ (instancetype)layoutWorkload;
++ (instancetype)localizedWorkload;
++ (NSArray *)itemsWithCount:(NSUInteger)count;
+@end
+
+@implementation GRMustacheBenchmarkWorkload
+@synthesize name=_name;
+@synthesize templates=_templates;
+@synthesize data=_data;
+
++ (NSArray *)workloads
+{
+    return [NSArray arrayWithObjects:
+            [self flatTextWorkload],
+            [self deepNestingWorkload],
+            [self largeListWorkload],
+            [self heavyFiltersWorkload],
+            [self layoutWorkload],
+            [self localizedWorkload],
+            nil];
+}
+
+- (void)dealloc
+{
+    [_name release];
+    [_templates release];
+    [_data release];
+    [super dealloc];
+}
+
+- (NSString *)mainTemplateString
+{
+    return [_templates objectForKey:@"main"];
+}
+
+
+#pragma mark - Private
+
++ (instancetype)workloadWithName:(NSString *)name templates:(NSDictionary *)templates data:(id)data
+{
+    GRMustacheBenchmarkWorkload *workload = [[[self alloc] init] autorelease];
+    workload.name = name;
+    workload.templates = templates;
+    workload.data = data;
+    return workload;
+}
+
++ (instancetype)flatTextWorkload
+{
+    NSString *paragraph = @"Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.\n";
+    NSMutableString *templateString = [NSMutableString string];
+    while (templateString.length < 1024 * 1024) {
+        for (NSUInteger i = 0; i < 16; ++i) {
+            [templateString appendString:paragraph];
+        }
+        [templateString appendString:@"<p>{{name}}</p>\n"];
+    }
+    return [self workloadWithName:@"flat_text"
+                        templates:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]
+                             data:[NSDictionary dictionaryWithObject:@"Arthur" forKey:@"name"]];
+}
+
++ (instancetype)deepNestingWorkload
+{
+    static const NSUInteger depth = 200;
+    NSMutableString *templateString = [NSMutableString string];
+    id data = [NSDictionary dictionaryWithObject:@"leaf" forKey:@"name"];
+    for (NSUInteger i = 0; i < depth; ++i) {
+        [templateString appendString:@"{{#child}}<div>"];
+        data = [NSDictionary dictionaryWithObject:data forKey:@"child"];
+    }
+    [templateString appendString:@"{{name}}"];
+    for (NSUInteger i = 0; i < depth; ++i) {
+        [templateString appendString:@"</div>{{/child}}"];
+    }
+    return [self workloadWithName:@"deep_nesting"
+                        templates:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]
+                             data:data];
+}
+
++ (instancetype)largeListWorkload
+{
+    NSString *templateString = @"<ul>\n{{#items}}<li>{{name}}: {{price}}</li>\n{{/items}}</ul>\n";
+    return [self workloadWithName:@"large_list"
+                        templates:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]
+                             data:[NSDictionary dictionaryWithObject:[self itemsWithCount:100000] forKey:@"items"]];
+}
+
++ (instancetype)heavyFiltersWorkload
+{
+    NSString *templateString = @"{{#items}}"
+                               @"{{ uppercase(capitalized(lowercase(name))) }} "
+                               @"{{ HTML.escape(URL.escape(name)) }} "
+                               @"{{# isBlank(description) }}-{{^}}{{ javascript.escape(description) }}{{/}}\n"
+                               @"{{/items}}";
+    return [self workloadWithName:@"heavy_filters"
+                        templates:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]
+                             data:[NSDictionary dictionaryWithObject:[self itemsWithCount:10000] forKey:@"items"]];
+}
+
++ (instancetype)layoutWorkload
+{
+    NSDictionary *templates = [NSDictionary dictionaryWithObjectsAndKeys:
+                               @"{{<layout}}"
+                               @"{{$head}}<title>{{title}}</title>{{/head}}"
+                               @"{{$content}}{{#items}}{{>item}}{{/items}}{{/content}}"
+                               @"{{/layout}}", @"main",
+                               @"<html>\n<head>{{$head}}{{/head}}</head>\n"
+                               @"<body>{{>header}}{{$content}}{{/content}}{{>footer}}</body>\n"
+                               @"</html>\n", @"layout",
+                               @"<header>{{title}}</header>\n", @"header",
+                               @"<footer>{{$footer}}&copy; {{title}}{{/footer}}</footer>\n", @"footer",
+                               @"<article><h2>{{name}}</h2><p>{{description}}</p></article>\n", @"item",
+                               nil];
+    NSDictionary *data = [NSDictionary dictionaryWithObjectsAndKeys:
+                          @"Catalog", @"title",
+                          [self itemsWithCount:1000], @"items",
+                          nil];
+    return [self workloadWithName:@"layout" templates:templates data:data];
+}
+
++ (instancetype)localizedWorkload
+{
+    NSString *templateString = @"{{#items}}"
+                               @"{{#localize}}Hello {{name}}, you have {{price}} new messages.{{/localize}}\n"
+                               @"{{/items}}";
+    return [self workloadWithName:@"localized"
+                        templates:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]
+                             data:[NSDictionary dictionaryWithObject:[self itemsWithCount:1000] forKey:@"items"]];
+}
+
++ (NSArray *)itemsWithCount:(NSUInteger)count
+{
+    NSMutableArray *items = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        NSString *description = (i % 3 == 0) ? @"" : [NSString stringWithFormat:@"\"Item\" #%lu & <friends>", (unsigned long)i];
+        [items addObject:[NSDictionary dictionaryWithObjectsAndKeys:
+                          [NSString stringWithFormat:@"item %lu", (unsigned long)i], @"name",
+                          [NSNumber numberWithUnsignedInteger:i % 100], @"price",
+                          description, @"description",
+                          nil]];
+    }
+    return items;
+}
+
+@end
@@ -0,0 +1,242 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// GRMustacheBenchmark measures the cost of parsing, compiling, and rendering
+// representative templates.
+//
+// Usage: GRMustacheBenchmark [--json] [--filter <substring>]
+//                            [--iterations <count>] [--duration <seconds>]
+//                            [--seed <integer>]
+//
+// For each workload, three phases are measured separately:
+//
+// - parse:   GRMustacheParser tokenizes the main template.
+// - compile: GRMustacheCompiler builds the AST from pre-recorded tokens.
+// - render:  the compiled template renders the workload data.
+//
+// Then templates of various shapes are generated (see
+// GRMustacheBenchmarkTemplateGenerator), and their parse and compile phases
+// are measured. Parse and compile results report their throughput in MB/s
+// and tokens/s. The --seed option changes the generated templates.
+//
+// The default output is a human-readable table. With --json, each result is
+// printed as a JSON object on its own line, for regression tracking tools.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheBenchmark.h"
+#import "GRMustacheBenchmarkWorkload.h"
+#import "GRMustacheBenchmarkTemplateGenerator.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateRepository_private.h"
+#import "GRMustacheConfiguration_private.h"
+#import "GRMustacheParser_private.h"
+#import "GRMustacheCompiler_private.h"
+
+
+// =============================================================================
+#pragma mark - GRMustacheBenchmarkTokenRecorder
+
+/**
+ * A parser delegate that records tokens, so that the compiler can be
+ * benchmarked without the cost of parsing.
+ */
+@interface GRMustacheBenchmarkTokenRecorder : NSObject<GRMustacheParserDelegate> {
+@private
+    NSMutableArray *_tokens;
+}
+@property (nonatomic, readonly) NSArray *tokens;
+@end
+
+@implementation GRMustacheBenchmarkTokenRecorder
+@synthesize tokens=_tokens;
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _tokens = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_tokens release];
+    [super dealloc];
+}
+
+- (BOOL)parser:(GRMustacheParser *)parser shouldContinueAfterParsingToken:(GRMustacheToken *)token
+{
+    [_tokens addObject:token];
+    return YES;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - main
+
+static void GRMustacheBenchmarkReport(GRMustacheBenchmarkResult *result, BOOL JSON)
+{
+    if (JSON) {
+        NSData *data = [NSJSONSerialization dataWithJSONObject:[result JSONObject] options:0 error:NULL];
+        NSString *line = [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] autorelease];
+        printf("%s\n", [line UTF8String]);
+    } else {
+        printf("%-16s %-8s %10lu %16.0f ns/op %12.1f allocs/op %14.0f B/op",
+               [result.name UTF8String],
+               [result.phase UTF8String],
+               (unsigned long)result.iterations,
+               result.nanosecondsPerOperation,
+               result.allocationsPerOperation,
+               result.bytesPerOperation);
+        if (result.inputLength > 0) {
+            printf(" %10.2f MB/s %14.0f tokens/s", result.megabytesPerSecond, result.tokensPerSecond);
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+/**
+ * Measures the parse and compile phases of the template named `main` in
+ * _repository_, whose source is _templateString_.
+ */
+static void GRMustacheBenchmarkParseAndCompile(NSString *name, NSString *templateString, GRMustacheTemplateRepository *repository, NSUInteger minimumIterations, NSTimeInterval minimumDuration, BOOL JSON)
+{
+    GRMustacheConfiguration *configuration = repository.configuration;
+    NSUInteger inputLength = [templateString lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    
+    // parse
+    GRMustacheBenchmarkResult *result = [GRMustacheBenchmark benchmarkWithName:name phase:@"parse" minimumIterations:minimumIterations minimumDuration:minimumDuration block:^{
+        GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:configuration] autorelease];
+        [parser parseTemplateString:templateString templateID:@"main"];
+    }];
+    
+    // Record tokens: they feed the compile phase, and give the token count of
+    // both phases.
+    GRMustacheBenchmarkTokenRecorder *recorder = [[[GRMustacheBenchmarkTokenRecorder alloc] init] autorelease];
+    GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:configuration] autorelease];
+    parser.delegate = recorder;
+    [parser parseTemplateString:templateString templateID:@"main"];
+    NSArray *tokens = recorder.tokens;
+    
+    result.inputLength = inputLength;
+    result.tokenCount = tokens.count;
+    GRMustacheBenchmarkReport(result, JSON);
+    
+    // compile
+    result = [GRMustacheBenchmark benchmarkWithName:name phase:@"compile" minimumIterations:minimumIterations minimumDuration:minimumDuration block:^{
+        GRMustacheCompiler *compiler = [[[GRMustacheCompiler alloc] initWithConfiguration:configuration] autorelease];
+        compiler.templateRepository = repository;
+        for (GRMustacheToken *token in tokens) {
+            if (![compiler parser:parser shouldContinueAfterParsingToken:token]) {
+                break;
+            }
+        }
+        [compiler ASTReturningError:NULL];
+    }];
+    result.inputLength = inputLength;
+    result.tokenCount = tokens.count;
+    GRMustacheBenchmarkReport(result, JSON);
+}
+
+int main(int argc, const char * argv[])
+{
+    @autoreleasepool {
+        BOOL JSON = NO;
+        NSString *filter = nil;
+        NSUInteger minimumIterations = 5;
+        NSTimeInterval minimumDuration = 1.0;
+        uint64_t seed = 1;
+        
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "--json") == 0) {
+                JSON = YES;
+            } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+                filter = [NSString stringWithUTF8String:argv[++i]];
+            } else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+                minimumIterations = (NSUInteger)MAX(1, atoi(argv[++i]));
+            } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+                minimumDuration = atof(argv[++i]);
+            } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = strtoull(argv[++i], NULL, 10);
+            } else {
+                fprintf(stderr, "usage: %s [--json] [--filter <substring>] [--iterations <count>] [--duration <seconds>] [--seed <integer>]\n", argv[0]);
+                return 2;
+            }
+        }
+        
+        for (GRMustacheBenchmarkWorkload *workload in [GRMustacheBenchmarkWorkload workloads]) {
+            @autoreleasepool {
+                if (filter && [workload.name rangeOfString:filter].location == NSNotFound) {
+                    continue;
+                }
+                
+                // Load the workload templates once: the compile phase needs
+                // partials to be available from the repository.
+                GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:workload.templates];
+                NSError *error;
+                GRMustacheTemplate *template = [repository templateNamed:@"main" error:&error];
+                if (!template) {
+                    fprintf(stderr, "%s: %s\n", [workload.name UTF8String], [[error localizedDescription] UTF8String]);
+                    return 1;
+                }
+                
+                // parse and compile
+                GRMustacheBenchmarkParseAndCompile(workload.name, workload.mainTemplateString, repository, minimumIterations, minimumDuration, JSON);
+                
+                // render
+                id data = workload.data;
+                GRMustacheBenchmarkResult *result = [GRMustacheBenchmark benchmarkWithName:workload.name phase:@"render" minimumIterations:minimumIterations minimumDuration:minimumDuration block:^{
+                    [template renderObject:data error:NULL];
+                }];
+                GRMustacheBenchmarkReport(result, JSON);
+            }
+        }
+        
+        GRMustacheBenchmarkTemplateGenerator *generator = [GRMustacheBenchmarkTemplateGenerator generatorWithSeed:seed];
+        for (NSUInteger shape = 0; shape < GRMustacheBenchmarkTemplateShapeCount; ++shape) {
+            @autoreleasepool {
+                // Generate even filtered-out shapes, so that --filter does not
+                // change the templates generated for a given seed.
+                NSString *templateString = [generator templateStringWithShape:shape minimumLength:1024 * 1024];
+                NSString *name = [GRMustacheBenchmarkTemplateGenerator nameOfShape:shape];
+                if (filter && [name rangeOfString:filter].location == NSNotFound) {
+                    continue;
+                }
+                
+                // Make sure the generated template is valid.
+                GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:[NSDictionary dictionaryWithObject:templateString forKey:@"main"]];
+                NSError *error;
+                if (![repository templateNamed:@"main" error:&error]) {
+                    fprintf(stderr, "%s: %s\n", [name UTF8String], [[error localizedDescription] UTF8String]);
+                    return 1;
+                }
+                
+                GRMustacheBenchmarkParseAndCompile(name, templateString, repository, minimumIterations, minimumDuration, JSON);
+            }
+        }
+    }
+    return 0;
+}
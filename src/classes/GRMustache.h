@@ -159,6 +159,14 @@ typedef struct {
 #import "GRMustacheRendering.h"
 #import "GRMustacheTag.h"
 #import "GRMustacheConfiguration.h"
+#import "GRMustacheTemplateCache.h"
+#import "GRMustacheProfiler.h"
+#import "GRMustacheTracer.h"
+#import "GRMustacheMetrics.h"
+#import "GRMustacheTemplateAnalysis.h"
+#import "GRMustacheMemoryFootprint.h"
+#import "GRMustacheIncrementalRendering.h"
 #import "GRMustacheLocalizer.h"
+#import "GRMustacheFragmentCache.h"
 #import "NSValueTransformer+GRMustache.h"
 #import "NSFormatter+GRMustache.h"
@@ -259,6 +259,20 @@ static NSString *GRMustacheRenderNSFastEnumeration(id<NSFastEnumeration> self, S
     return buffer;
 }
 
++ (BOOL)isBuiltInRenderingObject:(id<GRMustacheRendering>)renderingObject
+{
+    if ([(id)renderingObject isKindOfClass:[GRMustacheRenderingWithIMP class]]) {
+        // nil, and instances of NSObject
+        return YES;
+    }
+    IMP imp = [(id)renderingObject methodForSelector:@selector(renderForMustacheTag:context:HTMLSafe:error:)];
+    return (imp == (IMP)GRMustacheRenderNSNull ||
+            imp == (IMP)GRMustacheRenderNSNumber ||
+            imp == (IMP)GRMustacheRenderNSString ||
+            imp == (IMP)GRMustacheRenderNSObject ||
+            imp == (IMP)GRMustacheRenderNSFastEnumeration);
+}
+
 
 #pragma mark Private
 
@@ -524,15 +538,51 @@ static NSString *GRMustacheRenderNSFastEnumeration(id<NSFastEnumeration> self, S
             // Non inverted sections render for each item in the list
             
             NSMutableString *buffer = [NSMutableString string];
+            
+            // Loop metadata (@index, @first, etc.) is always provided, since
+            // dynamic partials and rendering objects may read it. The count
+            // of the collection tells the last item.
+            BOOL hasCount = [(id)self respondsToSelector:@selector(count)];
+            if (hasCount || !tag.usesLastIterationMetadata) {
+                NSUInteger count = hasCount ? [(id)self count] : NSUIntegerMax;
+                NSUInteger index = 0;
+                for (id item in self) {
+                    // item enters the context as a context object
+                    GRMustacheContext *itemContext = [context contextByAddingObject:item iterationIndex:index last:(index + 1 == count)];
+                    ++index;
+                    
+                    NSString *rendering = [tag renderContentWithContext:itemContext HTMLSafe:HTMLSafe error:error];
+                    if (rendering) {
+                        [buffer appendString:rendering];
+                    }
+                }
+                return buffer;
+            }
+            
+            // The section content reads @last, and fast enumeration does not
+            // tell the last item: render each item one step late, so that we
+            // know whether it is the last one.
+            NSUInteger index = 0;
+            id pendingItem = nil;
             for (id item in self) {
-                // item enters the context as a context object
-                GRMustacheContext *itemContext = [context contextByAddingObject:item];
-                
+                if (pendingItem) {
+                    GRMustacheContext *itemContext = [context contextByAddingObject:pendingItem iterationIndex:index++ last:NO];
+                    NSString *rendering = [tag renderContentWithContext:itemContext HTMLSafe:HTMLSafe error:error];
+                    if (rendering) {
+                        [buffer appendString:rendering];
+                    }
+                }
+                [pendingItem release];
+                pendingItem = [item retain];
+            }
+            if (pendingItem) {
+                GRMustacheContext *itemContext = [context contextByAddingObject:pendingItem iterationIndex:index last:YES];
                 NSString *rendering = [tag renderContentWithContext:itemContext HTMLSafe:HTMLSafe error:error];
                 if (rendering) {
                     [buffer appendString:rendering];
                 }
             }
+            [pendingItem release];
             return buffer;
         }
             
@@ -57,6 +57,16 @@
     return ((GRMustacheTag *)[_tags objectAtIndex:0]).escapesHTML;
 }
 
+- (BOOL)usesLastIterationMetadata
+{
+    for (GRMustacheTag *tag in _tags) {
+        if (tag.usesLastIterationMetadata) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
 - (NSString *)renderContentWithContext:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error
 {
     NSMutableString *buffer = [NSMutableString string];
@@ -115,6 +125,16 @@
 }
 
 
+#pragma mark - <GRMustacheTemplateComponent>
+
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    for (GRMustacheTag *tag in _tags) {
+        [tag acceptTemplateComponentVisitor:visitor];
+    }
+}
+
+
 #pragma mark - Private
 
 - (id)initWithTags:(NSArray *)tags
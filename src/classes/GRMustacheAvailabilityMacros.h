@@ -33,6 +33,7 @@
 #define GRMUSTACHE_VERSION_6_2  6020
 #define GRMUSTACHE_VERSION_6_3  6030
 #define GRMUSTACHE_VERSION_6_4  6040
+#define GRMUSTACHE_VERSION_6_5  6050
 
 
 
@@ -40,10 +41,10 @@
 
 
 /* 
- * If max GRMustacheVersion not specified, assume 6.4
+ * If max GRMustacheVersion not specified, assume 6.5
  */
 #ifndef GRMUSTACHE_VERSION_MAX_ALLOWED
-#define GRMUSTACHE_VERSION_MAX_ALLOWED    GRMUSTACHE_VERSION_6_4
+#define GRMUSTACHE_VERSION_MAX_ALLOWED    GRMUSTACHE_VERSION_6_5
 #endif
 
 /*
@@ -379,3 +380,104 @@
 
 
 
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER
+ * 
+ * Used on declarations introduced in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MAX_ALLOWED < GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER    UNAVAILABLE_ATTRIBUTE
+#elif GRMUSTACHE_VERSION_MIN_REQUIRED < GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER    WEAK_IMPORT_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER_BUT_DEPRECATED
+ * 
+ * Used on declarations introduced in GRMustache 6.5,
+ * and deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER_BUT_DEPRECATED    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER_BUT_DEPRECATED    AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5
+ * 
+ * Used on declarations introduced in GRMustache 6.0,
+ * but later deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_1_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5
+ * 
+ * Used on declarations introduced in GRMustache 6.1,
+ * but later deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_1_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_1_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    AVAILABLE_GRMUSTACHE_VERSION_6_1_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_2_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5
+ * 
+ * Used on declarations introduced in GRMustache 6.2,
+ * but later deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_2_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_2_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    AVAILABLE_GRMUSTACHE_VERSION_6_2_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_3_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5
+ * 
+ * Used on declarations introduced in GRMustache 6.3,
+ * but later deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_3_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_3_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    AVAILABLE_GRMUSTACHE_VERSION_6_3_AND_LATER
+#endif
+
+/*
+ * AVAILABLE_GRMUSTACHE_VERSION_6_4_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5
+ * 
+ * Used on declarations introduced in GRMustache 6.4,
+ * but later deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define AVAILABLE_GRMUSTACHE_VERSION_6_4_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    DEPRECATED_ATTRIBUTE
+#else
+#define AVAILABLE_GRMUSTACHE_VERSION_6_4_AND_LATER_BUT_DEPRECATED_IN_GRMUSTACHE_VERSION_6_5    AVAILABLE_GRMUSTACHE_VERSION_6_4_AND_LATER
+#endif
+
+/*
+ * DEPRECATED_IN_GRMUSTACHE_VERSION_6_5_AND_LATER
+ * 
+ * Used on types deprecated in GRMustache 6.5
+ */
+#if GRMUSTACHE_VERSION_MIN_REQUIRED >= GRMUSTACHE_VERSION_6_5
+#define DEPRECATED_IN_GRMUSTACHE_VERSION_6_5_AND_LATER    DEPRECATED_ATTRIBUTE
+#else
+#define DEPRECATED_IN_GRMUSTACHE_VERSION_6_5_AND_LATER
+#endif
+
+
+
+
+
+
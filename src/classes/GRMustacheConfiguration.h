@@ -24,6 +24,7 @@
 #import "GRMustacheAvailabilityMacros.h"
 
 @class GRMustacheContext;
+@class GRMustacheTemplateCache;
 
 /**
  * The content type of strings rendered by templates.
@@ -89,6 +90,9 @@ typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
  * at the template level, using a "Set Delimiters tag": see the documentation of
  * these properties.
  *
+ * The rendering limits, such as `maximumRenderingDuration`, abort renderings
+ * that would consume too many resources.
+ *
  * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/configuration.md
  *
  * @see GRMustacheTemplateRepository
@@ -100,6 +104,14 @@ typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
     NSString *_tagStartDelimiter;
     NSString *_tagEndDelimiter;
     GRMustacheContext *_baseContext;
+    NSUInteger _maximumRenderedLength;
+    NSTimeInterval _maximumRenderingDuration;
+    NSUInteger _maximumPartialDepth;
+    NSUInteger _maximumIterationCount;
+    GRMustacheTemplateCache *_templateCache;
+    BOOL _retainsTemplateStrings;
+    NSTimeInterval _missingTemplateLifetime;
+    NSUInteger _maximumMissingTemplateCount;
     BOOL _locked;
 }
 
@@ -214,4 +226,182 @@ typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
  */
 @property (nonatomic, copy) NSString *tagEndDelimiter AVAILABLE_GRMUSTACHE_VERSION_6_4_AND_LATER;
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Limiting Renderings
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The maximum number of characters rendered by a template, or 0 for no limit.
+ * Its default value is 0.
+ *
+ * The limit applies to the characters emitted by text and variable tags, and
+ * to the characters that rendering objects return without rendering them
+ * from a template, before HTML-escaping.
+ *
+ * Renderings that exceed this limit fail with an error of code
+ * GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSUInteger maximumRenderedLength AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum duration of a rendering, in seconds, or 0 for no limit. Its
+ * default value is 0.
+ *
+ * The duration is checked each time a template, a partial, or the content of a
+ * section is rendered. A single slow rendering object, such as a filter or
+ * a rendering object of yours, is not interrupted.
+ *
+ * Renderings that exceed this limit fail with an error of code
+ * GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSTimeInterval maximumRenderingDuration AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum nesting depth of partials, or 0 for no limit. Its default value
+ * is 0.
+ *
+ * The rendered template has depth 0, its partials depth 1, the partials of its
+ * partials depth 2, etc. This limit protects your application from recursive
+ * partials that render deep data structures.
+ *
+ * Renderings that exceed this limit fail with an error of code
+ * GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSUInteger maximumPartialDepth AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum number of times the content of sections is rendered, or 0 for no
+ * limit. Its default value is 0.
+ *
+ * `{{#items}}...{{/items}}` counts as many iterations as there are items in
+ * the collection, and `{{#condition}}...{{/condition}}` counts as one
+ * iteration when the condition is true.
+ *
+ * Renderings that exceed this limit fail with an error of code
+ * GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSUInteger maximumIterationCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Sharing Parsings
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The template cache that shares the parsing of template strings with other
+ * template repositories, or nil. Its default value is nil.
+ *
+ * Set the same template cache to the configurations of several template
+ * repositories, and identical templates are parsed only once:
+ *
+ *     GRMustacheTemplateCache *cache = [GRMustacheTemplateCache templateCache];
+ *
+ *     GRMustacheTemplateRepository *repo1 = [GRMustacheTemplateRepository templateRepositoryWithDirectory:@"/path/to/templates"];
+ *     repo1.configuration.templateCache = cache;
+ *     repo1.configuration.baseContext = ...;
+ *
+ *     GRMustacheTemplateRepository *repo2 = [GRMustacheTemplateRepository templateRepositoryWithDirectory:@"/path/to/templates"];
+ *     repo2.configuration.templateCache = cache;
+ *     repo2.configuration.baseContext = ...;
+ *
+ * Copies of a configuration share its template cache.
+ *
+ * @see GRMustacheTemplateCache
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain) GRMustacheTemplateCache *templateCache AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Retaining Template Strings
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Whether templates loaded by name retain their template string, or not. Its
+ * default value is YES.
+ *
+ * Templates retain their template string so that section tags can provide
+ * their innerTemplateString, and that tags can describe themselves in error
+ * messages.
+ *
+ * When this property is NO, the template string is loaded again from the
+ * file, archive, dictionary or URL it comes from when needed, even after the
+ * repository has been deallocated. This saves the size of the template string
+ * for each template, and is useful for large templates that are not rendered
+ * by [rendering objects](rendering_objects.md) that use innerTemplateString.
+ * The template string must not change in the meantime: a
+ * GRMustacheRenderingException is raised when it can not be loaded again, or
+ * when it has changed.
+ *
+ * Templates built from strings (see [GRMustacheTemplateRepository
+ * templateFromString:error:]), and templates loaded from a custom data source
+ * always retain their template string, because it can not be loaded again
+ * once the repository is gone. Templates loaded by name do not share their
+ * parsing through templateCache when this property is NO.
+ *
+ * @see [GRMustacheTag innerTemplateString]
+ *
+ * @since v6.5
+ */
+@property (nonatomic) BOOL retainsTemplateStrings AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Caching Missing Templates
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The duration, in seconds, during which a template repository remembers that
+ * a template is missing, or 0 if missing templates are not remembered. Its
+ * default value is 0.
+ *
+ * By default, template repositories query their data source each time a
+ * template is requested, and not found. When this property is positive,
+ * the error of a missing template is returned again, without querying the
+ * data source, until the duration has elapsed. This is useful when you probe
+ * for optional templates, and the data source is slow:
+ *
+ *     repository.configuration.missingTemplateLifetime = 60;
+ *
+ *     // Queries the data source at most once a minute
+ *     GRMustacheTemplate *template = [repository templateNamed:@"optional" error:NULL];
+ *
+ * Only "template not found" errors are remembered: templates that exist, but
+ * can not be loaded or compiled, are loaded again on each request. Requests
+ * for templates that are known to be missing are not logged.
+ *
+ * @see maximumMissingTemplateCount
+ * @see [GRMustacheMetrics missingTemplateCacheHitCount]
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSTimeInterval missingTemplateLifetime AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum number of missing templates remembered by a template
+ * repository. Its default value is 1000.
+ *
+ * When this number is reached, the oldest missing templates are forgotten
+ * first.
+ *
+ * @see missingTemplateLifetime
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSUInteger maximumMissingTemplateCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
 @end
@@ -23,6 +23,8 @@
 #import "GRMustacheConfiguration_private.h"
 #import "GRMustache_private.h"
 #import "GRMustacheContext_private.h"
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheTemplateCache_private.h"
 
 static GRMustacheConfiguration *defaultConfiguration;
 
@@ -35,6 +37,14 @@ static GRMustacheConfiguration *defaultConfiguration;
 @synthesize tagStartDelimiter=_tagStartDelimiter;
 @synthesize tagEndDelimiter=_tagEndDelimiter;
 @synthesize baseContext=_baseContext;
+@synthesize maximumRenderedLength=_maximumRenderedLength;
+@synthesize maximumRenderingDuration=_maximumRenderingDuration;
+@synthesize maximumPartialDepth=_maximumPartialDepth;
+@synthesize maximumIterationCount=_maximumIterationCount;
+@synthesize templateCache=_templateCache;
+@synthesize retainsTemplateStrings=_retainsTemplateStrings;
+@synthesize missingTemplateLifetime=_missingTemplateLifetime;
+@synthesize maximumMissingTemplateCount=_maximumMissingTemplateCount;
 @synthesize locked=_locked;
 
 + (void)load
@@ -57,6 +67,7 @@ static GRMustacheConfiguration *defaultConfiguration;
     [_tagStartDelimiter release];
     [_tagEndDelimiter release];
     [_baseContext release];
+    [_templateCache release];
     [super dealloc];
 }
 
@@ -68,6 +79,8 @@ static GRMustacheConfiguration *defaultConfiguration;
         _tagStartDelimiter = [@"{{" retain];    // useless retain that matches the release in dealloc
         _tagEndDelimiter = [@"}}" retain];      // useless retain that matches the release in dealloc
         _baseContext = [[GRMustacheContext contextWithObject:[GRMustache standardLibrary]] retain];
+        _retainsTemplateStrings = YES;
+        _maximumMissingTemplateCount = 1000;
     }
     return self;
 }
@@ -129,6 +142,80 @@ static GRMustacheConfiguration *defaultConfiguration;
     }
 }
 
+- (void)setMaximumRenderedLength:(NSUInteger)maximumRenderedLength
+{
+    [self assertNotLocked];
+    
+    _maximumRenderedLength = maximumRenderedLength;
+}
+
+- (void)setMaximumRenderingDuration:(NSTimeInterval)maximumRenderingDuration
+{
+    [self assertNotLocked];
+    
+    if (maximumRenderingDuration < 0) {
+        [NSException raise:NSInvalidArgumentException format:@"Invalid maximumRenderingDuration:%g", maximumRenderingDuration];
+        return;
+    }
+    
+    _maximumRenderingDuration = maximumRenderingDuration;
+}
+
+- (void)setMaximumPartialDepth:(NSUInteger)maximumPartialDepth
+{
+    [self assertNotLocked];
+    
+    _maximumPartialDepth = maximumPartialDepth;
+}
+
+- (void)setMaximumIterationCount:(NSUInteger)maximumIterationCount
+{
+    [self assertNotLocked];
+    
+    _maximumIterationCount = maximumIterationCount;
+}
+
+- (void)setTemplateCache:(GRMustacheTemplateCache *)templateCache
+{
+    [self assertNotLocked];
+    
+    if (_templateCache != templateCache) {
+        [_templateCache release];
+        _templateCache = [templateCache retain];
+    }
+}
+
+- (void)setRetainsTemplateStrings:(BOOL)retainsTemplateStrings
+{
+    [self assertNotLocked];
+    
+    _retainsTemplateStrings = retainsTemplateStrings;
+}
+
+- (void)setMissingTemplateLifetime:(NSTimeInterval)missingTemplateLifetime
+{
+    [self assertNotLocked];
+    
+    if (missingTemplateLifetime < 0) {
+        [NSException raise:NSInvalidArgumentException format:@"Invalid missingTemplateLifetime:%g", missingTemplateLifetime];
+        return;
+    }
+    
+    _missingTemplateLifetime = missingTemplateLifetime;
+}
+
+- (void)setMaximumMissingTemplateCount:(NSUInteger)maximumMissingTemplateCount
+{
+    [self assertNotLocked];
+    
+    _maximumMissingTemplateCount = maximumMissingTemplateCount;
+}
+
+- (GRMustacheRenderingBudget *)renderingBudget
+{
+    return [GRMustacheRenderingBudget renderingBudgetWithConfiguration:self];
+}
+
 
 #pragma mark - <NSCopying>
 
@@ -139,6 +226,14 @@ static GRMustacheConfiguration *defaultConfiguration;
     configuration.tagStartDelimiter = self.tagStartDelimiter;
     configuration.tagEndDelimiter = self.tagEndDelimiter;
     configuration.baseContext = self.baseContext;
+    configuration.maximumRenderedLength = self.maximumRenderedLength;
+    configuration.maximumRenderingDuration = self.maximumRenderingDuration;
+    configuration.maximumPartialDepth = self.maximumPartialDepth;
+    configuration.maximumIterationCount = self.maximumIterationCount;
+    configuration.templateCache = self.templateCache;
+    configuration.retainsTemplateStrings = self.retainsTemplateStrings;
+    configuration.missingTemplateLifetime = self.missingTemplateLifetime;
+    configuration.maximumMissingTemplateCount = self.maximumMissingTemplateCount;
     return configuration;
 }
 
@@ -24,6 +24,8 @@
 #import "GRMustacheAvailabilityMacros_private.h"
 
 @class GRMustacheContext;
+@class GRMustacheTemplateCache;
+@class GRMustacheRenderingBudget;
 
 // Documented in GRMustacheConfiguration.h
 typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
@@ -40,6 +42,14 @@ typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
     NSString *_tagStartDelimiter;
     NSString *_tagEndDelimiter;
     GRMustacheContext *_baseContext;
+    NSUInteger _maximumRenderedLength;
+    NSTimeInterval _maximumRenderingDuration;
+    NSUInteger _maximumPartialDepth;
+    NSUInteger _maximumIterationCount;
+    GRMustacheTemplateCache *_templateCache;
+    BOOL _retainsTemplateStrings;
+    NSTimeInterval _missingTemplateLifetime;
+    NSUInteger _maximumMissingTemplateCount;
     BOOL _locked;
 }
 
@@ -62,6 +72,38 @@ typedef NS_ENUM(NSUInteger, GRMustacheContentType) {
 // Documented in GRMustacheConfiguration.h
 @property (nonatomic, retain) GRMustacheContext *baseContext;
 
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSUInteger maximumRenderedLength GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSTimeInterval maximumRenderingDuration GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSUInteger maximumPartialDepth GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSUInteger maximumIterationCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic, retain) GRMustacheTemplateCache *templateCache GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) BOOL retainsTemplateStrings GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSTimeInterval missingTemplateLifetime GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheConfiguration.h
+@property (nonatomic) NSUInteger maximumMissingTemplateCount GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Returns the rendering limits of the receiver, or nil if the receiver does not
+ * define any limit.
+ *
+ * @see GRMustacheRenderingBudget
+ */
+@property (nonatomic, retain, readonly) GRMustacheRenderingBudget *renderingBudget GRMUSTACHE_API_INTERNAL;
+
 /**
  * Whether the receiver is locked or not.
  *
@@ -24,6 +24,9 @@
 #import <Foundation/Foundation.h>
 #import "GRMustacheAvailabilityMacros.h"
 #import "GRMustacheTagDelegate.h"
+#import "GRMustacheTracer.h"
+
+@class GRMustacheProfiler;
 
 /**
  * The GRMustacheContext represents a Mustache rendering context: it internally
@@ -48,6 +51,13 @@
     id<GRMustacheTagDelegate> _tagDelegate;
     GRMustacheContext *_templateOverrideParent;
     id _templateOverride;
+    id _profiler;
+    id _renderingSession;
+    id<GRMustacheTracer> _tracer;
+    id _renderingSegment;
+    BOOL _hasIterationMetadata;
+    NSUInteger _iterationIndex;
+    BOOL _iterationIsLast;
 }
 
 
@@ -152,4 +162,44 @@
  */
 - (GRMustacheContext *)contextByAddingTagDelegate:(id<GRMustacheTagDelegate>)tagDelegate AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER;
 
+/**
+ * Returns a new rendering context that is the copy of the receiver, and the
+ * given profiler attached.
+ *
+ * Profilers are not stacked: a context has at most one profiler, and the
+ * returned context replaces the profiler of the receiver, if any. A nil
+ * profiler returns a context without any profiler.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/profiling.md
+ *
+ * @param profiler  A profiler
+ *
+ * @return A new rendering context.
+ *
+ * @see GRMustacheProfiler
+ *
+ * @since v6.5
+ */
+- (GRMustacheContext *)contextByAddingProfiler:(GRMustacheProfiler *)profiler AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns a new rendering context that is the copy of the receiver, and the
+ * given tracer attached.
+ *
+ * Tracers are not stacked: a context has at most one tracer, and the returned
+ * context replaces the tracer of the receiver, if any. A nil tracer returns a
+ * context without any tracer.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/profiling.md
+ *
+ * @param tracer  A tracer
+ *
+ * @return A new rendering context.
+ *
+ * @see GRMustacheTracer
+ *
+ * @since v6.5
+ */
+- (GRMustacheContext *)contextByAddingTracer:(id<GRMustacheTracer>)tracer AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
 @end
@@ -59,12 +59,41 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
 @property (nonatomic, retain) GRMustacheContext *templateOverrideParent;
 @property (nonatomic, retain) id templateOverride;
 
+// Profiler (not a stack)
+@property (nonatomic, retain) GRMustacheProfiler *profiler;
+
+// Tracer (not a stack)
+@property (nonatomic, retain) id<GRMustacheTracer> tracer;
+
+// Rendering session (not a stack)
+@property (nonatomic, retain) GRMustacheRenderingSession *renderingSession;
+
+// Rendering segment (not a stack)
+@property (nonatomic, retain) GRMustacheRenderingSegment *renderingSegment;
+
+// Loop metadata (not a stack)
+@property (nonatomic) BOOL hasIterationMetadata;
+@property (nonatomic) NSUInteger iterationIndex;
+@property (nonatomic) BOOL iterationIsLast;
+
 + (BOOL)objectIsFoundationCollectionWhoseImplementationOfValueForKeyReturnsAnotherCollection:(id)object;
 + (void)setupPreventionOfNSUndefinedKeyException;
 + (void)beginPreventionOfNSUndefinedKeyExceptionFromObject:(id)object;
 + (void)endPreventionOfNSUndefinedKeyExceptionFromObject:(id)object;
 + (NSMutableSet *)preventionOfNSUndefinedKeyExceptionObjects;
 
+/**
+ * Returns the value of a loop metadata key (`@index`, `@first`, `@last`,
+ * `@odd` or `@even`), or nil if _key_ is not a loop metadata key.
+ *
+ * @param key  The searched key.
+ *
+ * @return An NSNumber, or nil.
+ *
+ * @see contextByAddingObject:iterationIndex:last:
+ */
+- (id)iterationMetadataValueForKey:(NSString *)key;
+
 /**
  * Sends the `valueForKey:` message to super_data->receiver with the provided
  * key, using the implementation of super_data->super_class, and returns the
@@ -100,6 +129,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
 @synthesize tagDelegate=_tagDelegate;
 @synthesize templateOverrideParent=_templateOverrideParent;
 @synthesize templateOverride=_templateOverride;
+@synthesize profiler=_profiler;
+@synthesize renderingSession=_renderingSession;
+@synthesize tracer=_tracer;
+@synthesize renderingSegment=_renderingSegment;
+@synthesize hasIterationMetadata=_hasIterationMetadata;
+@synthesize iterationIndex=_iterationIndex;
+@synthesize iterationIsLast=_iterationIsLast;
 
 - (void)dealloc
 {
@@ -113,6 +149,10 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     [_tagDelegate release];
     [_templateOverrideParent release];
     [_templateOverride release];
+    [_profiler release];
+    [_renderingSession release];
+    [_tracer release];
+    [_renderingSegment release];
     [super dealloc];
 }
 
@@ -178,6 +218,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     context.hiddenContextObject = _hiddenContextObject;
     context.templateOverrideParent = _templateOverrideParent;
     context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
     
     // update tag delegate stack
     if (_tagDelegate) { context.tagDelegateParent = self; }
@@ -201,6 +248,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     context.hiddenContextObject = _hiddenContextObject;
     context.templateOverrideParent = _templateOverrideParent;
     context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
     
     // update context stack
     if (_contextObject) { context.contextParent = self; }
@@ -218,6 +272,21 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     return context;
 }
 
+- (GRMustacheContext *)contextByAddingObject:(id)object iterationIndex:(NSUInteger)iterationIndex last:(BOOL)last
+{
+    // Fast enumeration does not provide nil items: context is a new context
+    // that we can update.
+    GRMustacheContext *context = [self contextByAddingObject:object];
+    NSAssert(context != self, @"Invalid object:nil");
+    
+    // replace loop metadata
+    context.hasIterationMetadata = YES;
+    context.iterationIndex = iterationIndex;
+    context.iterationIsLast = last;
+    
+    return context;
+}
+
 - (GRMustacheContext *)contextByAddingProtectedObject:(id)object
 {
     if (object == nil) {
@@ -235,6 +304,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     context.tagDelegate = _tagDelegate;
     context.templateOverrideParent = _templateOverrideParent;
     context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
     
     // update protected context stack
     if (_protectedContextObject) { context.protectedContextParent = self; }
@@ -260,6 +336,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     context.tagDelegate = _tagDelegate;
     context.templateOverrideParent = _templateOverrideParent;
     context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
     
     // update hidden context stack
     if (_hiddenContextObject) { context.hiddenContextParent = self; }
@@ -285,6 +368,13 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     context.hiddenContextObject = _hiddenContextObject;
     context.tagDelegateParent = _tagDelegateParent;
     context.tagDelegate = _tagDelegate;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
     
     // update template override stack
     if (_templateOverride) { context.templateOverrideParent = self; }
@@ -293,6 +383,134 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     return context;
 }
 
+- (GRMustacheContext *)contextByAddingProfiler:(GRMustacheProfiler *)profiler
+{
+    if (profiler == _profiler) {
+        return self;
+    }
+    
+    GRMustacheContext *context = [[[GRMustacheContext alloc] init] autorelease];
+    
+    // copy all stacks
+    context.contextParent = _contextParent;
+    context.contextObject = _contextObject;
+    context.protectedContextParent = _protectedContextParent;
+    context.protectedContextObject = _protectedContextObject;
+    context.hiddenContextParent = _hiddenContextParent;
+    context.hiddenContextObject = _hiddenContextObject;
+    context.tagDelegateParent = _tagDelegateParent;
+    context.tagDelegate = _tagDelegate;
+    context.templateOverrideParent = _templateOverrideParent;
+    context.templateOverride = _templateOverride;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
+    
+    // replace profiler
+    context.profiler = profiler;
+    
+    return context;
+}
+
+- (GRMustacheContext *)contextByAddingRenderingSession:(GRMustacheRenderingSession *)renderingSession
+{
+    if (renderingSession == _renderingSession) {
+        return self;
+    }
+    
+    GRMustacheContext *context = [[[GRMustacheContext alloc] init] autorelease];
+    
+    // copy all stacks
+    context.contextParent = _contextParent;
+    context.contextObject = _contextObject;
+    context.protectedContextParent = _protectedContextParent;
+    context.protectedContextObject = _protectedContextObject;
+    context.hiddenContextParent = _hiddenContextParent;
+    context.hiddenContextObject = _hiddenContextObject;
+    context.tagDelegateParent = _tagDelegateParent;
+    context.tagDelegate = _tagDelegate;
+    context.templateOverrideParent = _templateOverrideParent;
+    context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.tracer = _tracer;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
+    
+    // replace rendering session
+    context.renderingSession = renderingSession;
+    
+    return context;
+}
+
+- (GRMustacheContext *)contextByAddingTracer:(id<GRMustacheTracer>)tracer
+{
+    if (tracer == _tracer) {
+        return self;
+    }
+    
+    GRMustacheContext *context = [[[GRMustacheContext alloc] init] autorelease];
+    
+    // copy all stacks
+    context.contextParent = _contextParent;
+    context.contextObject = _contextObject;
+    context.protectedContextParent = _protectedContextParent;
+    context.protectedContextObject = _protectedContextObject;
+    context.hiddenContextParent = _hiddenContextParent;
+    context.hiddenContextObject = _hiddenContextObject;
+    context.tagDelegateParent = _tagDelegateParent;
+    context.tagDelegate = _tagDelegate;
+    context.templateOverrideParent = _templateOverrideParent;
+    context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.renderingSegment = _renderingSegment;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
+    
+    // replace tracer
+    context.tracer = tracer;
+    
+    return context;
+}
+
+- (GRMustacheContext *)contextByAddingRenderingSegment:(GRMustacheRenderingSegment *)renderingSegment
+{
+    if (renderingSegment == _renderingSegment) {
+        return self;
+    }
+    
+    GRMustacheContext *context = [[[GRMustacheContext alloc] init] autorelease];
+    
+    // copy all stacks
+    context.contextParent = _contextParent;
+    context.contextObject = _contextObject;
+    context.protectedContextParent = _protectedContextParent;
+    context.protectedContextObject = _protectedContextObject;
+    context.hiddenContextParent = _hiddenContextParent;
+    context.hiddenContextObject = _hiddenContextObject;
+    context.tagDelegateParent = _tagDelegateParent;
+    context.tagDelegate = _tagDelegate;
+    context.templateOverrideParent = _templateOverrideParent;
+    context.templateOverride = _templateOverride;
+    context.profiler = _profiler;
+    context.renderingSession = _renderingSession;
+    context.tracer = _tracer;
+    context.hasIterationMetadata = _hasIterationMetadata;
+    context.iterationIndex = _iterationIndex;
+    context.iterationIsLast = _iterationIsLast;
+    
+    // replace rendering segment
+    context.renderingSegment = renderingSegment;
+    
+    return context;
+}
+
 - (void)enumerateTagDelegatesUsingBlock:(void(^)(id<GRMustacheTagDelegate> tagDelegate))block
 {
     if (_tagDelegate) {
@@ -310,6 +528,18 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
 
 - (id)contextValueForKey:(NSString *)key protected:(BOOL *)protected
 {
+    // Loop metadata keys all start with `@`. Contexts outside of loops only
+    // pay for the first test.
+    if (_hasIterationMetadata && key.length > 0 && [key characterAtIndex:0] == '@') {
+        id value = [self iterationMetadataValueForKey:key];
+        if (value != nil) {
+            if (protected != NULL) {
+                *protected = NO;
+            }
+            return value;
+        }
+    }
+    
     if (_protectedContextObject) {
         for (GRMustacheContext *context = self; context; context = context.protectedContextParent) {
             id value = [GRMustacheContext valueForKey:key inObject:context.protectedContextObject];
@@ -348,6 +578,22 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     return nil;
 }
 
+- (id)iterationMetadataValueForKey:(NSString *)key
+{
+    if ([key isEqualToString:@"@index"]) {
+        return [NSNumber numberWithUnsignedInteger:_iterationIndex];
+    } else if ([key isEqualToString:@"@first"]) {
+        return [NSNumber numberWithBool:(_iterationIndex == 0)];
+    } else if ([key isEqualToString:@"@last"]) {
+        return [NSNumber numberWithBool:_iterationIsLast];
+    } else if ([key isEqualToString:@"@odd"]) {
+        return [NSNumber numberWithBool:(_iterationIndex % 2 == 1)];
+    } else if ([key isEqualToString:@"@even"]) {
+        return [NSNumber numberWithBool:(_iterationIndex % 2 == 0)];
+    }
+    return nil;
+}
+
 - (id<GRMustacheTemplateComponent>)resolveTemplateComponent:(id<GRMustacheTemplateComponent>)component
 {
     if (_templateOverride) {
@@ -358,6 +604,11 @@ static BOOL shouldPreventNSUndefinedKeyException = NO;
     return component;
 }
 
+- (BOOL)hasTemplateOverride
+{
+    return (_templateOverride != nil);
+}
+
 
 #pragma mark - Private
 
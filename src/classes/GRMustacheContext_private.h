@@ -24,10 +24,14 @@
 #import <Foundation/Foundation.h>
 #import "GRMustacheAvailabilityMacros_private.h"
 #import "GRMustacheTagDelegate.h"
+#import "GRMustacheTracer.h"
 
 @protocol GRMustacheTagDelegate;
 @protocol GRMustacheTemplateComponent;
 @class GRMustacheTemplateOverride;
+@class GRMustacheProfiler;
+@class GRMustacheRenderingSession;
+@class GRMustacheRenderingSegment;
 
 #if !defined(NS_BLOCK_ASSERTIONS)
 /**
@@ -59,6 +63,10 @@ extern BOOL GRMustacheContextDidCatchNSUndefinedKeyException;
  * - Let tag delegates interpret rendered values.
  *
  * - Let partial templates override template components.
+ *
+ * Besides those stacks, a context may hold a profiler, a tracer, a rendering
+ * session, a rendering segment, and the loop metadata of the innermost
+ * enumerated section.
  */
 @interface GRMustacheContext : NSObject {
 @private
@@ -72,6 +80,13 @@ extern BOOL GRMustacheContextDidCatchNSUndefinedKeyException;
     id<GRMustacheTagDelegate> _tagDelegate;
     GRMustacheContext *_templateOverrideParent;
     GRMustacheTemplateOverride *_templateOverride;
+    GRMustacheProfiler *_profiler;
+    GRMustacheRenderingSession *_renderingSession;
+    id<GRMustacheTracer> _tracer;
+    GRMustacheRenderingSegment *_renderingSegment;
+    BOOL _hasIterationMetadata;
+    NSUInteger _iterationIndex;
+    BOOL _iterationIsLast;
 }
 
 /**
@@ -123,6 +138,100 @@ extern BOOL GRMustacheContextDidCatchNSUndefinedKeyException;
 // Documented in GRMustacheContext.h
 - (GRMustacheContext *)contextByAddingTagDelegate:(id<GRMustacheTagDelegate>)tagDelegate GRMUSTACHE_API_PUBLIC;
 
+// Documented in GRMustacheContext.h
+- (GRMustacheContext *)contextByAddingProfiler:(GRMustacheProfiler *)profiler GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheContext.h
+- (GRMustacheContext *)contextByAddingTracer:(id<GRMustacheTracer>)tracer GRMUSTACHE_API_PUBLIC;
+
+/**
+ * The profiler attached to the receiver, or nil.
+ *
+ * Rendering code checks this property before calling the profiler, so that
+ * contexts without any profiler pay a single nil test.
+ *
+ * @see [GRMustacheTag renderContentType:inBuffer:withContext:error:]
+ * @see [GRMustacheTemplate renderContentType:inBuffer:withContext:error:]
+ */
+@property (nonatomic, retain, readonly) GRMustacheProfiler *profiler GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The tracer attached to the receiver, or nil.
+ *
+ * Rendering code checks this property before calling the tracer, so that
+ * contexts without any tracer pay a single nil test.
+ *
+ * @see [GRMustacheTemplate renderContentType:inBuffer:withContext:error:]
+ */
+@property (nonatomic, retain, readonly) id<GRMustacheTracer> tracer GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The rendering session attached to the receiver, or nil.
+ *
+ * Rendering code checks this property before calling the session, so that
+ * renderings without any limit pay a single nil test.
+ *
+ * @see GRMustacheRenderingSession
+ */
+@property (nonatomic, retain, readonly) GRMustacheRenderingSession *renderingSession GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns a GRMustacheContext object identical to the receiver, but for the
+ * attached rendering session, which is replaced by _renderingSession_.
+ *
+ * @param renderingSession  A rendering session, or nil.
+ *
+ * @return A GRMustacheContext object.
+ *
+ * @see [GRMustacheTemplate renderObject:error:]
+ */
+- (GRMustacheContext *)contextByAddingRenderingSession:(GRMustacheRenderingSession *)renderingSession GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The segment of an incremental rendering that is being rendered, or nil.
+ *
+ * Rendering code checks this property before recording key paths and inner
+ * segments, so that renderings that are not incremental pay a single nil
+ * test.
+ *
+ * @see GRMustacheIncrementalRendering
+ */
+@property (nonatomic, retain, readonly) GRMustacheRenderingSegment *renderingSegment GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns a GRMustacheContext object identical to the receiver, but for the
+ * rendering segment, which is replaced by _renderingSegment_.
+ *
+ * @param renderingSegment  A rendering segment, or nil.
+ *
+ * @return A GRMustacheContext object.
+ *
+ * @see GRMustacheIncrementalRendering
+ */
+- (GRMustacheContext *)contextByAddingRenderingSegment:(GRMustacheRenderingSegment *)renderingSegment GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns a GRMustacheContext object identical to the receiver, but for the
+ * context stack that is extended with _object_, and for the loop metadata,
+ * which is replaced by _iterationIndex_ and _last_.
+ *
+ * Loop metadata is made of scalar values, stored in the context that is
+ * created anyway for each item of an enumerated section: it costs no extra
+ * object. The metadata keys `@index`, `@first`, `@last`, `@odd` and `@even`
+ * are answered by contextValueForKey:protected: until another item of another
+ * enumerated section enters the context stack.
+ *
+ * @param object          An object, not nil.
+ * @param iterationIndex  The zero-based index of _object_ in its collection.
+ * @param last            YES if _object_ is known to be the last item of its
+ *                        collection.
+ *
+ * @return A GRMustacheContext object.
+ *
+ * @see [GRMustacheTag usesLastIterationMetadata]
+ */
+- (GRMustacheContext *)contextByAddingObject:(id)object iterationIndex:(NSUInteger)iterationIndex last:(BOOL)last GRMUSTACHE_API_INTERNAL;
+
 /**
  * Returns a GRMustacheContext object identical to the receiver, but for the
  * hidden object stack that is extended with _object_.
@@ -190,6 +299,14 @@ extern BOOL GRMustacheContextDidCatchNSUndefinedKeyException;
  */
 - (id<GRMustacheTemplateComponent>)resolveTemplateComponent:(id<GRMustacheTemplateComponent>)component GRMUSTACHE_API_INTERNAL;
 
+/**
+ * Returns YES if the template override stack is not empty, that is to say if
+ * the receiver is used to render an overridable partial.
+ *
+ * @see -[GRMustacheFragmentCacheSection renderForMustacheTag:context:HTMLSafe:error:]
+ */
+- (BOOL)hasTemplateOverride GRMUSTACHE_API_INTERNAL;
+
 /**
  * Executes a given block using each tag delegate in the tag delegate stack.
  *
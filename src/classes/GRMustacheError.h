@@ -50,6 +50,16 @@ typedef NS_ENUM(NSInteger, GRMustacheErrorCode) {
      * @since v6.3
      */
     GRMustacheErrorCodeRenderingError AVAILABLE_GRMUSTACHE_VERSION_6_3_AND_LATER,
+    
+    /**
+     * The error code for renderings that exceed the limits of their
+     * configuration.
+     *
+     * @see GRMustacheConfiguration
+     *
+     * @since v6.5
+     */
+    GRMustacheErrorCodeRenderingLimitExceeded AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
 
 } AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER;
 
@@ -46,4 +46,9 @@
     return [super isEqual:anObject];
 }
 
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor
+{
+    NSAssert(NO, @"Subclasses must override");
+}
+
 @end
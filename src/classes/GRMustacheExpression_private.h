@@ -25,6 +25,26 @@
 
 @class GRMustacheContext;
 @class GRMustacheToken;
+@class GRMustacheFilteredExpression;
+@class GRMustacheIdentifierExpression;
+@class GRMustacheImplicitIteratorExpression;
+@class GRMustacheScopedExpression;
+
+/**
+ * The protocol for objects that walk expression trees, without knowing the
+ * concrete classes of the expressions they visit.
+ *
+ * Visitors are responsible for visiting inner expressions, if they need to.
+ *
+ * @see [GRMustacheExpression acceptExpressionVisitor:]
+ */
+@protocol GRMustacheExpressionVisitor<NSObject>
+@required
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression GRMUSTACHE_API_INTERNAL;
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression GRMUSTACHE_API_INTERNAL;
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression GRMUSTACHE_API_INTERNAL;
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression GRMUSTACHE_API_INTERNAL;
+@end
 
 /**
  * The GRMustacheExpression is the base class for objects that can provide
@@ -81,4 +101,14 @@
  * @return YES if the receiver and anObject are equal, otherwise NO.
  */
 - (BOOL)isEqual:(id)anObject; // no availability macro for Foundation method declaration
+
+/**
+ * Sends to the visitor the visit message that matches the class of the
+ * receiver.
+ *
+ * Default implementation raises an exception: subclasses must override.
+ *
+ * @param visitor  An expression visitor.
+ */
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor GRMUSTACHE_API_INTERNAL;
 @end
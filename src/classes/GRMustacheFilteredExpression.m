@@ -36,6 +36,7 @@
 @implementation GRMustacheFilteredExpression
 @synthesize filterExpression=_filterExpression;
 @synthesize argumentExpression=_argumentExpression;
+@synthesize curry=_curry;
 
 + (instancetype)expressionWithFilterExpression:(GRMustacheExpression *)filterExpression argumentExpression:(GRMustacheExpression *)argumentExpression
 {
@@ -83,6 +84,11 @@
     return [_argumentExpression isEqual:((GRMustacheFilteredExpression *)expression).argumentExpression];
 }
 
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor
+{
+    [visitor visitFilteredExpression:self];
+}
+
 
 #pragma mark GRMustacheExpression
 
@@ -36,6 +36,22 @@
     BOOL _curry;
 }
 
+/**
+ * The expression that evaluates to the filter.
+ */
+@property (nonatomic, retain, readonly) GRMustacheExpression *filterExpression GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The expression that evaluates to the filter argument.
+ */
+@property (nonatomic, retain, readonly) GRMustacheExpression *argumentExpression GRMUSTACHE_API_INTERNAL;
+
+/**
+ * If YES, the expression evaluates to a filter: this is the case for all but
+ * the last arguments of multi-arguments filters such as `{{ f(x,y) }}`.
+ */
+@property (nonatomic, readonly) BOOL curry GRMUSTACHE_API_INTERNAL;
+
 /**
  * Returns a filtered expression, given an expression that returns a filter, and
  * an expression that return the filter argument.
@@ -0,0 +1,115 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+#import "GRMustacheFilter.h"
+
+/**
+ * A GRMustacheFragmentCache caches the rendering of Mustache sections.
+ *
+ * Insert a fragment cache in the context stack, and wrap the sections that
+ * render identical output for identical inputs in `{{#cache(key)}}...{{/}}`,
+ * assuming the cache is available for the `cache` key:
+ *
+ *     GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+ *     GRMustacheContext *baseContext = repository.configuration.baseContext;
+ *     repository.configuration.baseContext = [baseContext contextByAddingObject:@{ @"cache": cache }];
+ *
+ *     {{#cache(product.id)}}
+ *       <div class="product">{{product.name}}...</div>
+ *     {{/}}
+ *
+ * The first rendering of the section stores its output. Later renderings of
+ * the section, with an equal key, return the stored output without rendering
+ * the section content: tag delegates and rendering objects inside the section
+ * are not invoked.
+ *
+ * Renderings are stored for the value of the key expression, the template ID
+ * of the template that contains the section (see GRMustacheTemplateRepository),
+ * the location of the section in its template, and the content type of the
+ * section, so that HTML and text renderings are never mixed. Sections of
+ * templates that have no template ID, such as templates built from strings,
+ * are identified by their content instead of their template ID. Distinct
+ * sections of a single template can thus use the same key.
+ *
+ * Keys must implement `isEqual:` and `hash`, and should not change once they
+ * have been used. Sections whose key is nil are rendered, but not stored.
+ * Sections rendered inside an overridable partial (`{{<layout}}...{{/layout}}`)
+ * are rendered, but not stored either, since each template that embeds the
+ * partial may override their content differently.
+ *
+ * The renderings are stored in a NSCache, which evicts them when it exceeds
+ * its limits. The cost of a rendering is its length. A fragment cache is
+ * thread-safe.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/standard_library.md#fragment-cache
+ *
+ * @since v6.5
+ */
+@interface GRMustacheFragmentCache : NSObject<GRMustacheFilter> {
+@private
+    NSCache *_cache;
+}
+
+/**
+ * Returns a new fragment cache that holds at most 1000 renderings.
+ *
+ * @return A new fragment cache.
+ *
+ * @see fragmentCacheWithCache:
+ *
+ * @since v6.5
+ */
++ (instancetype)fragmentCache AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns a new fragment cache that stores renderings in _cache_.
+ *
+ * Configure the `countLimit` and `totalCostLimit` properties of the cache in
+ * order to bound its size. The cost of each rendering is its length.
+ *
+ * @param cache  A cache.
+ *
+ * @return A new fragment cache.
+ *
+ * @since v6.5
+ */
++ (instancetype)fragmentCacheWithCache:(NSCache *)cache AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The cache that stores renderings.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain, readonly) NSCache *cache AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Empties the receiver.
+ *
+ * Call this method when the data rendered by cached sections changes.
+ *
+ * @since v6.5
+ */
+- (void)removeAllFragments AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
@@ -0,0 +1,239 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheFragmentCache.h"
+#import "GRMustacheRendering.h"
+#import "GRMustacheTag_private.h"
+#import "GRMustacheExpression_private.h"
+#import "GRMustacheToken_private.h"
+#import "GRMustacheContext_private.h"
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheFragmentCacheKey
+
+/**
+ * The key of a rendering in a fragment cache.
+ */
+@interface GRMustacheFragmentCacheKey : NSObject<NSCopying> {
+@private
+    id _key;
+    id _templateID;
+    NSRange _range;
+    GRMustacheContentType _contentType;
+}
++ (instancetype)fragmentCacheKeyWithKey:(id)key templateID:(id)templateID range:(NSRange)range contentType:(GRMustacheContentType)contentType;
+@end
+
+@implementation GRMustacheFragmentCacheKey
+
++ (instancetype)fragmentCacheKeyWithKey:(id)key templateID:(id)templateID range:(NSRange)range contentType:(GRMustacheContentType)contentType
+{
+    GRMustacheFragmentCacheKey *fragmentCacheKey = [[[self alloc] init] autorelease];
+    fragmentCacheKey->_key = [key retain];
+    fragmentCacheKey->_templateID = [templateID retain];
+    fragmentCacheKey->_range = range;
+    fragmentCacheKey->_contentType = contentType;
+    return fragmentCacheKey;
+}
+
+- (void)dealloc
+{
+    [_key release];
+    [_templateID release];
+    [super dealloc];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return [self retain];
+}
+
+- (NSUInteger)hash
+{
+    return [_key hash] ^ [_templateID hash] ^ _range.location ^ _contentType;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (object == self) {
+        return YES;
+    }
+    if (![object isKindOfClass:[GRMustacheFragmentCacheKey class]]) {
+        return NO;
+    }
+    GRMustacheFragmentCacheKey *other = object;
+    return (_contentType == other->_contentType &&
+            NSEqualRanges(_range, other->_range) &&
+            [_key isEqual:other->_key] &&
+            (_templateID == other->_templateID || [_templateID isEqual:other->_templateID]));
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheFragmentCacheSection
+
+/**
+ * The rendering object returned by the `cache` filter: it renders a section
+ * from a fragment cache.
+ */
+@interface GRMustacheFragmentCacheSection : NSObject<GRMustacheRendering> {
+@private
+    NSCache *_cache;
+    id _key;
+}
++ (instancetype)fragmentCacheSectionWithCache:(NSCache *)cache key:(id)key;
+@end
+
+@implementation GRMustacheFragmentCacheSection
+
++ (instancetype)fragmentCacheSectionWithCache:(NSCache *)cache key:(id)key
+{
+    GRMustacheFragmentCacheSection *section = [[[self alloc] init] autorelease];
+    section->_cache = [cache retain];
+    section->_key = [key retain];
+    return section;
+}
+
+- (void)dealloc
+{
+    [_cache release];
+    [_key release];
+    [super dealloc];
+}
+
+- (NSString *)renderForMustacheTag:(GRMustacheTag *)tag context:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error
+{
+    switch (tag.type) {
+        case GRMustacheTagTypeVariable:
+            // {{ cache(key) }}: there is no section to cache
+            return @"";
+            
+        case GRMustacheTagTypeInvertedSection:
+            // {{^ cache(key) }}...{{/}}: we are not a false value
+            return @"";
+            
+        case GRMustacheTagTypeSection:
+        case GRMustacheTagTypeOverridableSection:
+            break;
+    }
+    
+    if (_key == nil) {
+        // {{# cache(missing) }}...{{/}}: render, but do not store
+        return [tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }
+    
+    if ([context hasTemplateOverride]) {
+        // {{<layout}}...{{/layout}}: the section content may be overridden
+        // differently by each template that embeds the layout. Render, but do
+        // not store.
+        return [tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }
+    
+    // Sections are identified by their template, and their location in the
+    // template string. Templates without template ID (such as templates
+    // built from strings) are identified by the content of the section.
+    GRMustacheToken *token = tag.expression.token;
+    id templateID = token.templateID ?: tag.innerTemplateString;
+    GRMustacheFragmentCacheKey *cacheKey = [GRMustacheFragmentCacheKey fragmentCacheKeyWithKey:_key templateID:templateID range:token.range contentType:tag.contentType];
+    
+    NSString *rendering = [_cache objectForKey:cacheKey];
+    if (rendering) {
+        // Sections render HTML-safe strings when their content type is HTML:
+        // see [GRMustacheSectionTag renderContentWithContext:HTMLSafe:error:]
+        if (HTMLSafe) {
+            *HTMLSafe = (tag.contentType == GRMustacheContentTypeHTML);
+        }
+        return rendering;
+    }
+    
+    rendering = [[[tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error] copy] autorelease];
+    if (rendering) {
+        [_cache setObject:rendering forKey:cacheKey cost:rendering.length];
+    }
+    return rendering;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheFragmentCache
+
+@interface GRMustacheFragmentCache()
+- (id)initWithCache:(NSCache *)cache;
+@end
+
+@implementation GRMustacheFragmentCache
+@synthesize cache=_cache;
+
++ (instancetype)fragmentCache
+{
+    NSCache *cache = [[[NSCache alloc] init] autorelease];
+    cache.countLimit = 1000;
+    return [[[self alloc] initWithCache:cache] autorelease];
+}
+
++ (instancetype)fragmentCacheWithCache:(NSCache *)cache
+{
+    return [[[self alloc] initWithCache:cache] autorelease];
+}
+
+- (void)dealloc
+{
+    [_cache release];
+    [super dealloc];
+}
+
+- (id)initWithCache:(NSCache *)cache
+{
+    if (cache == nil) {
+        [NSException raise:NSInvalidArgumentException format:@"Invalid cache:nil"];
+    }
+    
+    self = [super init];
+    if (self) {
+        _cache = [cache retain];
+    }
+    return self;
+}
+
+- (void)removeAllFragments
+{
+    [_cache removeAllObjects];
+}
+
+
+#pragma mark - GRMustacheFilter
+
+/**
+ * Support for {{# cache(key) }}...{{/}}
+ */
+- (id)transformedValue:(id)object
+{
+    return [GRMustacheFragmentCacheSection fragmentCacheSectionWithCache:_cache key:object];
+}
+
+@end
@@ -60,6 +60,11 @@
     return [_identifier isEqual:((GRMustacheIdentifierExpression *)expression).identifier];
 }
 
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor
+{
+    [visitor visitIdentifierExpression:self];
+}
+
 
 #pragma mark - GRMustacheExpression
 
@@ -33,6 +33,11 @@
     NSString *_identifier;
 }
 
+/**
+ * The looked up key: the `a` in `{{ a }}`.
+ */
+@property (nonatomic, copy, readonly) NSString *identifier GRMUSTACHE_API_INTERNAL;
+
 /**
  * Returns an identifier expression, given an identifier.
  *
@@ -35,6 +35,11 @@
     return [expression isKindOfClass:[GRMustacheImplicitIteratorExpression class]];
 }
 
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor
+{
+    [visitor visitImplicitIteratorExpression:self];
+}
+
 
 #pragma mark - GRMustacheExpression
 
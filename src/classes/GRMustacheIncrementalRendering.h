@@ -0,0 +1,117 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+@class GRMustacheTemplate;
+
+/**
+ * A GRMustacheIncrementalRendering keeps the rendering of a template up to
+ * date with its data, without rendering the whole template again each time
+ * the data changes.
+ *
+ * The rendering is made of segments: one for each text, tag, and partial of
+ * the template, and of the sections, partials, and overridden partials that it
+ * renders (each item of a section gets its own segments). Each segment
+ * remembers the context it was rendered in, and the key paths that its tag
+ * has read. When you tell an incremental rendering which key paths have
+ * changed, only the segments that have read those key paths, their parents
+ * (`user` for `user.name`), or their children (`user.name` for `user`) are
+ * rendered again, and their output is spliced into the rendering. The cost of
+ * an update depends on the segments that are rendered again, not on the size
+ * of the template.
+ *
+ *     NSMutableDictionary *data = ...;
+ *     GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+ *     NSLog(@"%@", rendering.string);
+ *
+ *     [data setValue:@"Arthur" forKeyPath:@"user.name"];
+ *     [rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"user.name"] error:NULL];
+ *     NSLog(@"%@", rendering.string);
+ *
+ * Key paths are recorded as they are written in tags, whatever the section
+ * they are nested in: `{{#user}}{{name}}{{/user}}` reads `user` and `name`.
+ * Changing `user.name` renders the whole section again, and changing `name`
+ * only renders `{{name}}` again, in the context of the user it was first
+ * rendered with.
+ *
+ * Sections rendered by rendering objects and filters, and text partials
+ * embedded in HTML templates, may process the rendering of their content:
+ * they are rendered again as a whole when one of the key paths of their
+ * content changes. Values that are not read through Mustache tags, such as
+ * values read by rendering objects and filters from their own objects, are
+ * not tracked.
+ *
+ * An incremental rendering is not thread-safe.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/runtime.md#incremental-rendering
+ *
+ * @since v6.5
+ */
+@interface GRMustacheIncrementalRendering : NSObject {
+@private
+    GRMustacheTemplate *_template;
+    id _context;
+    id _rootSegment;
+    NSMutableString *_string;
+}
+
+/**
+ * Renders a template, and returns an incremental rendering that can be
+ * updated later.
+ *
+ * @param template  A template.
+ * @param object    An object used for interpreting Mustache tags.
+ * @param error     If there is an error rendering the template, upon return
+ *                  contains an NSError object that describes the problem.
+ *
+ * @return An incremental rendering, or nil if the template could not be
+ *         rendered.
+ *
+ * @since v6.5
+ */
++ (instancetype)incrementalRenderingWithTemplate:(GRMustacheTemplate *)template object:(id)object error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The current rendering.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSString *string AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Renders again the segments that depend on the changed key paths, and
+ * updates the string property.
+ *
+ * @param keyPaths  A set of key paths such as `user.name`.
+ * @param error     If there is an error rendering the template, upon return
+ *                  contains an NSError object that describes the problem.
+ *
+ * @return YES if the rendering has been updated. Upon failure, the rendering
+ *         is left unchanged.
+ *
+ * @since v6.5
+ */
+- (BOOL)updateWithChangedKeyPaths:(NSSet *)keyPaths error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
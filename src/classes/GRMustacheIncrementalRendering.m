@@ -0,0 +1,359 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheIncrementalRendering_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateComponent_private.h"
+#import "GRMustacheContext_private.h"
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheMetrics_private.h"
+#import "GRMustacheInstrumentation_private.h"
+
+/**
+ * Returns YES if a change of one key path may change the value of the other:
+ * the key paths are equal, or one is a prefix of the other (`user` and
+ * `user.name`).
+ */
+static BOOL GRMustacheKeyPathsOverlap(NSString *keyPath1, NSString *keyPath2)
+{
+    NSUInteger length1 = keyPath1.length;
+    NSUInteger length2 = keyPath2.length;
+    if (length1 == length2) {
+        return [keyPath1 isEqualToString:keyPath2];
+    }
+    if (length1 > length2) {
+        return [keyPath1 hasPrefix:keyPath2] && [keyPath1 characterAtIndex:length2] == '.';
+    }
+    return [keyPath2 hasPrefix:keyPath1] && [keyPath2 characterAtIndex:length1] == '.';
+}
+
+
+// =============================================================================
+#pragma mark - GRMustacheRenderingSegment
+
+@interface GRMustacheRenderingSegment()
+@property (nonatomic) NSUInteger length;
++ (instancetype)renderingSegmentWithComponent:(id<GRMustacheTemplateComponent>)component context:(GRMustacheContext *)context contentType:(GRMustacheContentType)contentType;
+
+/**
+ * Renders the component of the receiver in its context, and records the key
+ * paths and the inner segments of the rendering.
+ */
+- (BOOL)renderInBuffer:(NSMutableString *)buffer renderingSession:(GRMustacheRenderingSession *)renderingSession error:(NSError **)error;
+
+/**
+ * Returns a new segment for the component and the context of the receiver,
+ * rendered in _buffer_, or nil if there is an error.
+ */
+- (GRMustacheRenderingSegment *)renderingSegmentByRenderingInBuffer:(NSMutableString *)buffer renderingSession:(GRMustacheRenderingSession *)renderingSession error:(NSError **)error;
+
+/**
+ * Replaces the key paths, inner segments and length of the receiver with
+ * those of _segment_, and updates the length of the enclosing segments.
+ */
+- (void)takeRenderingOfSegment:(GRMustacheRenderingSegment *)segment;
+
+/**
+ * Appends to _segments_ the outermost segments that depend on _keyPaths_,
+ * and to _locations_ their location in the rendering, given the location of
+ * the receiver.
+ */
+- (void)collectSegmentsDependingOnKeyPaths:(NSSet *)keyPaths location:(NSUInteger)location segments:(NSMutableArray *)segments locations:(NSMutableArray *)locations;
+
+- (BOOL)dependsOnKeyPaths:(NSSet *)keyPaths;
+- (void)forgetInnerSegments;
+@end
+
+@implementation GRMustacheRenderingSegment
+@synthesize keyPaths=_keyPaths;
+@synthesize length=_length;
+
++ (instancetype)renderingSegmentWithComponent:(id<GRMustacheTemplateComponent>)component context:(GRMustacheContext *)context contentType:(GRMustacheContentType)contentType
+{
+    GRMustacheRenderingSegment *segment = [[[self alloc] init] autorelease];
+    segment->_component = [component retain];
+    segment->_context = [context retain];
+    segment->_contentType = contentType;
+    segment->_keyPaths = [[NSMutableSet alloc] init];
+    return segment;
+}
+
+- (void)dealloc
+{
+    [_component release];
+    [_context release];
+    [_keyPaths release];
+    [_segments release];
+    [super dealloc];
+}
+
+- (BOOL)renderComponents:(NSArray *)components contentType:(GRMustacheContentType)contentType inBuffer:(NSMutableString *)buffer withContext:(GRMustacheContext *)context error:(NSError **)error
+{
+    if (!_recordsInnerSegments) {
+        // The receiver is not being rendered: the context has been kept by
+        // a rendering object for later use. Render, but do not record.
+        context = [context contextByAddingRenderingSegment:nil];
+        for (id<GRMustacheTemplateComponent> component in components) {
+            component = [context resolveTemplateComponent:component];
+            if (![component renderContentType:contentType inBuffer:buffer withContext:context error:error]) {
+                return NO;
+            }
+        }
+        return YES;
+    }
+    
+    // Templates embedded in templates of another content type escape the
+    // rendering of their components.
+    if (contentType != _contentType) {
+        _processesRenderingOfInnerSegments = YES;
+    }
+    
+    // Inner segments keep their context, without the current rendering
+    // segment and rendering session, so that they can be rendered again.
+    GRMustacheRenderingSession *renderingSession = context.renderingSession;
+    GRMustacheContext *segmentContext = [[context contextByAddingRenderingSession:nil] contextByAddingRenderingSegment:nil];
+    
+    for (id<GRMustacheTemplateComponent> component in components) {
+        GRMustacheRenderingSegment *segment = [GRMustacheRenderingSegment renderingSegmentWithComponent:component context:segmentContext contentType:contentType];
+        segment->_parent = self;    // not retained, since self retains segment
+        
+        if (![segment renderInBuffer:buffer renderingSession:renderingSession error:error]) {
+            return NO;
+        }
+        [_segments addObject:segment];
+    }
+    return YES;
+}
+
+- (void)didProcessRenderingOfInnerSegments
+{
+    _processesRenderingOfInnerSegments = YES;
+}
+
+- (BOOL)renderInBuffer:(NSMutableString *)buffer renderingSession:(GRMustacheRenderingSession *)renderingSession error:(NSError **)error
+{
+    GRMustacheContext *context = [[_context contextByAddingRenderingSession:renderingSession] contextByAddingRenderingSegment:self];
+    
+    // component may be overriden by a GRMustacheTemplateOverride: resolve it.
+    id<GRMustacheTemplateComponent> component = [_context resolveTemplateComponent:_component];
+    
+    [_segments release];
+    _segments = [[NSMutableArray alloc] init];
+    _recordsInnerSegments = YES;
+    _processesRenderingOfInnerSegments = NO;
+    
+    NSUInteger location = buffer.length;
+    BOOL success = [component renderContentType:_contentType inBuffer:buffer withContext:context error:error];
+    _recordsInnerSegments = NO;
+    
+    if (success) {
+        _length = buffer.length - location;
+        
+        // Rendering objects, filters, and text partials embedded in HTML
+        // templates may process the rendering of inner segments: such a
+        // segment must be rendered again as a whole.
+        NSUInteger innerLength = 0;
+        for (GRMustacheRenderingSegment *segment in _segments) {
+            innerLength += segment->_length;
+        }
+        if (_processesRenderingOfInnerSegments || innerLength != _length) {
+            [self forgetInnerSegments];
+        }
+    }
+    return success;
+}
+
+- (GRMustacheRenderingSegment *)renderingSegmentByRenderingInBuffer:(NSMutableString *)buffer renderingSession:(GRMustacheRenderingSession *)renderingSession error:(NSError **)error
+{
+    GRMustacheRenderingSegment *segment = [GRMustacheRenderingSegment renderingSegmentWithComponent:_component context:_context contentType:_contentType];
+    if (![segment renderInBuffer:buffer renderingSession:renderingSession error:error]) {
+        return nil;
+    }
+    return segment;
+}
+
+- (void)takeRenderingOfSegment:(GRMustacheRenderingSegment *)segment
+{
+    [_keyPaths release];
+    _keyPaths = [segment->_keyPaths retain];
+    
+    [_segments release];
+    _segments = [segment->_segments retain];
+    for (GRMustacheRenderingSegment *innerSegment in _segments) {
+        innerSegment->_parent = self;
+    }
+    
+    for (GRMustacheRenderingSegment *ancestor = _parent; ancestor; ancestor = ancestor->_parent) {
+        ancestor->_length = ancestor->_length - _length + segment->_length;
+    }
+    _length = segment->_length;
+}
+
+- (void)collectSegmentsDependingOnKeyPaths:(NSSet *)keyPaths location:(NSUInteger)location segments:(NSMutableArray *)segments locations:(NSMutableArray *)locations
+{
+    if ([self dependsOnKeyPaths:keyPaths]) {
+        [segments addObject:self];
+        [locations addObject:[NSNumber numberWithUnsignedInteger:location]];
+        return;
+    }
+    for (GRMustacheRenderingSegment *segment in _segments) {
+        [segment collectSegmentsDependingOnKeyPaths:keyPaths location:location segments:segments locations:locations];
+        location += segment->_length;
+    }
+}
+
+- (BOOL)dependsOnKeyPaths:(NSSet *)keyPaths
+{
+    for (NSString *keyPath in _keyPaths) {
+        for (NSString *changedKeyPath in keyPaths) {
+            if (GRMustacheKeyPathsOverlap(keyPath, changedKeyPath)) {
+                return YES;
+            }
+        }
+    }
+    return NO;
+}
+
+- (void)forgetInnerSegments
+{
+    for (GRMustacheRenderingSegment *segment in _segments) {
+        [segment forgetInnerSegments];
+        [_keyPaths unionSet:segment->_keyPaths];
+    }
+    [_segments release];
+    _segments = nil;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheIncrementalRendering
+
+@interface GRMustacheIncrementalRendering()
+- (id)initWithTemplate:(GRMustacheTemplate *)template context:(GRMustacheContext *)context;
+@end
+
+@implementation GRMustacheIncrementalRendering
+
++ (instancetype)incrementalRenderingWithTemplate:(GRMustacheTemplate *)template object:(id)object error:(NSError **)error
+{
+    uint64_t start = GRMustacheInstrumentationNanoseconds();
+    GRMustacheContext *context = [template.baseContext contextByAddingObject:object];
+    GRMustacheIncrementalRendering *rendering = [[[self alloc] initWithTemplate:template context:context] autorelease];
+    
+    GRMustacheRenderingSession *renderingSession = nil;
+    if (template.renderingBudget) {
+        renderingSession = [GRMustacheRenderingSession renderingSessionWithBudget:template.renderingBudget];
+    }
+    if (![rendering->_rootSegment renderInBuffer:rendering->_string renderingSession:renderingSession error:error]) {
+        return nil;
+    }
+    
+    [template.metrics didRenderLength:rendering->_string.length withLatency:GRMustacheInstrumentationNanoseconds() - start];
+    return rendering;
+}
+
+- (void)dealloc
+{
+    [_template release];
+    [_context release];
+    [_rootSegment release];
+    [_string release];
+    [super dealloc];
+}
+
+- (NSString *)string
+{
+    return [[_string copy] autorelease];
+}
+
+- (BOOL)updateWithChangedKeyPaths:(NSSet *)keyPaths error:(NSError **)error
+{
+    NSMutableArray *segments = [NSMutableArray array];
+    NSMutableArray *locations = [NSMutableArray array];
+    [_rootSegment collectSegmentsDependingOnKeyPaths:keyPaths location:0 segments:segments locations:locations];
+    if (segments.count == 0) {
+        return YES;
+    }
+    
+    // Each update is a rendering of its own, with its own rendering limits.
+    GRMustacheRenderingSession *renderingSession = nil;
+    if (_template.renderingBudget) {
+        renderingSession = [GRMustacheRenderingSession renderingSessionWithBudget:_template.renderingBudget];
+        if (![renderingSession enterTemplateWithError:error]) {
+            return NO;
+        }
+    }
+    
+    // Render all segments before splicing, so that a failed update leaves the
+    // rendering unchanged.
+    NSMutableArray *renderings = [NSMutableArray arrayWithCapacity:segments.count];
+    NSMutableArray *renderedSegments = [NSMutableArray arrayWithCapacity:segments.count];
+    BOOL success = YES;
+    for (GRMustacheRenderingSegment *segment in segments) {
+        NSMutableString *buffer = [NSMutableString string];
+        GRMustacheRenderingSegment *renderedSegment = [segment renderingSegmentByRenderingInBuffer:buffer renderingSession:renderingSession error:error];
+        if (!renderedSegment) {
+            success = NO;
+            break;
+        }
+        [renderings addObject:buffer];
+        [renderedSegments addObject:renderedSegment];
+    }
+    
+    if (renderingSession) {
+        [renderingSession exitTemplate];
+    }
+    
+    if (!success) {
+        return NO;
+    }
+    
+    // Splice, from the end, so that the locations of the remaining segments
+    // are still valid.
+    for (NSUInteger index = segments.count; index > 0; --index) {
+        GRMustacheRenderingSegment *segment = [segments objectAtIndex:index - 1];
+        NSUInteger location = [[locations objectAtIndex:index - 1] unsignedIntegerValue];
+        [_string replaceCharactersInRange:NSMakeRange(location, segment.length) withString:[renderings objectAtIndex:index - 1]];
+        [segment takeRenderingOfSegment:[renderedSegments objectAtIndex:index - 1]];
+    }
+    
+    return YES;
+}
+
+
+#pragma mark - Private
+
+- (id)initWithTemplate:(GRMustacheTemplate *)template context:(GRMustacheContext *)context
+{
+    self = [super init];
+    if (self) {
+        _template = [template retain];
+        _context = [context retain];
+        _string = [[NSMutableString alloc] init];
+        _rootSegment = [[GRMustacheRenderingSegment renderingSegmentWithComponent:template context:context contentType:template.contentType] retain];
+    }
+    return self;
+}
+
+@end
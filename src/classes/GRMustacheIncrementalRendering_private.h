@@ -0,0 +1,113 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+#import "GRMustacheTemplateComponent_private.h"
+
+@class GRMustacheTemplate;
+@class GRMustacheContext;
+
+/**
+ * A segment of an incremental rendering: the rendering of a template component
+ * in a given context.
+ *
+ * While a segment renders, the components of the sections and templates that
+ * it renders are recorded as inner segments, along with the context they are
+ * rendered in. When the rendering of the segment is the concatenation of the
+ * renderings of its inner segments, the segment can be updated by updating
+ * only its inner segments. Otherwise (when a rendering object or a filter
+ * processes the rendering of its section, or when a text partial is
+ * HTML-escaped), the segment forgets its inner segments, and is rendered again
+ * as a whole.
+ *
+ * @see GRMustacheIncrementalRendering
+ */
+@interface GRMustacheRenderingSegment : NSObject {
+@private
+    id<GRMustacheTemplateComponent> _component;
+    GRMustacheContext *_context;
+    GRMustacheContentType _contentType;
+    GRMustacheRenderingSegment *_parent;
+    NSMutableSet *_keyPaths;
+    NSMutableArray *_segments;
+    NSUInteger _length;
+    BOOL _recordsInnerSegments;
+    BOOL _processesRenderingOfInnerSegments;
+}
+
+/**
+ * The key paths read by the tags of the segment that are not read by its
+ * inner segments.
+ */
+@property (nonatomic, retain, readonly) NSMutableSet *keyPaths GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Renders components, and records them as inner segments of the receiver.
+ *
+ * This method is called instead of rendering components one after the other
+ * when the context has a rendering segment.
+ *
+ * @param components   An array of template components.
+ * @param contentType  The content type of the rendering.
+ * @param buffer       A mutable string.
+ * @param context      A rendering context, whose renderingSegment is the
+ *                     receiver.
+ * @param error        If there is an error performing the rendering, upon
+ *                     return contains an NSError object that describes the
+ *                     problem.
+ *
+ * @return YES if the rendering succeeds.
+ */
+- (BOOL)renderComponents:(NSArray *)components contentType:(GRMustacheContentType)contentType inBuffer:(NSMutableString *)buffer withContext:(GRMustacheContext *)context error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Tells the receiver that its rendering is not the concatenation of the
+ * renderings of its inner segments, because a rendering object, or HTML
+ * escaping, has processed them. The receiver will be rendered again as a
+ * whole.
+ *
+ * @see -[GRMustacheTag renderContentType:inBuffer:withContext:error:]
+ */
+- (void)didProcessRenderingOfInnerSegments GRMUSTACHE_API_INTERNAL;
+
+@end
+
+// Documented in GRMustacheIncrementalRendering.h
+@interface GRMustacheIncrementalRendering : NSObject {
+@private
+    GRMustacheTemplate *_template;
+    GRMustacheContext *_context;
+    GRMustacheRenderingSegment *_rootSegment;
+    NSMutableString *_string;
+}
+
+// Documented in GRMustacheIncrementalRendering.h
++ (instancetype)incrementalRenderingWithTemplate:(GRMustacheTemplate *)template object:(id)object error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheIncrementalRendering.h
+@property (nonatomic, readonly) NSString *string GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheIncrementalRendering.h
+- (BOOL)updateWithChangedKeyPaths:(NSSet *)keyPaths error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
+@end
@@ -0,0 +1,180 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheInstrumentation_private.h"
+#import <pthread.h>
+
+#if defined(__APPLE__)
+#import <mach/mach_time.h>
+#else
+#import <time.h>
+#import <objc/runtime.h>
+#import <Foundation/NSDebug.h>
+#endif
+
+static NSUInteger allocationCountingRequests = 0;
+static volatile int64_t allocationCount = 0;
+static volatile int64_t allocationBytes = 0;
+static pthread_mutex_t allocationCountingMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+// =============================================================================
+#pragma mark - Allocation hooks
+
+// Allocation hooks rely on debugging facilities that must not ship in release
+// builds: they are only compiled when GRMUSTACHE_COUNT_ALLOCATIONS is defined,
+// as in the Debug configuration of the Xcode project, and in the benchmarks.
+
+#if defined(GRMUSTACHE_COUNT_ALLOCATIONS)
+
+#if defined(__APPLE__)
+
+// The malloc logger is the hook used by MallocStackLogging. It is exported by
+// libmalloc, but not declared in any public header.
+typedef void (GRMustacheMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip);
+extern GRMustacheMallocLogger *malloc_logger;
+
+#define GRMUSTACHE_MALLOC_LOG_TYPE_ALLOCATE     2
+#define GRMUSTACHE_MALLOC_LOG_TYPE_DEALLOCATE   4
+
+static GRMustacheMallocLogger *previousMallocLogger = NULL;
+
+static void GRMustacheMallocLoggerHook(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result, uint32_t numHotFramesToSkip)
+{
+    if (type & GRMUSTACHE_MALLOC_LOG_TYPE_ALLOCATE) {
+        // realloc is logged as an allocation and a deallocation: the new size
+        // is then the third argument.
+        uintptr_t size = (type & GRMUSTACHE_MALLOC_LOG_TYPE_DEALLOCATE) ? arg3 : arg2;
+        __sync_fetch_and_add(&allocationCount, 1);
+        __sync_fetch_and_add(&allocationBytes, (int64_t)size);
+    }
+    if (previousMallocLogger) {
+        previousMallocLogger(type, arg1, arg2, arg3, result, numHotFramesToSkip + 1);
+    }
+}
+
+static void GRMustacheInstallAllocationHook(void)
+{
+    previousMallocLogger = malloc_logger;
+    malloc_logger = GRMustacheMallocLoggerHook;
+}
+
+static void GRMustacheRemoveAllocationHook(void)
+{
+    malloc_logger = previousMallocLogger;
+    previousMallocLogger = NULL;
+}
+
+#else
+
+static void GRMustacheDebugAllocationAddHook(Class aClass, id object)
+{
+    __sync_fetch_and_add(&allocationCount, 1);
+    __sync_fetch_and_add(&allocationBytes, (int64_t)class_getInstanceSize(aClass));
+}
+
+static void GRMustacheDebugAllocationRemoveHook(Class aClass, id object)
+{
+}
+
+static void GRMustacheInstallAllocationHook(void)
+{
+    GSSetDebugAllocationFunctions(GRMustacheDebugAllocationAddHook, GRMustacheDebugAllocationRemoveHook);
+    GSDebugAllocationActive(YES);
+}
+
+static void GRMustacheRemoveAllocationHook(void)
+{
+    GSDebugAllocationActive(NO);
+    GSSetDebugAllocationFunctions(NULL, NULL);
+}
+
+#endif
+
+#else
+
+static void GRMustacheInstallAllocationHook(void)
+{
+}
+
+static void GRMustacheRemoveAllocationHook(void)
+{
+}
+
+#endif
+
+
+// =============================================================================
+#pragma mark - Public functions
+
+uint64_t GRMustacheInstrumentationNanoseconds(void)
+{
+#if defined(__APPLE__)
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void GRMustacheInstrumentationStartCountingAllocations(void)
+{
+#if defined(GRMUSTACHE_COUNT_ALLOCATIONS)
+    pthread_mutex_lock(&allocationCountingMutex);
+    if (allocationCountingRequests++ == 0) {
+        GRMustacheInstallAllocationHook();
+    }
+    pthread_mutex_unlock(&allocationCountingMutex);
+#endif
+}
+
+void GRMustacheInstrumentationStopCountingAllocations(void)
+{
+#if defined(GRMUSTACHE_COUNT_ALLOCATIONS)
+    pthread_mutex_lock(&allocationCountingMutex);
+    NSCAssert(allocationCountingRequests > 0, @"Unbalanced GRMustacheInstrumentationStopCountingAllocations()");
+    if (allocationCountingRequests > 0 && --allocationCountingRequests == 0) {
+        GRMustacheRemoveAllocationHook();
+    }
+    pthread_mutex_unlock(&allocationCountingMutex);
+#endif
+}
+
+BOOL GRMustacheInstrumentationIsCountingAllocations(void)
+{
+    pthread_mutex_lock(&allocationCountingMutex);
+    BOOL counting = (allocationCountingRequests > 0);
+    pthread_mutex_unlock(&allocationCountingMutex);
+    return counting;
+}
+
+GRMustacheAllocationStats GRMustacheInstrumentationAllocationStats(void)
+{
+    return (GRMustacheAllocationStats){
+        .count = (uint64_t)__sync_fetch_and_add(&allocationCount, 0),
+        .bytes = (uint64_t)__sync_fetch_and_add(&allocationBytes, 0) };
+}
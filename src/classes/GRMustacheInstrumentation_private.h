@@ -0,0 +1,87 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * Allocation statistics, as returned by
+ * GRMustacheInstrumentationAllocationStats().
+ */
+typedef struct {
+    /**
+     * The number of memory allocations.
+     */
+    uint64_t count;
+    
+    /**
+     * The number of allocated bytes.
+     */
+    uint64_t bytes;
+} GRMustacheAllocationStats;
+
+/**
+ * Returns a monotonic time, in nanoseconds.
+ *
+ * Only differences between two values returned by this function are
+ * meaningful.
+ */
+uint64_t GRMustacheInstrumentationNanoseconds(void) GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Installs the allocation hook that feeds
+ * GRMustacheInstrumentationAllocationStats().
+ *
+ * On Apple platforms, the hook is the malloc logger of libmalloc, and all
+ * memory allocations are counted. With GNUstep, the hook relies on
+ * GSDebugAllocation, and only Objective-C object allocations are counted.
+ *
+ * Those hooks are debugging facilities that must not ship in release builds:
+ * they are only compiled when the GRMUSTACHE_COUNT_ALLOCATIONS preprocessor
+ * macro is defined. Otherwise, this function does nothing, and no allocation
+ * is counted.
+ *
+ * Allocations are counted process-wide, regardless of the thread that performs
+ * them. Calls must be balanced with
+ * GRMustacheInstrumentationStopCountingAllocations(): the hook is installed by
+ * the first call, and removed by the last balancing call.
+ */
+void GRMustacheInstrumentationStartCountingAllocations(void) GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Balances a call to GRMustacheInstrumentationStartCountingAllocations().
+ */
+void GRMustacheInstrumentationStopCountingAllocations(void) GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns YES if the allocation hook is installed.
+ */
+BOOL GRMustacheInstrumentationIsCountingAllocations(void) GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns the allocations counted since
+ * GRMustacheInstrumentationStartCountingAllocations() was called.
+ *
+ * Only differences between two values returned by this function are
+ * meaningful.
+ */
+GRMustacheAllocationStats GRMustacheInstrumentationAllocationStats(void) GRMUSTACHE_API_INTERNAL;
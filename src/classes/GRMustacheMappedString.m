@@ -0,0 +1,228 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheMappedString_private.h"
+
+// Substrings shorter than this threshold are copied into regular strings:
+// identifiers and short texts are faster to hash and compare that way, and do
+// not retain the mapping.
+static const NSUInteger GRMustacheMappedStringMinimumViewLength = 64;
+
+/**
+ * Returns the length of the longest prefix of bytes that only contains ASCII
+ * characters.
+ *
+ * Bytes are tested eight at a time: most template files are ASCII, and this
+ * scan is the only work needed to load them.
+ */
+static NSUInteger GRMustacheASCIIPrefixLength(const uint8_t *bytes, NSUInteger length)
+{
+    static const uint64_t highBits = 0x8080808080808080ULL;
+    NSUInteger i = 0;
+    for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(uint64_t));  // bytes may not be aligned
+        if (word & highBits) {
+            break;
+        }
+    }
+    for (; i < length; ++i) {
+        if (bytes[i] >= 0x80) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * Returns YES if all bytes are characters in the given encoding, so that the
+ * file can be indexed as UTF-16.
+ */
+static BOOL GRMustacheBytesAreCharacters(const uint8_t *bytes, NSUInteger length, NSStringEncoding encoding)
+{
+    switch (encoding) {
+        case NSISOLatin1StringEncoding:
+            // All ISO Latin 1 characters are the first 256 unicode code points.
+            return YES;
+            
+        case NSASCIIStringEncoding:
+        case NSUTF8StringEncoding:
+            return GRMustacheASCIIPrefixLength(bytes, length) == length;
+            
+        default:
+            return NO;
+    }
+}
+
+/**
+ * Returns the encoding given by the byte order mark that starts the bytes, or
+ * the provided encoding if there is no byte order mark.
+ *
+ * Upon return, *ioBytes and *ioLength no longer include the byte order mark.
+ */
+static NSStringEncoding GRMustacheSniffEncoding(const uint8_t **ioBytes, NSUInteger *ioLength, NSStringEncoding encoding)
+{
+    static const struct {
+        uint8_t bytes[4];
+        NSUInteger length;
+        NSStringEncoding encoding;
+    } byteOrderMarks[] = {
+        // UTF-32 first, because the little endian UTF-32 byte order mark
+        // starts with the little endian UTF-16 byte order mark.
+        { { 0xFF, 0xFE, 0x00, 0x00 }, 4, NSUTF32LittleEndianStringEncoding },
+        { { 0x00, 0x00, 0xFE, 0xFF }, 4, NSUTF32BigEndianStringEncoding },
+        { { 0xEF, 0xBB, 0xBF }, 3, NSUTF8StringEncoding },
+        { { 0xFF, 0xFE }, 2, NSUTF16LittleEndianStringEncoding },
+        { { 0xFE, 0xFF }, 2, NSUTF16BigEndianStringEncoding },
+    };
+    
+    for (size_t i = 0; i < sizeof(byteOrderMarks) / sizeof(byteOrderMarks[0]); ++i) {
+        NSUInteger length = byteOrderMarks[i].length;
+        if (*ioLength >= length && memcmp(*ioBytes, byteOrderMarks[i].bytes, length) == 0) {
+            *ioBytes += length;
+            *ioLength -= length;
+            return byteOrderMarks[i].encoding;
+        }
+    }
+    return encoding;
+}
+
+@interface GRMustacheMappedString()
+- (id)initWithData:(NSData *)data bytes:(const uint8_t *)bytes length:(NSUInteger)length;
+@end
+
+@implementation GRMustacheMappedString
+
++ (NSString *)stringWithContentsOfFile:(NSString *)path encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:error];
+    if (!data) {
+        return nil;
+    }
+    
+    NSString *string = [self stringWithData:data range:NSMakeRange(0, data.length) encoding:encoding error:NULL];
+    if (!string && error != NULL) {
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadInapplicableStringEncodingError userInfo:[NSDictionary dictionaryWithObjectsAndKeys:
+                                                                                                                           path, NSFilePathErrorKey,
+                                                                                                                           [NSNumber numberWithUnsignedInteger:encoding], NSStringEncodingErrorKey,
+                                                                                                                           nil]];
+    }
+    return string;
+}
+
++ (NSString *)stringWithData:(NSData *)data range:(NSRange)range encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    NSParameterAssert(NSMaxRange(range) <= data.length);
+    
+    const uint8_t *bytes = (const uint8_t *)data.bytes + range.location;
+    NSUInteger length = range.length;
+    encoding = GRMustacheSniffEncoding(&bytes, &length, encoding);
+    
+    if (length == 0) {
+        return @"";
+    }
+    
+    if (GRMustacheBytesAreCharacters(bytes, length, encoding)) {
+        return [[[self alloc] initWithData:data bytes:bytes length:length] autorelease];
+    }
+    
+    NSString *string = [[[NSString alloc] initWithBytes:bytes length:length encoding:encoding] autorelease];
+    if (!string && error != NULL) {
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadInapplicableStringEncodingError userInfo:nil];
+    }
+    return string;
+}
+
+- (void)dealloc
+{
+    [_data release];
+    [super dealloc];
+}
+
+- (id)initWithData:(NSData *)data bytes:(const uint8_t *)bytes length:(NSUInteger)length
+{
+    self = [super init];
+    if (self) {
+        _data = [data retain];
+        _bytes = bytes;
+        _length = length;
+    }
+    return self;
+}
+
+
+#pragma mark - NSString
+
+- (NSUInteger)length
+{
+    return _length;
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+    if (index >= _length) {
+        [NSException raise:NSRangeException format:@"Index %lu out of bounds", (unsigned long)index];
+    }
+    return _bytes[index];
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+    if (NSMaxRange(range) > _length) {
+        [NSException raise:NSRangeException format:@"Range %@ out of bounds", NSStringFromRange(range)];
+    }
+    const uint8_t *bytes = _bytes + range.location;
+    for (NSUInteger i = 0; i < range.length; ++i) {
+        buffer[i] = bytes[i];
+    }
+}
+
+- (NSString *)substringWithRange:(NSRange)range
+{
+    if (NSMaxRange(range) > _length) {
+        [NSException raise:NSRangeException format:@"Range %@ out of bounds", NSStringFromRange(range)];
+    }
+    if (range.length < GRMustacheMappedStringMinimumViewLength) {
+        // Bytes are ISO Latin 1 characters, or ASCII characters, which are
+        // also ISO Latin 1 characters.
+        return [[[NSString alloc] initWithBytes:_bytes + range.location length:range.length encoding:NSISOLatin1StringEncoding] autorelease];
+    }
+    return [[[GRMustacheMappedString alloc] initWithData:_data bytes:_bytes + range.location length:range.length] autorelease];
+}
+
+- (NSString *)substringFromIndex:(NSUInteger)index
+{
+    return [self substringWithRange:NSMakeRange(index, _length - MIN(index, _length))];
+}
+
+- (NSString *)substringToIndex:(NSUInteger)index
+{
+    return [self substringWithRange:NSMakeRange(0, index)];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return [self retain];
+}
+
+@end
@@ -0,0 +1,89 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * A GRMustacheMappedString is an immutable string whose characters are the
+ * bytes of a memory-mapped file.
+ *
+ * Its substrings share the mapping, so that text components and tags parsed
+ * from a template file do not copy their characters, and that the pages of a
+ * template file are shared by all processes that load it.
+ *
+ * The parser and the renderer use UTF-16 indexes: a string can only be mapped
+ * when each byte of the file is a character. This is the case of ASCII and
+ * ISO Latin 1 files, and of UTF-8 files that contain only ASCII characters.
+ * Other files are decoded as usual.
+ *
+ * Files that start with a UTF-8, UTF-16 or UTF-32 byte order mark are decoded
+ * in the encoding given by the byte order mark, regardless of the encoding
+ * provided by the caller. The byte order mark is not part of the string.
+ */
+@interface GRMustacheMappedString : NSString {
+@private
+    NSData *_data;
+    const uint8_t *_bytes;
+    NSUInteger _length;
+}
+
+/**
+ * Returns the contents of a file.
+ *
+ * The returned string is a GRMustacheMappedString when the file can be
+ * mapped, and its characters are single bytes in the given encoding.
+ * Otherwise, the returned string is a regular NSString.
+ *
+ * @param path      The path of the file.
+ * @param encoding  The encoding of the file, if it does not start with a byte
+ *                  order mark.
+ * @param error     If there is an error reading or decoding the file, upon
+ *                  return contains an NSError object that describes the
+ *                  problem.
+ *
+ * @return A string, or nil.
+ */
++ (NSString *)stringWithContentsOfFile:(NSString *)path encoding:(NSStringEncoding)encoding error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns the string encoded in a range of bytes of a memory-mapped file, or
+ * of the contents of an URL.
+ *
+ * The returned string is a GRMustacheMappedString that retains _data_ when its
+ * characters are single bytes in the given encoding. Otherwise, the returned
+ * string is a regular NSString.
+ *
+ * @param data      The contents of a file, as returned by
+ *                  +[NSData dataWithContentsOfFile:options:error:], or of an
+ *                  URL.
+ * @param range     A range of bytes of data.
+ * @param encoding  The encoding of the bytes, if they do not start with a
+ *                  byte order mark.
+ * @param error     If the bytes can not be decoded, upon return contains an
+ *                  NSError object that describes the problem.
+ *
+ * @return A string, or nil.
+ */
++ (NSString *)stringWithData:(NSData *)data range:(NSRange)range encoding:(NSStringEncoding)encoding error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+@end
@@ -0,0 +1,154 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+/**
+ * The categories of memory retained by compiled templates.
+ *
+ * @see GRMustacheMemoryFootprint
+ *
+ * @since v6.5
+ */
+typedef NS_ENUM(NSUInteger, GRMustacheMemoryCategory) {
+    /**
+     * Template objects, template overrides `{{<partial}}...{{/partial}}`, and
+     * the arrays of their components.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryTemplates AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+    
+    /**
+     * Text components, and their text.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryTextComponents AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+    
+    /**
+     * Variable and section tags, and the arrays of components of sections.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryTags AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+    
+    /**
+     * Expressions, such as `name`, `a.b` or `f(x)`, and their identifiers.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryExpressions AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+    
+    /**
+     * Parser tokens retained by expressions, for error reporting.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryTokens AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+    
+    /**
+     * Template sources, retained by tokens and section tags.
+     *
+     * @since v6.5
+     */
+    GRMustacheMemoryCategoryTemplateStrings AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER,
+} AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of values of GRMustacheMemoryCategory.
+ *
+ * @since v6.5
+ */
+#define GRMustacheMemoryCategoryCount 6
+
+/**
+ * A GRMustacheMemoryFootprint object reports the memory retained by compiled
+ * templates, by category.
+ *
+ * Objects shared by several templates, such as partials, or the source of a
+ * template retained by many tokens, are counted once.
+ *
+ * Sizes are the sizes of the memory blocks allocated for objects, as reported
+ * by the allocator when possible, and estimated from the object class and
+ * content otherwise. Objects that are not allocated on the heap, such as
+ * string literals, have no size.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/template_repositories.md
+ *
+ * @see [GRMustacheTemplate memoryFootprint]
+ * @see [GRMustacheTemplateRepository memoryFootprint]
+ *
+ * @since v6.5
+ */
+@interface GRMustacheMemoryFootprint : NSObject {
+@private
+    NSUInteger _bytes[GRMustacheMemoryCategoryCount];
+    NSUInteger _objectCounts[GRMustacheMemoryCategoryCount];
+}
+
+/**
+ * The total number of bytes retained by the measured templates.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger totalBytes AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns the number of bytes retained in a category.
+ *
+ * @param category  A memory category.
+ *
+ * @return A number of bytes.
+ *
+ * @since v6.5
+ */
+- (NSUInteger)bytesInCategory:(GRMustacheMemoryCategory)category AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns the number of objects in a category.
+ *
+ * Auxiliary objects, such as arrays of components, or the text of text
+ * components, are not counted, but their size is.
+ *
+ * @param category  A memory category.
+ *
+ * @return A number of objects.
+ *
+ * @since v6.5
+ */
+- (NSUInteger)objectCountInCategory:(GRMustacheMemoryCategory)category AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns a property list suitable for logging or exporting, with the keys
+ * `templates`, `textComponents`, `tags`, `expressions`, `tokens`,
+ * `templateStrings`, and `totalBytes`. The value of category keys are
+ * dictionaries with the keys `bytes` and `count`.
+ *
+ * @return A dictionary.
+ *
+ * @since v6.5
+ */
+- (NSDictionary *)dictionaryRepresentation AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
@@ -0,0 +1,299 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <objc/runtime.h>
+#if defined(__APPLE__)
+#import <malloc/malloc.h>
+#endif
+#import "GRMustacheMemoryFootprint_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateComponent_private.h"
+#import "GRMustacheTemplateOverride_private.h"
+#import "GRMustacheSectionTag_private.h"
+#import "GRMustacheVariableTag_private.h"
+#import "GRMustacheTextComponent_private.h"
+#import "GRMustacheExpression_private.h"
+#import "GRMustacheFilteredExpression_private.h"
+#import "GRMustacheIdentifierExpression_private.h"
+#import "GRMustacheImplicitIteratorExpression_private.h"
+#import "GRMustacheScopedExpression_private.h"
+#import "GRMustacheToken_private.h"
+#import "GRMustacheSpooledString_private.h"
+#import "GRMustacheRefetchableString_private.h"
+#import "GRMustacheMappedString_private.h"
+
+static NSString * const GRMustacheMemoryCategoryKeys[GRMustacheMemoryCategoryCount] = {
+    @"templates",
+    @"textComponents",
+    @"tags",
+    @"expressions",
+    @"tokens",
+    @"templateStrings",
+};
+
+/**
+ * Returns the number of bytes allocated for an object, including the storage
+ * of the content of strings and arrays when it lives outside of the object.
+ */
+static NSUInteger GRMustacheObjectSize(id object)
+{
+    NSUInteger size = 0;
+#if defined(__APPLE__)
+    size = malloc_size(object);  // 0 for objects that do not live in the heap, such as string literals.
+    if (size == 0) {
+        return 0;
+    }
+#else
+    size = class_getInstanceSize(object_getClass(object));
+#endif
+    
+    // Content of class clusters usually lives in a separate allocation.
+    NSUInteger contentSize = 0;
+    if ([object isKindOfClass:[GRMustacheSpooledString class]] || [object isKindOfClass:[GRMustacheRefetchableString class]]) {
+        // Content does not live in memory.
+    } else if ([object isKindOfClass:[GRMustacheMappedString class]]) {
+        // Content lives in the pages of a memory-mapped file, shared with
+        // all the strings that map the same file.
+    } else if ([object isKindOfClass:[NSString class]]) {
+        contentSize = [(NSString *)object length] * sizeof(unichar);
+    } else if ([object isKindOfClass:[NSArray class]]) {
+        contentSize = [(NSArray *)object count] * sizeof(id);
+    }
+    if (size < contentSize) {
+        size += contentSize;
+    }
+    return size;
+}
+
+
+// =============================================================================
+#pragma mark - GRMustacheMemoryFootprintWalker
+
+/**
+ * The GRMustacheMemoryFootprintWalker visits templates and expressions, and
+ * accumulates the size of the objects they retain into a memory footprint.
+ */
+@interface GRMustacheMemoryFootprintWalker : NSObject<GRMustacheTemplateComponentVisitor, GRMustacheExpressionVisitor> {
+@private
+    GRMustacheMemoryFootprint *_memoryFootprint;
+    NSHashTable *_visitedObjects;
+}
+- (id)initWithMemoryFootprint:(GRMustacheMemoryFootprint *)memoryFootprint;
+- (BOOL)addObject:(id)object category:(GRMustacheMemoryCategory)category counted:(BOOL)counted;
+- (void)visitComponents:(NSArray *)components;
+- (void)visitExpression:(GRMustacheExpression *)expression;
+@end
+
+@interface GRMustacheMemoryFootprint()
+- (void)addObjectOfSize:(NSUInteger)size category:(GRMustacheMemoryCategory)category counted:(BOOL)counted;
+@end
+
+@implementation GRMustacheMemoryFootprintWalker
+
+- (void)dealloc
+{
+    [_visitedObjects release];
+    [super dealloc];
+}
+
+- (id)initWithMemoryFootprint:(GRMustacheMemoryFootprint *)memoryFootprint
+{
+    self = [super init];
+    if (self) {
+        _memoryFootprint = memoryFootprint; // do not retain, since memoryFootprint outlives self.
+        _visitedObjects = [[NSHashTable alloc] initWithOptions:(NSPointerFunctionsOpaqueMemory | NSPointerFunctionsObjectPointerPersonality) capacity:0];
+    }
+    return self;
+}
+
+- (BOOL)addObject:(id)object category:(GRMustacheMemoryCategory)category counted:(BOOL)counted
+{
+    if (object == nil || [_visitedObjects containsObject:object]) {
+        return NO;
+    }
+    [_visitedObjects addObject:object];
+    [_memoryFootprint addObjectOfSize:GRMustacheObjectSize(object) category:category counted:counted];
+    return YES;
+}
+
+- (void)visitComponents:(NSArray *)components
+{
+    for (id<GRMustacheTemplateComponent> component in components) {
+        [component acceptTemplateComponentVisitor:self];
+    }
+}
+
+- (void)visitExpression:(GRMustacheExpression *)expression
+{
+    [expression acceptExpressionVisitor:self];
+}
+
+- (void)visitToken:(GRMustacheToken *)token
+{
+    if ([self addObject:token category:GRMustacheMemoryCategoryTokens counted:YES]) {
+        [self addObject:token.templateString category:GRMustacheMemoryCategoryTemplateStrings counted:YES];
+    }
+}
+
+
+#pragma mark <GRMustacheTemplateComponentVisitor>
+
+- (void)visitTemplate:(GRMustacheTemplate *)template
+{
+    // Root templates, and partial tags.
+    if ([self addObject:template category:GRMustacheMemoryCategoryTemplates counted:YES]) {
+        [self addObject:template.components category:GRMustacheMemoryCategoryTemplates counted:NO];
+        [self visitComponents:template.components];
+    }
+}
+
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride
+{
+    if ([self addObject:templateOverride category:GRMustacheMemoryCategoryTemplates counted:YES]) {
+        [self addObject:templateOverride.components category:GRMustacheMemoryCategoryTemplates counted:NO];
+        [self visitTemplate:templateOverride.template];
+        [self visitComponents:templateOverride.components];
+    }
+}
+
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag
+{
+    if ([self addObject:sectionTag category:GRMustacheMemoryCategoryTags counted:YES]) {
+        [self addObject:sectionTag.components category:GRMustacheMemoryCategoryTags counted:NO];
+        [self addObject:sectionTag.templateString category:GRMustacheMemoryCategoryTemplateStrings counted:YES];
+        [self visitExpression:sectionTag.expression];
+        [self visitComponents:sectionTag.components];
+    }
+}
+
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag
+{
+    if ([self addObject:variableTag category:GRMustacheMemoryCategoryTags counted:YES]) {
+        [self visitExpression:variableTag.expression];
+    }
+}
+
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent
+{
+    if ([self addObject:textComponent category:GRMustacheMemoryCategoryTextComponents counted:YES]) {
+        [self addObject:textComponent.text category:GRMustacheMemoryCategoryTextComponents counted:NO];
+    }
+}
+
+
+#pragma mark <GRMustacheExpressionVisitor>
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    if ([self addObject:expression category:GRMustacheMemoryCategoryExpressions counted:YES]) {
+        [self visitToken:expression.token];
+        [self visitExpression:expression.filterExpression];
+        [self visitExpression:expression.argumentExpression];
+    }
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    if ([self addObject:expression category:GRMustacheMemoryCategoryExpressions counted:YES]) {
+        [self visitToken:expression.token];
+        [self addObject:expression.identifier category:GRMustacheMemoryCategoryExpressions counted:NO];
+    }
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+    if ([self addObject:expression category:GRMustacheMemoryCategoryExpressions counted:YES]) {
+        [self visitToken:expression.token];
+    }
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    if ([self addObject:expression category:GRMustacheMemoryCategoryExpressions counted:YES]) {
+        [self visitToken:expression.token];
+        [self addObject:expression.scopeIdentifier category:GRMustacheMemoryCategoryExpressions counted:NO];
+        [self visitExpression:expression.baseExpression];
+    }
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheMemoryFootprint
+
+@implementation GRMustacheMemoryFootprint
+
++ (instancetype)memoryFootprintWithTemplates:(NSArray *)templates
+{
+    GRMustacheMemoryFootprint *memoryFootprint = [[[self alloc] init] autorelease];
+    GRMustacheMemoryFootprintWalker *walker = [[[GRMustacheMemoryFootprintWalker alloc] initWithMemoryFootprint:memoryFootprint] autorelease];
+    for (GRMustacheTemplate *template in templates) {
+        [walker visitTemplate:template];
+    }
+    return memoryFootprint;
+}
+
+- (void)addObjectOfSize:(NSUInteger)size category:(GRMustacheMemoryCategory)category counted:(BOOL)counted
+{
+    _bytes[category] += size;
+    if (counted) {
+        _objectCounts[category] += 1;
+    }
+}
+
+- (NSUInteger)totalBytes
+{
+    NSUInteger totalBytes = 0;
+    for (NSUInteger category = 0; category < GRMustacheMemoryCategoryCount; ++category) {
+        totalBytes += _bytes[category];
+    }
+    return totalBytes;
+}
+
+- (NSUInteger)bytesInCategory:(GRMustacheMemoryCategory)category
+{
+    NSParameterAssert(category < GRMustacheMemoryCategoryCount);
+    return _bytes[category];
+}
+
+- (NSUInteger)objectCountInCategory:(GRMustacheMemoryCategory)category
+{
+    NSParameterAssert(category < GRMustacheMemoryCategoryCount);
+    return _objectCounts[category];
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:GRMustacheMemoryCategoryCount + 1];
+    for (NSUInteger category = 0; category < GRMustacheMemoryCategoryCount; ++category) {
+        [dictionary setObject:[NSDictionary dictionaryWithObjectsAndKeys:
+                               [NSNumber numberWithUnsignedInteger:_bytes[category]], @"bytes",
+                               [NSNumber numberWithUnsignedInteger:_objectCounts[category]], @"count",
+                               nil]
+                       forKey:GRMustacheMemoryCategoryKeys[category]];
+    }
+    [dictionary setObject:[NSNumber numberWithUnsignedInteger:self.totalBytes] forKey:@"totalBytes"];
+    return dictionary;
+}
+
+@end
@@ -0,0 +1,81 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+// Documented in GRMustacheMemoryFootprint.h
+typedef NS_ENUM(NSUInteger, GRMustacheMemoryCategory) {
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryTemplates GRMUSTACHE_API_PUBLIC,
+    
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryTextComponents GRMUSTACHE_API_PUBLIC,
+    
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryTags GRMUSTACHE_API_PUBLIC,
+    
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryExpressions GRMUSTACHE_API_PUBLIC,
+    
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryTokens GRMUSTACHE_API_PUBLIC,
+    
+    // Documented in GRMustacheMemoryFootprint.h
+    GRMustacheMemoryCategoryTemplateStrings GRMUSTACHE_API_PUBLIC,
+} GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMemoryFootprint.h
+#define GRMustacheMemoryCategoryCount 6
+
+// Documented in GRMustacheMemoryFootprint.h
+@interface GRMustacheMemoryFootprint : NSObject {
+@private
+    NSUInteger _bytes[GRMustacheMemoryCategoryCount];
+    NSUInteger _objectCounts[GRMustacheMemoryCategoryCount];
+}
+
+/**
+ * Returns the memory footprint of templates, and of the partials they embed.
+ *
+ * @param templates  An array of GRMustacheTemplate.
+ *
+ * @return A memory footprint.
+ *
+ * @see [GRMustacheTemplate memoryFootprint]
+ * @see [GRMustacheTemplateRepository memoryFootprint]
+ */
++ (instancetype)memoryFootprintWithTemplates:(NSArray *)templates GRMUSTACHE_API_INTERNAL;
+
+// Documented in GRMustacheMemoryFootprint.h
+@property (nonatomic, readonly) NSUInteger totalBytes GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMemoryFootprint.h
+- (NSUInteger)bytesInCategory:(GRMustacheMemoryCategory)category GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMemoryFootprint.h
+- (NSUInteger)objectCountInCategory:(GRMustacheMemoryCategory)category GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMemoryFootprint.h
+- (NSDictionary *)dictionaryRepresentation GRMUSTACHE_API_PUBLIC;
+
+@end
@@ -0,0 +1,251 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+/**
+ * The number of buckets of GRMustacheHistogram.
+ *
+ * @since v6.5
+ */
+#define GRMustacheHistogramBucketCount 65
+
+/**
+ * A GRMustacheHistogram counts recorded values in buckets of exponential
+ * width: bucket 0 counts zero values, and bucket i (i > 0) counts values in the
+ * range [2^(i-1), 2^i - 1].
+ *
+ * All methods are lock-free, and can be called from any thread. Each counter
+ * is individually consistent, but a reader running concurrently with writers
+ * may see a count that does not exactly match the sum of the buckets.
+ *
+ * @see GRMustacheMetrics
+ *
+ * @since v6.5
+ */
+@interface GRMustacheHistogram : NSObject {
+@private
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _buckets[GRMustacheHistogramBucketCount];
+}
+
+/**
+ * The number of recorded values.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t count AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The sum of recorded values.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t sum AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns the number of recorded values that fell in a bucket.
+ *
+ * @param index  A bucket index, lower than GRMustacheHistogramBucketCount.
+ *
+ * @return The number of recorded values that fell in the bucket.
+ *
+ * @since v6.5
+ */
+- (uint64_t)countInBucketAtIndex:(NSUInteger)index AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns the greatest value counted by a bucket.
+ *
+ * @param index  A bucket index, lower than GRMustacheHistogramBucketCount.
+ *
+ * @return The greatest value counted by the bucket.
+ *
+ * @since v6.5
+ */
++ (uint64_t)upperBoundOfBucketAtIndex:(NSUInteger)index AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
+
+
+/**
+ * A GRMustacheMetrics object describes the runtime behavior of a template
+ * repository, and of the templates it has built.
+ *
+ * All latencies are measured in nanoseconds. Lengths are measured in
+ * characters (UTF-16 code units), as in the `length` method of NSString.
+ *
+ * All methods are lock-free, and can be called from any thread, for example
+ * from a monitoring thread that exports metrics while templates are rendered.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/template_repositories.md
+ *
+ * @see GRMustacheTemplateRepository
+ *
+ * @since v6.5
+ */
+@interface GRMustacheMetrics : NSObject {
+@private
+    uint64_t _compiledTemplateCount;
+    uint64_t _templateCacheHitCount;
+    uint64_t _templateCacheMissCount;
+    uint64_t _missingTemplateCacheHitCount;
+    uint64_t _templateSourceLength;
+    uint64_t _renderCount;
+    uint64_t _renderedLength;
+    GRMustacheHistogram *_compileLatencyHistogram;
+    GRMustacheHistogram *_loadLatencyHistogram;
+    GRMustacheHistogram *_renderLatencyHistogram;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Compiling Templates
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The number of templates and partials successfully compiled.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t compiledTemplateCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The latencies of template compilations. They include parsing, and the
+ * loading and compilation of partials that were not cached yet.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain, readonly) GRMustacheHistogram *compileLatencyHistogram AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Loading Templates
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The number of times a template or a partial was requested by name, and found
+ * in the template cache of the repository.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t templateCacheHitCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of times a template or a partial was requested by name, and had
+ * to be loaded from the data source of the repository.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t templateCacheMissCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of times a template or a partial was requested by name, and was
+ * known to be missing, without querying the data source of the repository.
+ *
+ * @see [GRMustacheConfiguration missingTemplateLifetime]
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t missingTemplateCacheHitCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The latencies of template string loading from the data source of the
+ * repository.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain, readonly) GRMustacheHistogram *loadLatencyHistogram AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The total length of the template strings held by the templates cached in the
+ * repository.
+ *
+ * Unlike other metrics, this value is not reset by the reset method.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t templateSourceLength AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Rendering Templates
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The number of successful renderings performed by the renderObject:error: and
+ * renderObjectsFromArray:error: methods of GRMustacheTemplate.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t renderCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The total length of the strings returned by the renderObject:error: and
+ * renderObjectsFromArray:error: methods of GRMustacheTemplate.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) uint64_t renderedLength AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The latencies of the successful renderings performed by the
+ * renderObject:error: and renderObjectsFromArray:error: methods of
+ * GRMustacheTemplate.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain, readonly) GRMustacheHistogram *renderLatencyHistogram AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Exporting and Resetting Metrics
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns a property list of the receiver's metrics, suitable for exporting to
+ * a metrics collector.
+ *
+ * Counters are NSNumber. Histograms are dictionaries with keys `count`, `sum`,
+ * and `buckets`: an array of dictionaries with keys `le` (the upper bound of
+ * the bucket) and `count`. Empty buckets are omitted.
+ *
+ * @return A dictionary.
+ *
+ * @since v6.5
+ */
+- (NSDictionary *)dictionaryRepresentation AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Resets all counters and histograms, but templateSourceLength.
+ *
+ * @since v6.5
+ */
+- (void)reset AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
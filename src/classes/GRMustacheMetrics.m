@@ -0,0 +1,234 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheMetrics_private.h"
+
+// Counters are updated and read with atomic operations, so that they never
+// tear, even on 32-bit platforms.
+#define GRMustacheAtomicRead(counter) __sync_fetch_and_add(&(counter), 0)
+#define GRMustacheAtomicAdd(counter, value) __sync_fetch_and_add(&(counter), (value))
+#define GRMustacheAtomicClear(counter) __sync_fetch_and_and(&(counter), 0)
+
+
+// =============================================================================
+#pragma mark - GRMustacheHistogram
+
+@implementation GRMustacheHistogram
+
++ (uint64_t)upperBoundOfBucketAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < GRMustacheHistogramBucketCount);
+    if (index == 0) {
+        return 0;
+    }
+    if (index == GRMustacheHistogramBucketCount - 1) {
+        return UINT64_MAX;
+    }
+    return (UINT64_C(1) << index) - 1;
+}
+
+- (uint64_t)count
+{
+    return GRMustacheAtomicRead(_count);
+}
+
+- (uint64_t)sum
+{
+    return GRMustacheAtomicRead(_sum);
+}
+
+- (uint64_t)countInBucketAtIndex:(NSUInteger)index
+{
+    NSParameterAssert(index < GRMustacheHistogramBucketCount);
+    return GRMustacheAtomicRead(_buckets[index]);
+}
+
+- (void)recordValue:(uint64_t)value
+{
+    // The bucket index is the number of significant bits of the value.
+    NSUInteger index = (value == 0) ? 0 : (64 - __builtin_clzll(value));
+    GRMustacheAtomicAdd(_buckets[index], 1);
+    GRMustacheAtomicAdd(_sum, value);
+    GRMustacheAtomicAdd(_count, 1);
+}
+
+- (void)reset
+{
+    for (NSUInteger index = 0; index < GRMustacheHistogramBucketCount; ++index) {
+        GRMustacheAtomicClear(_buckets[index]);
+    }
+    GRMustacheAtomicClear(_sum);
+    GRMustacheAtomicClear(_count);
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    NSMutableArray *buckets = [NSMutableArray array];
+    for (NSUInteger index = 0; index < GRMustacheHistogramBucketCount; ++index) {
+        uint64_t count = [self countInBucketAtIndex:index];
+        if (count > 0) {
+            [buckets addObject:[NSDictionary dictionaryWithObjectsAndKeys:
+                                [NSNumber numberWithUnsignedLongLong:[GRMustacheHistogram upperBoundOfBucketAtIndex:index]], @"le",
+                                [NSNumber numberWithUnsignedLongLong:count], @"count",
+                                nil]];
+        }
+    }
+    return [NSDictionary dictionaryWithObjectsAndKeys:
+            [NSNumber numberWithUnsignedLongLong:self.count], @"count",
+            [NSNumber numberWithUnsignedLongLong:self.sum], @"sum",
+            buckets, @"buckets",
+            nil];
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheMetrics
+
+@implementation GRMustacheMetrics
+@synthesize compileLatencyHistogram=_compileLatencyHistogram;
+@synthesize loadLatencyHistogram=_loadLatencyHistogram;
+@synthesize renderLatencyHistogram=_renderLatencyHistogram;
+
+- (void)dealloc
+{
+    [_compileLatencyHistogram release];
+    [_loadLatencyHistogram release];
+    [_renderLatencyHistogram release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _compileLatencyHistogram = [[GRMustacheHistogram alloc] init];
+        _loadLatencyHistogram = [[GRMustacheHistogram alloc] init];
+        _renderLatencyHistogram = [[GRMustacheHistogram alloc] init];
+    }
+    return self;
+}
+
+- (uint64_t)compiledTemplateCount
+{
+    return GRMustacheAtomicRead(_compiledTemplateCount);
+}
+
+- (uint64_t)templateCacheHitCount
+{
+    return GRMustacheAtomicRead(_templateCacheHitCount);
+}
+
+- (uint64_t)templateCacheMissCount
+{
+    return GRMustacheAtomicRead(_templateCacheMissCount);
+}
+
+- (uint64_t)missingTemplateCacheHitCount
+{
+    return GRMustacheAtomicRead(_missingTemplateCacheHitCount);
+}
+
+- (uint64_t)templateSourceLength
+{
+    return GRMustacheAtomicRead(_templateSourceLength);
+}
+
+- (uint64_t)renderCount
+{
+    return GRMustacheAtomicRead(_renderCount);
+}
+
+- (uint64_t)renderedLength
+{
+    return GRMustacheAtomicRead(_renderedLength);
+}
+
+- (NSDictionary *)dictionaryRepresentation
+{
+    return [NSDictionary dictionaryWithObjectsAndKeys:
+            [NSNumber numberWithUnsignedLongLong:self.compiledTemplateCount], @"compiledTemplateCount",
+            [_compileLatencyHistogram dictionaryRepresentation], @"compileLatency",
+            [NSNumber numberWithUnsignedLongLong:self.templateCacheHitCount], @"templateCacheHitCount",
+            [NSNumber numberWithUnsignedLongLong:self.templateCacheMissCount], @"templateCacheMissCount",
+            [NSNumber numberWithUnsignedLongLong:self.missingTemplateCacheHitCount], @"missingTemplateCacheHitCount",
+            [_loadLatencyHistogram dictionaryRepresentation], @"loadLatency",
+            [NSNumber numberWithUnsignedLongLong:self.templateSourceLength], @"templateSourceLength",
+            [NSNumber numberWithUnsignedLongLong:self.renderCount], @"renderCount",
+            [NSNumber numberWithUnsignedLongLong:self.renderedLength], @"renderedLength",
+            [_renderLatencyHistogram dictionaryRepresentation], @"renderLatency",
+            nil];
+}
+
+- (void)reset
+{
+    GRMustacheAtomicClear(_compiledTemplateCount);
+    GRMustacheAtomicClear(_templateCacheHitCount);
+    GRMustacheAtomicClear(_templateCacheMissCount);
+    GRMustacheAtomicClear(_missingTemplateCacheHitCount);
+    GRMustacheAtomicClear(_renderCount);
+    GRMustacheAtomicClear(_renderedLength);
+    [_compileLatencyHistogram reset];
+    [_loadLatencyHistogram reset];
+    [_renderLatencyHistogram reset];
+}
+
+- (void)didCompileTemplateWithLatency:(uint64_t)nanoseconds
+{
+    GRMustacheAtomicAdd(_compiledTemplateCount, 1);
+    [_compileLatencyHistogram recordValue:nanoseconds];
+}
+
+- (void)didHitTemplateCache
+{
+    GRMustacheAtomicAdd(_templateCacheHitCount, 1);
+}
+
+- (void)didMissTemplateCache
+{
+    GRMustacheAtomicAdd(_templateCacheMissCount, 1);
+}
+
+- (void)didHitMissingTemplateCache
+{
+    GRMustacheAtomicAdd(_missingTemplateCacheHitCount, 1);
+}
+
+- (void)didLoadTemplateStringWithLatency:(uint64_t)nanoseconds
+{
+    [_loadLatencyHistogram recordValue:nanoseconds];
+}
+
+- (void)didCacheTemplateSourceOfLength:(NSUInteger)length
+{
+    GRMustacheAtomicAdd(_templateSourceLength, (uint64_t)length);
+}
+
+- (void)didRenderLength:(NSUInteger)length withLatency:(uint64_t)nanoseconds
+{
+    GRMustacheAtomicAdd(_renderCount, 1);
+    GRMustacheAtomicAdd(_renderedLength, (uint64_t)length);
+    [_renderLatencyHistogram recordValue:nanoseconds];
+}
+
+@end
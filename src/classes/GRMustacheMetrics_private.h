@@ -0,0 +1,180 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+// Documented in GRMustacheMetrics.h
+#define GRMustacheHistogramBucketCount 65
+
+// Documented in GRMustacheMetrics.h
+@interface GRMustacheHistogram : NSObject {
+@private
+    uint64_t _count;
+    uint64_t _sum;
+    uint64_t _buckets[GRMustacheHistogramBucketCount];
+}
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t count GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t sum GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+- (uint64_t)countInBucketAtIndex:(NSUInteger)index GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
++ (uint64_t)upperBoundOfBucketAtIndex:(NSUInteger)index GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Records a value.
+ *
+ * @param value  A value.
+ */
+- (void)recordValue:(uint64_t)value GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Forgets all recorded values.
+ */
+- (void)reset GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns a property list of the receiver.
+ *
+ * @see [GRMustacheMetrics dictionaryRepresentation]
+ */
+- (NSDictionary *)dictionaryRepresentation GRMUSTACHE_API_INTERNAL;
+
+@end
+
+
+// Documented in GRMustacheMetrics.h
+@interface GRMustacheMetrics : NSObject {
+@private
+    uint64_t _compiledTemplateCount;
+    uint64_t _templateCacheHitCount;
+    uint64_t _templateCacheMissCount;
+    uint64_t _missingTemplateCacheHitCount;
+    uint64_t _templateSourceLength;
+    uint64_t _renderCount;
+    uint64_t _renderedLength;
+    GRMustacheHistogram *_compileLatencyHistogram;
+    GRMustacheHistogram *_loadLatencyHistogram;
+    GRMustacheHistogram *_renderLatencyHistogram;
+}
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t compiledTemplateCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, retain, readonly) GRMustacheHistogram *compileLatencyHistogram GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t templateCacheHitCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t templateCacheMissCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t missingTemplateCacheHitCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, retain, readonly) GRMustacheHistogram *loadLatencyHistogram GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t templateSourceLength GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t renderCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, readonly) uint64_t renderedLength GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+@property (nonatomic, retain, readonly) GRMustacheHistogram *renderLatencyHistogram GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+- (NSDictionary *)dictionaryRepresentation GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheMetrics.h
+- (void)reset GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Records a successful template compilation.
+ *
+ * @param nanoseconds  The duration of the compilation.
+ *
+ * @see [GRMustacheTemplateRepository ASTFromString:templateID:error:]
+ */
+- (void)didCompileTemplateWithLatency:(uint64_t)nanoseconds GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records a template lookup that was served by the template cache.
+ *
+ * @see [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:]
+ */
+- (void)didHitTemplateCache GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records a template lookup that was not served by the template cache.
+ *
+ * @see [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:]
+ */
+- (void)didMissTemplateCache GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records a template lookup that was served by the missing template cache.
+ *
+ * @see [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:]
+ */
+- (void)didHitMissingTemplateCache GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records the loading of a template string from a data source.
+ *
+ * @param nanoseconds  The duration of the loading.
+ *
+ * @see [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:]
+ */
+- (void)didLoadTemplateStringWithLatency:(uint64_t)nanoseconds GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records a template string that is now held by the template cache.
+ *
+ * @param length  The length of the template string.
+ *
+ * @see [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:]
+ */
+- (void)didCacheTemplateSourceOfLength:(NSUInteger)length GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records a template rendering.
+ *
+ * @param length       The length of the rendering.
+ * @param nanoseconds  The duration of the rendering.
+ *
+ * @see [GRMustacheTemplate renderObject:error:]
+ */
+- (void)didRenderLength:(NSUInteger)length withLatency:(uint64_t)nanoseconds GRMUSTACHE_API_INTERNAL;
+
+@end
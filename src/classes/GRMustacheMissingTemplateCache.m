@@ -0,0 +1,155 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheMissingTemplateCache_private.h"
+#import "GRMustacheInstrumentation_private.h"
+
+/**
+ * An entry of a GRMustacheMissingTemplateCache.
+ */
+@interface GRMustacheMissingTemplateCacheEntry : NSObject {
+@private
+    NSError *_error;
+    NSString *_name;
+    id _baseKey;
+    uint64_t _expirationTime;
+}
+@property (nonatomic, retain) NSError *error;
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, retain) id baseKey;
+@property (nonatomic) uint64_t expirationTime;
+@end
+
+@implementation GRMustacheMissingTemplateCacheEntry
+@synthesize error=_error;
+@synthesize name=_name;
+@synthesize baseKey=_baseKey;
+@synthesize expirationTime=_expirationTime;
+
+- (void)dealloc
+{
+    [_error release];
+    [_name release];
+    [_baseKey release];
+    [super dealloc];
+}
+
+@end
+
+
+@interface GRMustacheMissingTemplateCache()
+- (void)removeFirstEntry;
+@end
+
+@implementation GRMustacheMissingTemplateCache
+
+- (void)dealloc
+{
+    [_entriesByBaseTemplateID release];
+    [_entries release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _entriesByBaseTemplateID = [[NSMutableDictionary alloc] init];
+        _entries = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    return _entries.count - _firstEntryIndex;
+}
+
+- (NSError *)errorForTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID now:(uint64_t)now
+{
+    GRMustacheMissingTemplateCacheEntry *entry = [[_entriesByBaseTemplateID objectForKey:(baseTemplateID ?: [NSNull null])] objectForKey:name];
+    if (entry == nil || entry.expirationTime <= now) {
+        return nil;
+    }
+    return entry.error;
+}
+
+- (void)setError:(NSError *)error forTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID expirationTime:(uint64_t)expirationTime capacity:(NSUInteger)capacity
+{
+    if (capacity == 0) {
+        return;
+    }
+    
+    // Entries share the same lifetime: the first entries are the first to
+    // expire, and the oldest.
+    uint64_t now = GRMustacheInstrumentationNanoseconds();
+    while (self.count > 0) {
+        GRMustacheMissingTemplateCacheEntry *firstEntry = [_entries objectAtIndex:_firstEntryIndex];
+        if (self.count < capacity && firstEntry.expirationTime > now) {
+            break;
+        }
+        [self removeFirstEntry];
+    }
+    
+    id baseKey = baseTemplateID ?: [NSNull null];
+    NSMutableDictionary *entryForName = [_entriesByBaseTemplateID objectForKey:baseKey];
+    if (entryForName == nil) {
+        entryForName = [NSMutableDictionary dictionary];
+        [_entriesByBaseTemplateID setObject:entryForName forKey:baseKey];
+    }
+    
+    GRMustacheMissingTemplateCacheEntry *entry = [[[GRMustacheMissingTemplateCacheEntry alloc] init] autorelease];
+    entry.error = error;
+    entry.name = name;
+    entry.baseKey = baseKey;
+    entry.expirationTime = expirationTime;
+    [entryForName setObject:entry forKey:name];
+    [_entries addObject:entry];
+}
+
+
+#pragma mark - Private
+
+- (void)removeFirstEntry
+{
+    GRMustacheMissingTemplateCacheEntry *entry = [_entries objectAtIndex:_firstEntryIndex];
+    
+    // An entry may have been replaced by a more recent one for the same name.
+    NSMutableDictionary *entryForName = [_entriesByBaseTemplateID objectForKey:entry.baseKey];
+    if ([entryForName objectForKey:entry.name] == entry) {
+        [entryForName removeObjectForKey:entry.name];
+        if (entryForName.count == 0) {
+            [_entriesByBaseTemplateID removeObjectForKey:entry.baseKey];
+        }
+    }
+    
+    // Avoid shifting the array on each removal: compact it once half of it
+    // has been removed.
+    [_entries replaceObjectAtIndex:_firstEntryIndex withObject:[NSNull null]];
+    ++_firstEntryIndex;
+    if (_firstEntryIndex * 2 >= _entries.count) {
+        [_entries removeObjectsInRange:NSMakeRange(0, _firstEntryIndex)];
+        _firstEntryIndex = 0;
+    }
+}
+
+@end
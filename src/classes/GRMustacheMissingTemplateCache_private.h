@@ -0,0 +1,79 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * A GRMustacheMissingTemplateCache remembers the errors of template lookups
+ * that did not find any template, so that template repositories do not query
+ * their data source again for the same missing template.
+ *
+ * Errors are keyed by template name and base template ID, the arguments of
+ * [GRMustacheTemplateRepository templateNamed:relativeToTemplateID:error:].
+ *
+ * All entries have the same lifetime: they expire in the order they were
+ * stored, and the oldest entries are evicted first when the cache is full.
+ *
+ * @see [GRMustacheConfiguration missingTemplateLifetime]
+ */
+@interface GRMustacheMissingTemplateCache : NSObject {
+@private
+    NSMutableDictionary *_entriesByBaseTemplateID;
+    NSMutableArray *_entries;
+    NSUInteger _firstEntryIndex;
+}
+
+/**
+ * The number of entries in the cache, expired or not.
+ */
+@property (nonatomic, readonly) NSUInteger count GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns the error stored for a template name and base template ID, or nil if
+ * there is no such error, or if it has expired.
+ *
+ * @param name            A template name
+ * @param baseTemplateID  A base template ID, or nil.
+ * @param now             The current time, as returned by
+ *                        GRMustacheInstrumentationNanoseconds().
+ *
+ * @return An error, or nil.
+ */
+- (NSError *)errorForTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID now:(uint64_t)now GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Stores the error of a template lookup.
+ *
+ * Expired entries are removed, and the oldest entries are evicted until the
+ * cache contains less than _capacity_ entries.
+ *
+ * @param error           The error of the template lookup.
+ * @param name            A template name
+ * @param baseTemplateID  A base template ID, or nil.
+ * @param expirationTime  The time the entry expires, in the time base of
+ *                        GRMustacheInstrumentationNanoseconds().
+ * @param capacity        The maximum number of entries in the cache.
+ */
+- (void)setError:(NSError *)error forTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID expirationTime:(uint64_t)expirationTime capacity:(NSUInteger)capacity GRMUSTACHE_API_INTERNAL;
+
+@end
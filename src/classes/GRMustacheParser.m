@@ -27,6 +27,10 @@
 #import "GRMustacheIdentifierExpression_private.h"
 #import "GRMustacheImplicitIteratorExpression_private.h"
 #import "GRMustacheScopedExpression_private.h"
+#import "GRMustacheSpooledString_private.h"
+
+// The default length of the chunks read from template streams
+static const NSUInteger GRMustacheParserDefaultStreamChunkLength = 64 * 1024;
 
 @interface GRMustacheParser()
 
@@ -49,6 +53,37 @@
  */
 - (BOOL)shouldContinueAfterParsingToken:(GRMustacheToken *)token;
 
+/**
+ * Parses a template string, or a chunk of a streamed template.
+ *
+ * @param templateString       The string to parse.
+ * @param tokenTemplateString  The template string of tokens: templateString
+ *                             itself, or the spooled source of a streamed
+ *                             template.
+ * @param offset               The location of templateString in
+ *                             tokenTemplateString.
+ * @param templateID           A template ID (see GRMustacheTemplateRepository)
+ * @param ioLine               The line of the first character of
+ *                             templateString. Upon return, contains the line
+ *                             of the first unparsed character.
+ * @param final                NO if more characters may follow
+ *                             templateString.
+ *
+ * @return The number of parsed characters, or NSNotFound if the parsing has
+ *         failed, or has been interrupted by the delegate. Unless final is YES,
+ *         the unparsed characters are the beginning of a tag, or the
+ *         beginning of a tag start delimiter, that must be parsed again when
+ *         more characters are available.
+ */
+- (NSUInteger)parseTemplateString:(NSString *)templateString tokenTemplateString:(NSString *)tokenTemplateString offset:(NSUInteger)offset templateID:(id)templateID line:(NSUInteger *)ioLine final:(BOOL)final;
+
+/**
+ * Wrapper around the delegate's `parser:didFailWithError:` method.
+ *
+ * @param error  The error that occurred.
+ */
+- (void)failWithError:(NSError *)error;
+
 /**
  * Wrapper around the delegate's `parser:didFailWithError:` method.
  * 
@@ -92,11 +127,46 @@
 - (NSString *)parsePragma:(NSString *)innerTagString;
 @end
 
+/**
+ * Decodes the bytes read so far from a template stream, and removes them from
+ * pendingBytes.
+ *
+ * Unless final is YES, the UTF-8 sequence that may be cut at the end of the
+ * bytes is left in pendingBytes. Returns nil if the bytes can not be decoded,
+ * and leaves pendingBytes untouched.
+ */
+static NSString *GRMustacheParserDecodePendingBytes(NSMutableData *pendingBytes, NSStringEncoding encoding, BOOL final)
+{
+    const uint8_t *bytes = pendingBytes.bytes;
+    NSUInteger length = pendingBytes.length;
+    
+    if (encoding == NSUTF8StringEncoding && !final) {
+        NSUInteger leadIndex = length;
+        while (leadIndex > 0 && length - leadIndex < 4 && (bytes[leadIndex-1] & 0xC0) == 0x80) {
+            --leadIndex;    // skip continuation bytes
+        }
+        if (leadIndex > 0 && bytes[leadIndex-1] >= 0xC0) {
+            uint8_t lead = bytes[leadIndex-1];
+            NSUInteger sequenceLength = (lead >= 0xF0) ? 4 : ((lead >= 0xE0) ? 3 : 2);
+            if (length - (leadIndex-1) < sequenceLength) {
+                length = leadIndex-1;
+            }
+        }
+    }
+    
+    NSString *string = [[[NSString alloc] initWithBytes:bytes length:length encoding:encoding] autorelease];
+    if (string) {
+        [pendingBytes replaceBytesInRange:NSMakeRange(0, length) withBytes:NULL length:0];
+    }
+    return string;
+}
+
 @implementation GRMustacheParser
 @synthesize delegate=_delegate;
 @synthesize tagStartDelimiter=_tagStartDelimiter;
 @synthesize tagEndDelimiter=_tagEndDelimiter;
 @synthesize pragmas=_pragmas;
+@synthesize streamChunkLength=_streamChunkLength;
 
 - (id)initWithConfiguration:(GRMustacheConfiguration *)configuration
 {
@@ -104,6 +174,7 @@
     if (self) {
         self.tagStartDelimiter = configuration.tagStartDelimiter;
         self.tagEndDelimiter = configuration.tagEndDelimiter;
+        _streamChunkLength = GRMustacheParserDefaultStreamChunkLength;
     }
     return self;
 }
@@ -118,8 +189,78 @@
 
 - (void)parseTemplateString:(NSString *)templateString templateID:(id)templateID
 {
-    NSUInteger p = 0;
+    [self parseTemplateString:templateString tokenTemplateString:templateString templateID:templateID];
+}
+
+- (void)parseTemplateString:(NSString *)templateString tokenTemplateString:(NSString *)tokenTemplateString templateID:(id)templateID
+{
     NSUInteger line = 1;
+    [self parseTemplateString:templateString tokenTemplateString:tokenTemplateString offset:0 templateID:templateID line:&line final:YES];
+}
+
+- (void)parseTemplateStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding templateID:(id)templateID
+{
+    NSError *error = nil;
+    GRMustacheSpooledString *spooledString = [GRMustacheSpooledString spooledStringReturningError:&error];
+    if (!spooledString) {
+        [self failWithError:error];
+        return;
+    }
+    
+    NSMutableString *buffer = [NSMutableString string];     // unparsed characters
+    NSMutableData *pendingBytes = [NSMutableData data];     // undecoded bytes
+    NSUInteger offset = 0;                                  // location of buffer in spooledString
+    NSUInteger line = 1;
+    BOOL final = NO;
+    uint8_t *chunk = malloc(_streamChunkLength);
+    
+    [stream open];
+    while (!final) {
+        @autoreleasepool {
+            NSInteger readLength = [stream read:chunk maxLength:_streamChunkLength];
+            if (readLength < 0) {
+                error = stream.streamError;
+                if (!error) {
+                    error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadUnknownError userInfo:nil];
+                }
+                [self failWithError:error];
+                break;
+            }
+            final = (readLength == 0);
+            [pendingBytes appendBytes:chunk length:(NSUInteger)readLength];
+            
+            NSString *string = GRMustacheParserDecodePendingBytes(pendingBytes, encoding, final);
+            if (!string) {
+                if (final || encoding == NSUTF8StringEncoding) {
+                    [self failWithError:[NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadInapplicableStringEncodingError userInfo:nil]];
+                    break;
+                }
+                // The chunk may end in the middle of a character: read more
+                continue;
+            }
+            
+            if (![spooledString appendString:string error:&error]) {
+                [self failWithError:error];
+                break;
+            }
+            [buffer appendString:string];
+            
+            NSUInteger parsedLength = [self parseTemplateString:buffer tokenTemplateString:spooledString offset:offset templateID:templateID line:&line final:final];
+            if (parsedLength == NSNotFound) {
+                break;
+            }
+            [buffer deleteCharactersInRange:NSMakeRange(0, parsedLength)];
+            offset += parsedLength;
+        }
+    }
+    [stream close];
+    free(chunk);
+}
+
+- (NSUInteger)parseTemplateString:(NSString *)templateString tokenTemplateString:(NSString *)tokenTemplateString offset:(NSUInteger)offset templateID:(id)templateID line:(NSUInteger *)ioLine final:(BOOL)final
+{
+    NSUInteger p = 0;
+    NSUInteger line = *ioLine;
     NSUInteger consumedLines = 0;
     NSRange orange;
     NSRange crange;
@@ -150,34 +291,44 @@
         
         // tagStartDelimiter was not found
         if (orange.location == NSNotFound) {
-            if (p < templateString.length) {
-                [self shouldContinueAfterParsingToken:[GRMustacheToken tokenWithType:GRMustacheTokenTypeText
-                                                                      templateString:templateString
-                                                                          templateID:templateID
-                                                                                line:line
-                                                                               range:NSMakeRange(p, templateString.length-p)
-                                                                                text:[templateString substringFromIndex:p]
-                                                                          expression:nil
-                                                                   invalidExpression:NO
-                                                                         partialName:nil
-                                                                              pragma:nil]];
+            // Unless final, keep the characters that may be the beginning of
+            // tagStartDelimiter.
+            NSUInteger end = templateString.length;
+            if (!final) {
+                end = MAX(p, end - MIN(end, _tagStartDelimiter.length - 1));
+            }
+            if (p < end) {
+                NSRange range = NSMakeRange(p, end-p);
+                if (![self shouldContinueAfterParsingToken:[GRMustacheToken tokenWithType:GRMustacheTokenTypeText
+                                                                           templateString:tokenTemplateString
+                                                                               templateID:templateID
+                                                                                     line:line
+                                                                                    range:NSMakeRange(offset + range.location, range.length)
+                                                                                     text:[templateString substringWithRange:range]
+                                                                               expression:nil
+                                                                        invalidExpression:NO
+                                                                              partialName:nil
+                                                                                   pragma:nil]]) {
+                    return NSNotFound;
+                }
             }
-            return;
+            *ioLine = line + consumedLines;
+            return end;
         }
         
         if (orange.location > p) {
             NSRange range = NSMakeRange(p, orange.location-p);
             if (![self shouldContinueAfterParsingToken:[GRMustacheToken tokenWithType:GRMustacheTokenTypeText
-                                                                       templateString:templateString
+                                                                       templateString:tokenTemplateString
                                                                            templateID:templateID
                                                                                  line:line
-                                                                                range:range
+                                                                                range:NSMakeRange(offset + range.location, range.length)
                                                                                  text:[templateString substringWithRange:range]
                                                                            expression:nil
                                                                     invalidExpression:NO
                                                                           partialName:nil
                                                                                pragma:nil]]) {
-                return;
+                return NSNotFound;
             }
         }
         
@@ -185,6 +336,13 @@
         p = orange.location + orange.length;
         line += consumedLines;
         
+        // Unless final, wait for the character that tells if the tag is a
+        // triple mustache tag.
+        if (!final && p == templateString.length) {
+            *ioLine = line;
+            return orange.location;
+        }
+        
         // look for close tag
         if (p < templateString.length && [templateString characterAtIndex:p] == '{') {
             crange = [self rangeOfString:[@"}" stringByAppendingString:_tagEndDelimiter] inTemplateString:templateString startingAtIndex:p consumedNewLines:&consumedLines];
@@ -194,8 +352,13 @@
         
         // tagEndDelimiter was not found
         if (crange.location == NSNotFound) {
+            if (!final) {
+                // Wait for the end of the tag
+                *ioLine = line;
+                return orange.location;
+            }
             [self failWithParseErrorAtLine:line description:@"Unclosed Mustache tag" templateID:templateID];
-            return;
+            return NSNotFound;
         }
         
         // extract tag
@@ -204,24 +367,24 @@
         // empty tag is not allowed
         if (tag.length == 0) {
             [self failWithParseErrorAtLine:line description:@"Empty Mustache tag" templateID:templateID];
-            return;
+            return NSNotFound;
         }
         
         // tag must not contain tagStartDelimiter
         if ([tag rangeOfString:_tagStartDelimiter].location != NSNotFound) {
             [self failWithParseErrorAtLine:line description:@"Unclosed Mustache tag" templateID:templateID];
-            return;
+            return NSNotFound;
         }
         
         // interpret tag
         character = [tag characterAtIndex: 0];
         tokenType = (character < tokenTypeForCharacterLength) ? tokenTypeForCharacter[character] : GRMustacheTokenTypeEscapedVariable;
-        tokenRange = NSMakeRange(orange.location, crange.location + crange.length - orange.location);
+        tokenRange = NSMakeRange(offset + orange.location, crange.location + crange.length - orange.location);
         GRMustacheToken *token = nil;
         switch (tokenType) {
             case GRMustacheTokenTypeComment:
                 token = [GRMustacheToken tokenWithType:GRMustacheTokenTypeComment
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -236,7 +399,7 @@
                 BOOL invalid;
                 GRMustacheExpression * expression = [GRMustacheParser parseExpression:tag invalid:&invalid];
                 token = [GRMustacheToken tokenWithType:GRMustacheTokenTypeEscapedVariable
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -255,7 +418,7 @@
                 BOOL invalid;
                 GRMustacheExpression * expression = [GRMustacheParser parseExpression:[tag substringFromIndex:1] invalid:&invalid];   // strip initial '#', '^' etc.
                 token = [GRMustacheToken tokenWithType:tokenType
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -275,7 +438,7 @@
                 NSString *templateName = [self parseTemplateName:[tag substringFromIndex:1]];   // strip initial '/'
                 
                 token = [GRMustacheToken tokenWithType:tokenType
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -291,7 +454,7 @@
             case GRMustacheTokenTypeOverridablePartial: {
                 NSString *templateName = [self parseTemplateName:[tag substringFromIndex:1]];   // strip initial '>'
                 token = [GRMustacheToken tokenWithType:tokenType
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -305,7 +468,7 @@
             case GRMustacheTokenTypeSetDelimiter: {
                 if ([tag characterAtIndex:tag.length-1] != '=') {
                     [self failWithParseErrorAtLine:line description:@"Invalid set delimiter tag" templateID:templateID];
-                    return;
+                    return NSNotFound;
                 }
                 NSString *tokenContent = [[tag substringWithRange:NSMakeRange(1, tag.length-2)] stringByTrimmingCharactersInSet:whitespaceCharacterSet];
                 NSArray *newTags = [tokenContent componentsSeparatedByCharactersInSet:whitespaceCharacterSet];
@@ -320,10 +483,10 @@
                     self.tagEndDelimiter = [nonBlankNewTags objectAtIndex:1];
                 } else {
                     [self failWithParseErrorAtLine:line description:@"Invalid set delimiter tag" templateID:templateID];
-                    return;
+                    return NSNotFound;
                 }
                 token = [GRMustacheToken tokenWithType:GRMustacheTokenTypeSetDelimiter
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -338,14 +501,14 @@
                 NSString *pragma = [self parsePragma:[tag substringFromIndex:1]];   // strip initial '>'
                 if (pragma == nil) {
                     [self failWithParseErrorAtLine:line description:@"Invalid pragma" templateID:templateID];
-                    return;
+                    return NSNotFound;
                 }
                 if (_pragmas == nil) {
                     self.pragmas = [NSMutableSet set];
                 }
                 [self.pragmas addObject:pragma];
                 token = [GRMustacheToken tokenWithType:GRMustacheTokenTypePragma
-                                        templateString:templateString
+                                        templateString:tokenTemplateString
                                             templateID:templateID
                                                   line:line
                                                  range:tokenRange
@@ -363,7 +526,7 @@
 
         NSAssert(token, @"WTF");
         if (![self shouldContinueAfterParsingToken:token]) {
-            return;
+            return NSNotFound;
         }
 
         // update our cursors
@@ -906,6 +1069,13 @@
     return YES;
 }
 
+- (void)failWithError:(NSError *)error
+{
+    if ([_delegate respondsToSelector:@selector(parser:didFailWithError:)]) {
+        [_delegate parser:self didFailWithError:error];
+    }
+}
+
 - (void)failWithParseErrorAtLine:(NSInteger)line description:(NSString *)description templateID:(id)templateID
 {
     if ([_delegate respondsToSelector:@selector(parser:didFailWithError:)]) {
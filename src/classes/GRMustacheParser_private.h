@@ -83,6 +83,7 @@
     NSString *_tagStartDelimiter;
     NSString *_tagEndDelimiter;
     NSMutableSet *_pragmas;
+    NSUInteger _streamChunkLength;
 }
 
 /**
@@ -119,6 +120,45 @@
  */
 - (void)parseTemplateString:(NSString *)templateString templateID:(id)templateID GRMUSTACHE_API_INTERNAL;
 
+/**
+ * The parser will invoke its delegate as it builds tokens from the template
+ * string.
+ *
+ * The template string of tokens is tokenTemplateString, a string that has the
+ * same characters as templateString, but may not keep them in memory.
+ *
+ * @param templateString       A Mustache template string
+ * @param tokenTemplateString  The template string of tokens
+ * @param templateID           A template ID (see GRMustacheTemplateRepository)
+ *
+ * @see GRMustacheRefetchableString
+ */
+- (void)parseTemplateString:(NSString *)templateString tokenTemplateString:(NSString *)tokenTemplateString templateID:(id)templateID GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The maximum number of bytes read at once by
+ * parseTemplateStream:encoding:templateID:. The default value is 64 KB.
+ */
+@property (nonatomic) NSUInteger streamChunkLength GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The parser will invoke its delegate as it builds tokens from a template
+ * stream, read in chunks.
+ *
+ * Tags and set delimiter tags that span several chunks are supported. The
+ * characters are spooled into a temporary file, which is the template string of
+ * tokens (see GRMustacheSpooledString): the template is never loaded in memory
+ * as a whole.
+ *
+ * Errors reading or decoding the stream are reported to the delegate.
+ *
+ * @param stream      An input stream, that is opened and closed by this
+ *                    method.
+ * @param encoding    The encoding of the stream.
+ * @param templateID  A template ID (see GRMustacheTemplateRepository)
+ */
+- (void)parseTemplateStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding templateID:(id)templateID GRMUSTACHE_API_INTERNAL;
+
 /**
  * Returns an expression from a string.
  *
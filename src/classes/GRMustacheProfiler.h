@@ -0,0 +1,123 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+/**
+ * The GRMustacheProfiler class measures where rendering time goes.
+ *
+ * Once attached to a rendering context with
+ * [GRMustacheContext contextByAddingProfiler:], a profiler records the wall
+ * time and the memory allocations spent rendering each Mustache tag and each
+ * template or partial template.
+ *
+ * Tags are identified by the template ID and the line of the tag in its
+ * template. Templates are identified by their template ID.
+ *
+ * Measures accumulate across renderings, until the reset method is called.
+ *
+ * A profiler is not thread-safe: do not render the same profiled context from
+ * several threads at the same time.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/profiling.md
+ *
+ * @see GRMustacheContext
+ *
+ * @since v6.5
+ */
+@interface GRMustacheProfiler : NSObject {
+@private
+    id _rootFrame;
+    id _currentFrame;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Creating Profilers
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns a new profiler.
+ *
+ * While at least one profiler is alive, a process-wide allocation counter is
+ * installed. It is removed when the last profiler is deallocated. Allocations
+ * are only counted when GRMustache is compiled with the
+ * GRMUSTACHE_COUNT_ALLOCATIONS preprocessor macro.
+ *
+ * @return A new profiler.
+ *
+ * @since v6.5
+ */
++ (instancetype)profiler AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Reading Measures
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns a human-readable report, with one line per tag and per template,
+ * sorted by decreasing self time.
+ *
+ * The self time of a tag or template is the time spent rendering it, minus the
+ * time spent rendering its inner tags and partials.
+ *
+ * @return A report string.
+ *
+ * @since v6.5
+ */
+- (NSString *)report AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns the measures in the "collapsed stacks" format of Brendan Gregg's
+ * FlameGraph tools (https://github.com/brendangregg/FlameGraph): each line
+ * contains a semicolon-separated rendering stack, followed by the self time
+ * spent in this stack, in microseconds.
+ *
+ * Write this string to a file, and run `flamegraph.pl` on it in order to get
+ * an SVG flame graph.
+ *
+ * @return A collapsed stacks string.
+ *
+ * @since v6.5
+ */
+- (NSString *)collapsedStacks AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Resetting Measures
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Forgets all measures.
+ *
+ * This method must not be called during a rendering.
+ *
+ * @since v6.5
+ */
+- (void)reset AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
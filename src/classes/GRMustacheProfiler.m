@@ -0,0 +1,328 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheProfiler_private.h"
+#import "GRMustacheInstrumentation_private.h"
+#import "GRMustacheTag_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheExpression_private.h"
+#import "GRMustacheToken_private.h"
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheProfilerFrame
+
+/**
+ * A node in the tree of rendering stacks.
+ *
+ * There is one frame per distinct stack of rendered tags and templates. Child
+ * frames are looked up by component identity, so that recording a measure
+ * does not allocate any memory once the frame exists.
+ */
+@interface GRMustacheProfilerFrame : NSObject {
+@private
+    GRMustacheProfilerFrame *_parent;
+    NSString *_name;
+    NSMapTable *_childForComponent;
+    NSUInteger _calls;
+    uint64_t _nanoseconds;
+    uint64_t _childrenNanoseconds;
+    uint64_t _allocationCount;
+    uint64_t _childrenAllocationCount;
+    uint64_t _startNanoseconds;
+    uint64_t _startAllocationCount;
+}
+@property (nonatomic, assign, readonly) GRMustacheProfilerFrame *parent;
+@property (nonatomic, retain, readonly) NSString *name;
+@property (nonatomic, readonly) NSUInteger calls;
+@property (nonatomic, readonly) uint64_t nanoseconds;
+@property (nonatomic, readonly) uint64_t selfNanoseconds;
+@property (nonatomic, readonly) uint64_t allocationCount;
+@property (nonatomic, readonly) uint64_t selfAllocationCount;
+- (id)initWithParent:(GRMustacheProfilerFrame *)parent name:(NSString *)name;
+- (GRMustacheProfilerFrame *)childForComponent:(id)component;
+- (GRMustacheProfilerFrame *)addChildForComponent:(id)component name:(NSString *)name;
+- (NSArray *)children;
+- (void)begin;
+- (void)end;
+@end
+
+@implementation GRMustacheProfilerFrame
+@synthesize parent=_parent;
+@synthesize name=_name;
+@synthesize calls=_calls;
+@synthesize nanoseconds=_nanoseconds;
+@synthesize allocationCount=_allocationCount;
+
+- (void)dealloc
+{
+    [_name release];
+    [_childForComponent release];
+    [super dealloc];
+}
+
+- (id)initWithParent:(GRMustacheProfilerFrame *)parent name:(NSString *)name
+{
+    self = [super init];
+    if (self) {
+        _parent = parent;   // do not retain, since parent retains self.
+        _name = [name retain];
+    }
+    return self;
+}
+
+- (GRMustacheProfilerFrame *)childForComponent:(id)component
+{
+    return [_childForComponent objectForKey:component];
+}
+
+- (GRMustacheProfilerFrame *)addChildForComponent:(id)component name:(NSString *)name
+{
+    if (_childForComponent == nil) {
+        // Components are retained, so that their address can not be reused
+        // by another component while the profiler is alive.
+        _childForComponent = [[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                       valueOptions:NSPointerFunctionsStrongMemory
+                                                           capacity:0];
+    }
+    GRMustacheProfilerFrame *child = [[[GRMustacheProfilerFrame alloc] initWithParent:self name:name] autorelease];
+    [_childForComponent setObject:child forKey:component];
+    return child;
+}
+
+- (NSArray *)children
+{
+    if (_childForComponent == nil) {
+        return [NSArray array];
+    }
+    return [[_childForComponent objectEnumerator] allObjects];
+}
+
+- (uint64_t)selfNanoseconds
+{
+    return (_nanoseconds > _childrenNanoseconds) ? (_nanoseconds - _childrenNanoseconds) : 0;
+}
+
+- (uint64_t)selfAllocationCount
+{
+    return (_allocationCount > _childrenAllocationCount) ? (_allocationCount - _childrenAllocationCount) : 0;
+}
+
+- (void)begin
+{
+    _startAllocationCount = GRMustacheInstrumentationAllocationStats().count;
+    _startNanoseconds = GRMustacheInstrumentationNanoseconds();
+}
+
+- (void)end
+{
+    uint64_t nanoseconds = GRMustacheInstrumentationNanoseconds() - _startNanoseconds;
+    uint64_t allocationCount = GRMustacheInstrumentationAllocationStats().count - _startAllocationCount;
+    
+    _calls += 1;
+    _nanoseconds += nanoseconds;
+    _allocationCount += allocationCount;
+    
+    _parent->_childrenNanoseconds += nanoseconds;
+    _parent->_childrenAllocationCount += allocationCount;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheProfiler
+
+@interface GRMustacheProfiler()
++ (NSString *)frameNameForTag:(GRMustacheTag *)tag;
++ (NSString *)frameNameForTemplate:(GRMustacheTemplate *)template;
+- (void)beginFrame:(GRMustacheProfilerFrame *)frame;
+@end
+
+@implementation GRMustacheProfiler
+
++ (instancetype)profiler
+{
+    return [[[self alloc] init] autorelease];
+}
+
+- (void)dealloc
+{
+    GRMustacheInstrumentationStopCountingAllocations();
+    [_rootFrame release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        // Balanced in dealloc: allocations are counted as long as a profiler
+        // is alive.
+        GRMustacheInstrumentationStartCountingAllocations();
+        _rootFrame = [[GRMustacheProfilerFrame alloc] initWithParent:nil name:nil];
+        _currentFrame = _rootFrame;
+    }
+    return self;
+}
+
+- (void)reset
+{
+    [_rootFrame release];
+    _rootFrame = [[GRMustacheProfilerFrame alloc] initWithParent:nil name:nil];
+    _currentFrame = _rootFrame;
+}
+
+- (void)beginFrameForTag:(GRMustacheTag *)tag
+{
+    // Frame names are only built once per rendering stack.
+    GRMustacheProfilerFrame *frame = [_currentFrame childForComponent:tag];
+    if (frame == nil) {
+        frame = [_currentFrame addChildForComponent:tag name:[GRMustacheProfiler frameNameForTag:tag]];
+    }
+    [self beginFrame:frame];
+}
+
+- (void)beginFrameForTemplate:(GRMustacheTemplate *)template
+{
+    GRMustacheProfilerFrame *frame = [_currentFrame childForComponent:template];
+    if (frame == nil) {
+        frame = [_currentFrame addChildForComponent:template name:[GRMustacheProfiler frameNameForTemplate:template]];
+    }
+    [self beginFrame:frame];
+}
+
+- (void)endFrame
+{
+    NSAssert(_currentFrame != _rootFrame, @"Unbalanced endFrame");
+    [_currentFrame end];
+    _currentFrame = _currentFrame.parent;
+}
+
+- (NSString *)report
+{
+    // Merge frames that share a name, whatever their stack.
+    
+    NSMutableDictionary *linesByName = [NSMutableDictionary dictionary];
+    NSMutableArray *frames = [NSMutableArray arrayWithArray:[_rootFrame children]];
+    while (frames.count > 0) {
+        GRMustacheProfilerFrame *frame = [frames lastObject];
+        [frames removeLastObject];
+        [frames addObjectsFromArray:[frame children]];
+        
+        NSMutableDictionary *line = [linesByName objectForKey:frame.name];
+        if (line == nil) {
+            line = [NSMutableDictionary dictionaryWithObject:frame.name forKey:@"name"];
+            [linesByName setObject:line forKey:frame.name];
+        }
+        [line setObject:[NSNumber numberWithUnsignedLongLong:[[line objectForKey:@"calls"] unsignedLongLongValue] + frame.calls] forKey:@"calls"];
+        [line setObject:[NSNumber numberWithUnsignedLongLong:[[line objectForKey:@"selfNanoseconds"] unsignedLongLongValue] + frame.selfNanoseconds] forKey:@"selfNanoseconds"];
+        [line setObject:[NSNumber numberWithUnsignedLongLong:[[line objectForKey:@"nanoseconds"] unsignedLongLongValue] + frame.nanoseconds] forKey:@"nanoseconds"];
+        [line setObject:[NSNumber numberWithUnsignedLongLong:[[line objectForKey:@"selfAllocationCount"] unsignedLongLongValue] + frame.selfAllocationCount] forKey:@"selfAllocationCount"];
+        [line setObject:[NSNumber numberWithUnsignedLongLong:[[line objectForKey:@"allocationCount"] unsignedLongLongValue] + frame.allocationCount] forKey:@"allocationCount"];
+    }
+    
+    NSArray *lines = [[linesByName allValues] sortedArrayUsingDescriptors:[NSArray arrayWithObjects:
+                                                                           [NSSortDescriptor sortDescriptorWithKey:@"selfNanoseconds" ascending:NO],
+                                                                           [NSSortDescriptor sortDescriptorWithKey:@"name" ascending:YES],
+                                                                           nil]];
+    
+    // Total times of recursive partials are counted once per recursion level.
+    
+    NSMutableString *report = [NSMutableString stringWithFormat:@"%12s %12s %8s %12s %12s  %@\n", "self (ms)", "total (ms)", "calls", "self allocs", "total allocs", @"tag or template"];
+    for (NSDictionary *line in lines) {
+        [report appendFormat:@"%12.3f %12.3f %8llu %12llu %12llu  %@\n",
+         [[line objectForKey:@"selfNanoseconds"] unsignedLongLongValue] / 1e6,
+         [[line objectForKey:@"nanoseconds"] unsignedLongLongValue] / 1e6,
+         [[line objectForKey:@"calls"] unsignedLongLongValue],
+         [[line objectForKey:@"selfAllocationCount"] unsignedLongLongValue],
+         [[line objectForKey:@"allocationCount"] unsignedLongLongValue],
+         [line objectForKey:@"name"]];
+    }
+    return report;
+}
+
+- (NSString *)collapsedStacks
+{
+    NSMutableArray *stackLines = [NSMutableArray array];
+    NSMutableArray *frames = [NSMutableArray arrayWithArray:[_rootFrame children]];
+    while (frames.count > 0) {
+        GRMustacheProfilerFrame *frame = [frames lastObject];
+        [frames removeLastObject];
+        [frames addObjectsFromArray:[frame children]];
+        
+        uint64_t microseconds = frame.selfNanoseconds / 1000;
+        if (microseconds == 0) {
+            continue;
+        }
+        
+        NSMutableArray *names = [NSMutableArray array];
+        for (GRMustacheProfilerFrame *f = frame; f != _rootFrame; f = f.parent) {
+            [names insertObject:f.name atIndex:0];
+        }
+        [stackLines addObject:[NSString stringWithFormat:@"%@ %llu", [names componentsJoinedByString:@";"], microseconds]];
+    }
+    
+    [stackLines sortUsingSelector:@selector(compare:)];
+    if (stackLines.count == 0) {
+        return @"";
+    }
+    return [[stackLines componentsJoinedByString:@"\n"] stringByAppendingString:@"\n"];
+}
+
+
+#pragma mark Private
+
++ (NSString *)frameNameForTag:(GRMustacheTag *)tag
+{
+    GRMustacheToken *token = tag.expression.token;
+    NSString *name;
+    if (token.templateID) {
+        name = [NSString stringWithFormat:@"%@ at %@:%lu", token.templateSubstring, token.templateID, (unsigned long)token.line];
+    } else {
+        name = [NSString stringWithFormat:@"%@ at line %lu", token.templateSubstring, (unsigned long)token.line];
+    }
+    
+    // Collapsed stacks are semicolon-separated, and newline-separated.
+    name = [name stringByReplacingOccurrencesOfString:@";" withString:@","];
+    name = [name stringByReplacingOccurrencesOfString:@"\n" withString:@" "];
+    return name;
+}
+
++ (NSString *)frameNameForTemplate:(GRMustacheTemplate *)template
+{
+    if (template.templateID == nil) {
+        return @"template";
+    }
+    NSString *name = [NSString stringWithFormat:@"template %@", template.templateID];
+    name = [name stringByReplacingOccurrencesOfString:@";" withString:@","];
+    name = [name stringByReplacingOccurrencesOfString:@"\n" withString:@" "];
+    return name;
+}
+
+- (void)beginFrame:(GRMustacheProfilerFrame *)frame
+{
+    [frame begin];
+    _currentFrame = frame;
+}
+
+@end
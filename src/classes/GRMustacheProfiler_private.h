@@ -0,0 +1,77 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+@class GRMustacheTag;
+@class GRMustacheTemplate;
+@class GRMustacheProfilerFrame;
+
+// Documented in GRMustacheProfiler.h
+@interface GRMustacheProfiler : NSObject {
+@private
+    GRMustacheProfilerFrame *_rootFrame;
+    GRMustacheProfilerFrame *_currentFrame;
+}
+
+// Documented in GRMustacheProfiler.h
++ (instancetype)profiler GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheProfiler.h
+- (NSString *)report GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheProfiler.h
+- (NSString *)collapsedStacks GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheProfiler.h
+- (void)reset GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Starts measuring the rendering of a tag.
+ *
+ * Each call to this method must be balanced with a call to endFrame.
+ *
+ * @param tag  The rendered tag.
+ *
+ * @see [GRMustacheTag renderContentType:inBuffer:withContext:error:]
+ */
+- (void)beginFrameForTag:(GRMustacheTag *)tag GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Starts measuring the rendering of a template, or a partial template.
+ *
+ * Each call to this method must be balanced with a call to endFrame.
+ *
+ * @param template  The rendered template.
+ *
+ * @see [GRMustacheTemplate renderContentType:inBuffer:withContext:error:]
+ */
+- (void)beginFrameForTemplate:(GRMustacheTemplate *)template GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Stops the measure started by the last call to beginFrameForTag: or
+ * beginFrameForTemplate:.
+ */
+- (void)endFrame GRMUSTACHE_API_INTERNAL;
+
+@end
@@ -0,0 +1,196 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheRefetchableString_private.h"
+#import "GRMustacheError.h"
+
+static uint64_t GRMustacheTemplateStringDigest(NSString *string);
+
+@interface GRMustacheRefetchableString()
+- (id)initWithTemplateString:(NSString *)templateString templateStringLoader:(GRMustacheTemplateStringLoader)templateStringLoader templateID:(id)templateID;
+- (NSString *)templateString;
+- (NSString *)fetchTemplateString;
+- (void)forgetTemplateString;
+@end
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheRefetchableStringBurst
+
+/**
+ * A GRMustacheRefetchableStringBurst has a refetchable string forget its
+ * fetched template string when it is deallocated, that is to say when the
+ * autorelease pool it lives in is drained.
+ */
+@interface GRMustacheRefetchableStringBurst : NSObject {
+@private
+    GRMustacheRefetchableString *_string;
+}
+- (id)initWithString:(GRMustacheRefetchableString *)string;
+@end
+
+@implementation GRMustacheRefetchableStringBurst
+
+- (void)dealloc
+{
+    [_string forgetTemplateString];
+    [_string release];
+    [super dealloc];
+}
+
+- (id)initWithString:(GRMustacheRefetchableString *)string
+{
+    self = [super init];
+    if (self) {
+        _string = [string retain];
+    }
+    return self;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheRefetchableString
+
+@implementation GRMustacheRefetchableString
+
++ (instancetype)stringWithTemplateString:(NSString *)templateString templateStringLoader:(GRMustacheTemplateStringLoader)templateStringLoader templateID:(id)templateID
+{
+    return [[[self alloc] initWithTemplateString:templateString templateStringLoader:templateStringLoader templateID:templateID] autorelease];
+}
+
+- (void)dealloc
+{
+    [_templateStringLoader release];
+    [_templateID release];
+    [_templateString release];
+    [super dealloc];
+}
+
+- (id)initWithTemplateString:(NSString *)templateString templateStringLoader:(GRMustacheTemplateStringLoader)templateStringLoader templateID:(id)templateID
+{
+    self = [super init];
+    if (self) {
+        _templateStringLoader = [templateStringLoader copy];
+        _templateID = [templateID retain];
+        _length = templateString.length;
+        _digest = GRMustacheTemplateStringDigest(templateString);
+    }
+    return self;
+}
+
+
+#pragma mark - NSString
+
+- (NSUInteger)length
+{
+    return _length;
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+    unichar character;
+    [self getCharacters:&character range:NSMakeRange(index, 1)];
+    return character;
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+    if (NSMaxRange(range) > _length) {
+        [NSException raise:NSRangeException format:@"Range %@ out of bounds", NSStringFromRange(range)];
+    }
+    
+    [[self templateString] getCharacters:buffer range:range];
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return [self retain];
+}
+
+
+#pragma mark - Private
+
+- (NSString *)templateString
+{
+    @synchronized(self) {
+        if (_templateString == nil) {
+            _templateString = [[self fetchTemplateString] retain];
+            if (_templateString) {
+                [[[GRMustacheRefetchableStringBurst alloc] initWithString:self] autorelease];
+            }
+        }
+        return [[_templateString retain] autorelease];
+    }
+}
+
+- (void)forgetTemplateString
+{
+    @synchronized(self) {
+        [_templateString release];
+        _templateString = nil;
+    }
+}
+
+- (NSString *)fetchTemplateString
+{
+    NSError *error = nil;
+    NSString *templateString = _templateStringLoader(&error);
+    if (templateString == nil) {
+        [NSException raise:GRMustacheRenderingException format:@"Template %@ could not be loaded again: %@", _templateID, error.localizedDescription];
+    }
+    if (templateString.length != _length || GRMustacheTemplateStringDigest(templateString) != _digest) {
+        [NSException raise:GRMustacheRenderingException format:@"Template %@ has changed since it was loaded", _templateID];
+    }
+    return templateString;
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - Template string digest
+
+/**
+ * Returns the 64-bit FNV-1a hash of the UTF-16 characters of _string_.
+ *
+ * Unlike -[NSString hash], which only looks at a few characters of long
+ * strings, all characters are hashed, so that an edit that preserves the
+ * length of a template string is noticed.
+ */
+static uint64_t GRMustacheTemplateStringDigest(NSString *string)
+{
+    uint64_t digest = 14695981039346656037ULL;
+    NSUInteger length = string.length;
+    unichar characters[1024];
+    for (NSUInteger location = 0; location < length; location += 1024) {
+        NSRange range = NSMakeRange(location, MIN((NSUInteger)1024, length - location));
+        [string getCharacters:characters range:range];
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            digest = (digest ^ (characters[i] & 0xFF)) * 1099511628211ULL;
+            digest = (digest ^ (characters[i] >> 8)) * 1099511628211ULL;
+        }
+    }
+    return digest;
+}
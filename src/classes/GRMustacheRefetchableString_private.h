@@ -0,0 +1,81 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * A block that loads a template string again, without referring to the
+ * template repository that has loaded it first, since templates may outlive
+ * their repository.
+ *
+ * @param error  If there is an error loading the template string, upon return
+ *               contains an NSError object that describes the problem.
+ *
+ * @return A template string.
+ *
+ * @see [GRMustacheTemplateRepository templateStringLoaderForTemplateID:]
+ */
+typedef NSString *(^GRMustacheTemplateStringLoader)(NSError **error);
+
+/**
+ * A GRMustacheRefetchableString stands for the template string of a template
+ * loaded by name, without retaining it. Its characters are fetched again with
+ * a template string loader when they are needed: when a tag describes itself,
+ * or when the innerTemplateString of a section tag is required.
+ *
+ * The fetched template string is kept until the current autorelease pool is
+ * drained, so that a burst of accesses, such as the copy of a substring, loads
+ * it only once.
+ *
+ * Tokens and section tags refer to such a string when the configuration of the
+ * repository does not retain template strings.
+ *
+ * The loader must keep on returning the same template string: the fetched
+ * string is checked against the length and a digest of the original template
+ * string. When the template string can not be fetched again, or has changed,
+ * a GRMustacheRenderingException is raised.
+ *
+ * @see [GRMustacheConfiguration retainsTemplateStrings]
+ */
+@interface GRMustacheRefetchableString : NSString {
+@private
+    GRMustacheTemplateStringLoader _templateStringLoader;
+    id _templateID;
+    NSUInteger _length;
+    uint64_t _digest;
+    NSString *_templateString;
+}
+
+/**
+ * Returns a string that fetches the characters of _templateString_ with a
+ * template string loader.
+ *
+ * @param templateString        The template string, which is not retained.
+ * @param templateStringLoader  A block that loads the template string again.
+ * @param templateID            The ID of the template, used in error messages.
+ *
+ * @return A string.
+ */
++ (instancetype)stringWithTemplateString:(NSString *)templateString templateStringLoader:(GRMustacheTemplateStringLoader)templateStringLoader templateID:(id)templateID GRMUSTACHE_API_INTERNAL;
+
+@end
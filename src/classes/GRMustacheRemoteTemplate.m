@@ -0,0 +1,139 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheRemoteTemplate_private.h"
+#import "GRMustacheMappedString_private.h"
+
+/**
+ * Returns the value of an HTTP header, regardless of the case of its name.
+ */
+static NSString *GRMustacheHTTPHeaderValue(NSHTTPURLResponse *response, NSString *name)
+{
+    NSDictionary *headers = response.allHeaderFields;
+    for (NSString *key in headers) {
+        if ([key caseInsensitiveCompare:name] == NSOrderedSame) {
+            return [headers objectForKey:key];
+        }
+    }
+    return nil;
+}
+
+@interface GRMustacheRemoteTemplate()
+- (id)initWithURL:(NSURL *)URL templateString:(NSString *)templateString entityTag:(NSString *)entityTag lastModified:(NSString *)lastModified partialURLs:(NSArray *)partialURLs;
+@end
+
+@implementation GRMustacheRemoteTemplate
+@synthesize URL=_URL;
+@synthesize templateString=_templateString;
+@synthesize entityTag=_entityTag;
+@synthesize lastModified=_lastModified;
+
++ (GRMustacheRemoteTemplate *)remoteTemplateWithURL:(NSURL *)URL encoding:(NSStringEncoding)encoding cachedTemplate:(GRMustacheRemoteTemplate *)cachedTemplate error:(NSError **)error
+{
+    // We handle validators ourselves: don't let the URL loading system answer
+    // from its own cache.
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:URL cachePolicy:NSURLRequestReloadIgnoringLocalCacheData timeoutInterval:60];
+    if (cachedTemplate.entityTag) {
+        [request setValue:cachedTemplate.entityTag forHTTPHeaderField:@"If-None-Match"];
+    }
+    if (cachedTemplate.lastModified) {
+        [request setValue:cachedTemplate.lastModified forHTTPHeaderField:@"If-Modified-Since"];
+    }
+    
+    NSURLResponse *response = nil;
+    NSData *data = [NSURLConnection sendSynchronousRequest:request returningResponse:&response error:error];
+    if (!data) {
+        return nil;
+    }
+    
+    NSString *entityTag = nil;
+    NSString *lastModified = nil;
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        NSHTTPURLResponse *HTTPResponse = (NSHTTPURLResponse *)response;
+        NSInteger statusCode = HTTPResponse.statusCode;
+        if (statusCode == 304 && cachedTemplate) {
+            return cachedTemplate;
+        }
+        if (statusCode == 404 || statusCode == 410) {
+            if (error != NULL) {
+                *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadNoSuchFileError userInfo:[NSDictionary dictionaryWithObject:URL forKey:NSURLErrorKey]];
+            }
+            return nil;
+        }
+        if (statusCode < 200 || statusCode >= 300) {
+            if (error != NULL) {
+                *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadServerResponse userInfo:[NSDictionary dictionaryWithObjectsAndKeys:
+                                                                                                             URL, NSURLErrorKey,
+                                                                                                             [NSString stringWithFormat:@"HTTP status %ld for %@", (long)statusCode, URL], NSLocalizedDescriptionKey,
+                                                                                                             nil]];
+            }
+            return nil;
+        }
+        entityTag = GRMustacheHTTPHeaderValue(HTTPResponse, @"ETag");
+        lastModified = GRMustacheHTTPHeaderValue(HTTPResponse, @"Last-Modified");
+    }
+    
+    NSString *templateString = [GRMustacheMappedString stringWithData:data range:NSMakeRange(0, data.length) encoding:encoding error:error];
+    if (!templateString) {
+        return nil;
+    }
+    return [[[self alloc] initWithURL:URL templateString:templateString entityTag:entityTag lastModified:lastModified partialURLs:cachedTemplate.partialURLs] autorelease];
+}
+
+- (void)dealloc
+{
+    [_URL release];
+    [_templateString release];
+    [_entityTag release];
+    [_lastModified release];
+    [_partialURLs release];
+    [super dealloc];
+}
+
+- (id)initWithURL:(NSURL *)URL templateString:(NSString *)templateString entityTag:(NSString *)entityTag lastModified:(NSString *)lastModified partialURLs:(NSArray *)partialURLs
+{
+    self = [super init];
+    if (self) {
+        _URL = [URL retain];
+        _templateString = [templateString retain];
+        _entityTag = [entityTag retain];
+        _lastModified = [lastModified retain];
+        _partialURLs = [[NSMutableSet alloc] initWithArray:(partialURLs ?: [NSArray array])];
+    }
+    return self;
+}
+
+- (NSArray *)partialURLs
+{
+    @synchronized(self) {
+        return [_partialURLs allObjects];
+    }
+}
+
+- (void)addPartialURL:(NSURL *)URL
+{
+    @synchronized(self) {
+        [_partialURLs addObject:URL];
+    }
+}
+
+@end
@@ -0,0 +1,108 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * A GRMustacheRemoteTemplate is the template string of a template loaded from
+ * a remote URL, along with the HTTP validators that allow conditional
+ * requests.
+ *
+ * Remote templates are stored in template caches, so that template
+ * repositories that share a template cache revalidate remote templates instead
+ * of downloading them again.
+ *
+ * @see GRMustacheTemplateCache
+ */
+@interface GRMustacheRemoteTemplate : NSObject {
+@private
+    NSURL *_URL;
+    NSString *_templateString;
+    NSString *_entityTag;
+    NSString *_lastModified;
+    NSMutableSet *_partialURLs;
+}
+
+/**
+ * The URL of the template.
+ */
+@property (nonatomic, retain, readonly) NSURL *URL GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The template string.
+ */
+@property (nonatomic, retain, readonly) NSString *templateString GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The ETag HTTP header of the response, or nil.
+ */
+@property (nonatomic, retain, readonly) NSString *entityTag GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The Last-Modified HTTP header of the response, or nil.
+ */
+@property (nonatomic, retain, readonly) NSString *lastModified GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The URLs of the partials loaded by the template, so far.
+ *
+ * @see addPartialURL:
+ */
+@property (nonatomic, readonly) NSArray *partialURLs GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Loads a remote template.
+ *
+ * When cachedTemplate is not nil, the request is conditional. If the server
+ * responds that the template has not changed, cachedTemplate is returned.
+ * Otherwise, a new remote template is returned, that inherits the partial URLs
+ * of cachedTemplate.
+ *
+ * This method is thread-safe.
+ *
+ * @param URL             The URL of the template.
+ * @param encoding        The encoding of the template, if it does not start
+ *                        with a byte order mark.
+ * @param cachedTemplate  The remote template previously loaded from URL, or
+ *                        nil.
+ * @param error           If there is an error loading the template, upon
+ *                        return contains an NSError object that describes the
+ *                        problem. Missing templates (HTTP status 404 and 410)
+ *                        are described by an error of domain
+ *                        NSCocoaErrorDomain and code NSFileReadNoSuchFileError.
+ *
+ * @return A remote template, or nil.
+ */
++ (GRMustacheRemoteTemplate *)remoteTemplateWithURL:(NSURL *)URL encoding:(NSStringEncoding)encoding cachedTemplate:(GRMustacheRemoteTemplate *)cachedTemplate error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Records the URL of a partial loaded by the template, so that it can be
+ * revalidated along with the template.
+ *
+ * This method is thread-safe.
+ *
+ * @param URL  The URL of a partial template.
+ */
+- (void)addPartialURL:(NSURL *)URL GRMUSTACHE_API_INTERNAL;
+
+@end
@@ -0,0 +1,178 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheConfiguration_private.h"
+#import "GRMustacheInstrumentation_private.h"
+#import "GRMustacheError.h"
+
+@interface GRMustacheRenderingBudget()
+- (id)initWithConfiguration:(GRMustacheConfiguration *)configuration;
+@end
+
+@implementation GRMustacheRenderingBudget
+@synthesize maximumRenderedLength=_maximumRenderedLength;
+@synthesize maximumDuration=_maximumDuration;
+@synthesize maximumPartialDepth=_maximumPartialDepth;
+@synthesize maximumIterationCount=_maximumIterationCount;
+
++ (instancetype)renderingBudgetWithConfiguration:(GRMustacheConfiguration *)configuration
+{
+    if (configuration.maximumRenderedLength == 0 &&
+        configuration.maximumRenderingDuration <= 0 &&
+        configuration.maximumPartialDepth == 0 &&
+        configuration.maximumIterationCount == 0)
+    {
+        return nil;
+    }
+    return [[[self alloc] initWithConfiguration:configuration] autorelease];
+}
+
+- (id)initWithConfiguration:(GRMustacheConfiguration *)configuration
+{
+    self = [super init];
+    if (self) {
+        _maximumRenderedLength = configuration.maximumRenderedLength;
+        _maximumDuration = (configuration.maximumRenderingDuration > 0) ? MAX((uint64_t)(configuration.maximumRenderingDuration * NSEC_PER_SEC), 1) : 0;
+        _maximumPartialDepth = configuration.maximumPartialDepth;
+        _maximumIterationCount = configuration.maximumIterationCount;
+    }
+    return self;
+}
+
+@end
+
+
+@interface GRMustacheRenderingSession()
+- (id)initWithBudget:(GRMustacheRenderingBudget *)budget;
+- (BOOL)checkDeadlineWithError:(NSError **)error;
+- (BOOL)failWithDescription:(NSString *)description error:(NSError **)error;
+@end
+
+@implementation GRMustacheRenderingSession
+@synthesize renderedLength=_renderedLength;
+
++ (instancetype)renderingSessionWithBudget:(GRMustacheRenderingBudget *)budget
+{
+    return [[[self alloc] initWithBudget:budget] autorelease];
+}
+
+- (void)dealloc
+{
+    [_budget release];
+    [_error release];
+    [super dealloc];
+}
+
+- (id)initWithBudget:(GRMustacheRenderingBudget *)budget
+{
+    self = [super init];
+    if (self) {
+        _budget = [budget retain];
+        if (budget.maximumDuration > 0) {
+            _deadline = GRMustacheInstrumentationNanoseconds() + budget.maximumDuration;
+        }
+    }
+    return self;
+}
+
+- (BOOL)enterTemplateWithError:(NSError **)error
+{
+    if (_error) {
+        return [self failWithDescription:nil error:error];
+    }
+    
+    // The rendered template has depth 0, its partials depth 1, etc.
+    NSUInteger maximumPartialDepth = _budget.maximumPartialDepth;
+    if (maximumPartialDepth > 0 && _templateDepth > maximumPartialDepth) {
+        return [self failWithDescription:[NSString stringWithFormat:@"Rendering aborted: partials are nested more than %lu levels deep", (unsigned long)maximumPartialDepth] error:error];
+    }
+    
+    if (![self checkDeadlineWithError:error]) {
+        return NO;
+    }
+    
+    _templateDepth += 1;
+    return YES;
+}
+
+- (void)exitTemplate
+{
+    NSAssert(_templateDepth > 0, @"Unbalanced exitTemplate");
+    _templateDepth -= 1;
+}
+
+- (BOOL)beginIterationWithError:(NSError **)error
+{
+    if (_error) {
+        return [self failWithDescription:nil error:error];
+    }
+    
+    NSUInteger maximumIterationCount = _budget.maximumIterationCount;
+    if (maximumIterationCount > 0 && ++_iterationCount > maximumIterationCount) {
+        return [self failWithDescription:[NSString stringWithFormat:@"Rendering aborted: sections are rendered more than %lu times", (unsigned long)maximumIterationCount] error:error];
+    }
+    
+    return [self checkDeadlineWithError:error];
+}
+
+- (BOOL)addRenderedLength:(NSUInteger)length error:(NSError **)error
+{
+    if (_error) {
+        return [self failWithDescription:nil error:error];
+    }
+    
+    NSUInteger maximumRenderedLength = _budget.maximumRenderedLength;
+    if (maximumRenderedLength > 0) {
+        // _renderedLength never exceeds maximumRenderedLength here.
+        if (length > maximumRenderedLength - _renderedLength) {
+            return [self failWithDescription:[NSString stringWithFormat:@"Rendering aborted: rendering is longer than %lu characters", (unsigned long)maximumRenderedLength] error:error];
+        }
+        _renderedLength += length;
+    }
+    
+    return YES;
+}
+
+
+#pragma mark - Private
+
+- (BOOL)checkDeadlineWithError:(NSError **)error
+{
+    if (_deadline > 0 && GRMustacheInstrumentationNanoseconds() > _deadline) {
+        return [self failWithDescription:[NSString stringWithFormat:@"Rendering aborted: rendering lasts more than %g seconds", (double)_budget.maximumDuration / NSEC_PER_SEC] error:error];
+    }
+    return YES;
+}
+
+- (BOOL)failWithDescription:(NSString *)description error:(NSError **)error
+{
+    if (_error == nil) {
+        _error = [[NSError alloc] initWithDomain:GRMustacheErrorDomain code:GRMustacheErrorCodeRenderingLimitExceeded userInfo:[NSDictionary dictionaryWithObject:description forKey:NSLocalizedDescriptionKey]];
+    }
+    if (error != NULL) {
+        *error = [[_error retain] autorelease];
+    }
+    return NO;
+}
+
+@end
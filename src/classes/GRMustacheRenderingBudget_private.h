@@ -0,0 +1,168 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+@class GRMustacheConfiguration;
+
+/**
+ * The GRMustacheRenderingBudget holds the rendering limits of a template: the
+ * maximum rendered length, the maximum rendering duration, the maximum partial
+ * depth, and the maximum iteration count.
+ *
+ * It is immutable, and built from a configuration.
+ *
+ * @see [GRMustacheConfiguration renderingBudget]
+ * @see GRMustacheRenderingSession
+ */
+@interface GRMustacheRenderingBudget : NSObject {
+@private
+    NSUInteger _maximumRenderedLength;
+    uint64_t _maximumDuration;
+    NSUInteger _maximumPartialDepth;
+    NSUInteger _maximumIterationCount;
+}
+
+/**
+ * Returns a budget built from the limits of _configuration_, or nil if the
+ * configuration does not define any limit.
+ *
+ * @param configuration  A configuration
+ *
+ * @return A rendering budget, or nil.
+ */
++ (instancetype)renderingBudgetWithConfiguration:(GRMustacheConfiguration *)configuration GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The maximum number of characters emitted by text and variable tags, or 0 for
+ * no limit.
+ */
+@property (nonatomic, readonly) NSUInteger maximumRenderedLength GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The maximum duration of a rendering, in nanoseconds, or 0 for no limit.
+ */
+@property (nonatomic, readonly) uint64_t maximumDuration GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The maximum nesting depth of partials, or 0 for no limit.
+ */
+@property (nonatomic, readonly) NSUInteger maximumPartialDepth GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The maximum number of renderings of section contents, or 0 for no limit.
+ */
+@property (nonatomic, readonly) NSUInteger maximumIterationCount GRMUSTACHE_API_INTERNAL;
+
+@end
+
+
+/**
+ * The GRMustacheRenderingSession tracks the resources consumed by a single
+ * rendering, and fails as soon as one of the limits of its budget is exceeded.
+ *
+ * A session is created by the rendering methods of GRMustacheTemplate, and
+ * travels through the rendering in the context. Rendering code checks the
+ * renderingSession property of the context before calling the session, so
+ * that templates without any budget pay a single nil test.
+ *
+ * Once a limit has been exceeded, all further checks fail, so that rendering
+ * objects that would ignore a rendering error do not resume the rendering.
+ *
+ * @see [GRMustacheContext renderingSession]
+ * @see [GRMustacheTemplate renderObject:error:]
+ */
+@interface GRMustacheRenderingSession : NSObject {
+@private
+    GRMustacheRenderingBudget *_budget;
+    uint64_t _deadline;
+    NSUInteger _renderedLength;
+    NSUInteger _templateDepth;
+    NSUInteger _iterationCount;
+    NSError *_error;
+}
+
+/**
+ * Returns a session that starts its clock immediately.
+ *
+ * @param budget  A rendering budget
+ *
+ * @return A rendering session.
+ */
++ (instancetype)renderingSessionWithBudget:(GRMustacheRenderingBudget *)budget GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Notifies the session that a template, or a partial template, starts
+ * rendering. Checks the partial depth and the rendering duration.
+ *
+ * On success, the call must be balanced with a call to exitTemplate.
+ *
+ * @param error  If there is an error, upon return contains an NSError object
+ *               of code GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @return YES if the rendering can go on.
+ *
+ * @see [GRMustacheTemplate renderContentType:inBuffer:withContext:error:]
+ */
+- (BOOL)enterTemplateWithError:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Balances a successful call to enterTemplateWithError:.
+ */
+- (void)exitTemplate GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Notifies the session that the content of a section is about to be rendered.
+ * Checks the iteration count and the rendering duration.
+ *
+ * @param error  If there is an error, upon return contains an NSError object
+ *               of code GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @return YES if the rendering can go on.
+ *
+ * @see [GRMustacheSectionTag renderContentWithContext:HTMLSafe:error:]
+ */
+- (BOOL)beginIterationWithError:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The number of characters accounted for by addRenderedLength:error:. It
+ * remains 0 when the budget has no maximum rendered length.
+ */
+@property (nonatomic, readonly) NSUInteger renderedLength GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Notifies the session that characters have been rendered. Checks the
+ * rendered length.
+ *
+ * @param length  The number of rendered characters.
+ * @param error   If there is an error, upon return contains an NSError object
+ *                of code GRMustacheErrorCodeRenderingLimitExceeded.
+ *
+ * @return YES if the rendering can go on.
+ *
+ * @see [GRMustacheTextComponent renderContentType:inBuffer:withContext:error:]
+ * @see [GRMustacheTag renderContentType:inBuffer:withContext:error:]
+ */
+- (BOOL)addRenderedLength:(NSUInteger)length error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+@end
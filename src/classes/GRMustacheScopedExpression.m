@@ -74,6 +74,11 @@
     return [_scopeIdentifier isEqual:((GRMustacheScopedExpression *)expression).scopeIdentifier];
 }
 
+- (void)acceptExpressionVisitor:(id<GRMustacheExpressionVisitor>)visitor
+{
+    [visitor visitScopedExpression:self];
+}
+
 
 #pragma mark - GRMustacheExpression
 
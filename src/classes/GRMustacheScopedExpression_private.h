@@ -33,6 +33,16 @@
     NSString *_scopeIdentifier;
 }
 
+/**
+ * The expression that evaluates to the scoped object: the `a` in `{{ a.b }}`.
+ */
+@property (nonatomic, retain, readonly) GRMustacheExpression *baseExpression GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The key looked up in the scoped object: the `b` in `{{ a.b }}`.
+ */
+@property (nonatomic, copy, readonly) NSString *scopeIdentifier GRMUSTACHE_API_INTERNAL;
+
 /**
  * Returns a scoped expression, given an expression that returns a value, and
  * an identifier.
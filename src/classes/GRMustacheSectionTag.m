@@ -29,6 +29,101 @@
 #import "GRMustacheContext_private.h"
 #import "GRMustacheRendering.h"
 #import "GRMustache_private.h"
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheIncrementalRendering_private.h"
+#import "GRMustacheVariableTag_private.h"
+#import "GRMustacheTemplateOverride_private.h"
+#import "GRMustacheFilteredExpression_private.h"
+#import "GRMustacheIdentifierExpression_private.h"
+#import "GRMustacheScopedExpression_private.h"
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheLastIterationMetadataDetector
+
+/**
+ * Looks for the `@last` loop metadata key in template components.
+ *
+ * Partials and overridable sections may be overriden by components that are
+ * unknown at compile time: they are assumed to use `@last`.
+ */
+@interface GRMustacheLastIterationMetadataDetector : NSObject<GRMustacheTemplateComponentVisitor, GRMustacheExpressionVisitor> {
+@private
+    BOOL _found;
+}
++ (BOOL)componentsUseLastIterationMetadata:(NSArray *)components;
+@end
+
+@implementation GRMustacheLastIterationMetadataDetector
+
++ (BOOL)componentsUseLastIterationMetadata:(NSArray *)components
+{
+    GRMustacheLastIterationMetadataDetector *detector = [[[self alloc] init] autorelease];
+    for (id<GRMustacheTemplateComponent> component in components) {
+        [component acceptTemplateComponentVisitor:detector];
+        if (detector->_found) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)visitTemplate:(GRMustacheTemplate *)template
+{
+    // Partial tag
+    _found = YES;
+}
+
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride
+{
+    _found = YES;
+}
+
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag
+{
+    if (sectionTag.type == GRMustacheTagTypeOverridableSection || sectionTag.usesLastIterationMetadata) {
+        _found = YES;
+        return;
+    }
+    [sectionTag.expression acceptExpressionVisitor:self];
+}
+
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag
+{
+    [variableTag.expression acceptExpressionVisitor:self];
+}
+
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent
+{
+}
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    [expression.filterExpression acceptExpressionVisitor:self];
+    [expression.argumentExpression acceptExpressionVisitor:self];
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    if ([expression.identifier isEqualToString:@"@last"]) {
+        _found = YES;
+    }
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    [expression.baseExpression acceptExpressionVisitor:self];
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheSectionTag
 
 @interface GRMustacheSectionTag()
 
@@ -57,6 +152,9 @@
 #pragma mark - GRMustacheTag
 
 @synthesize type=_type;
+@synthesize components=_components;
+@synthesize templateString=_templateString;
+@synthesize usesLastIterationMetadata=_usesLastIterationMetadata;
 
 - (NSString *)renderContentWithContext:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error
 {
@@ -67,16 +165,31 @@
         return NO;
     }
     
+    // Each rendering of the section content counts as one iteration.
+    GRMustacheRenderingSession *renderingSession = context.renderingSession;
+    if (renderingSession && ![renderingSession beginIterationWithError:error]) {
+        return nil;
+    }
+    
     NSMutableString *buffer = [NSMutableString string];
     
-    for (id<GRMustacheTemplateComponent> component in _components) {
-        // component may be overriden by a GRMustacheTemplateOverride: resolve it.
-        component = [context resolveTemplateComponent:component];
-        
-        // render
-        if (![component renderContentType:self.contentType inBuffer:buffer withContext:context error:error]) {
+    // Incremental rendering is opt-in: contexts without rendering segment
+    // only pay for this test.
+    GRMustacheRenderingSegment *renderingSegment = context.renderingSegment;
+    if (renderingSegment) {
+        if (![renderingSegment renderComponents:_components contentType:self.contentType inBuffer:buffer withContext:context error:error]) {
             return nil;
         }
+    } else {
+        for (id<GRMustacheTemplateComponent> component in _components) {
+            // component may be overriden by a GRMustacheTemplateOverride: resolve it.
+            component = [context resolveTemplateComponent:component];
+            
+            // render
+            if (![component renderContentType:self.contentType inBuffer:buffer withContext:context error:error]) {
+                return nil;
+            }
+        }
     }
     
     if (HTMLSafe) {
@@ -125,6 +238,14 @@
     return [GRMustacheAccumulatorTag accumulatorTagWithTag:overridingTag];
 }
 
+#pragma mark - <GRMustacheTemplateComponent>
+
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    [visitor visitSectionTag:self];
+}
+
+
 #pragma mark - Private
 
 - (id)initWithTemplateRepository:(GRMustacheTemplateRepository *)templateRepository expression:(GRMustacheExpression *)expression contentType:(GRMustacheContentType)contentType templateString:(NSString *)templateString innerRange:(NSRange)innerRange type:(GRMustacheTagType)type components:(NSArray *)components
@@ -135,6 +256,7 @@
         _innerRange = innerRange;
         _type = type;
         _components = [components retain];
+        _usesLastIterationMetadata = [GRMustacheLastIterationMetadataDetector componentsUseLastIterationMetadata:components];
     }
     return self;
 }
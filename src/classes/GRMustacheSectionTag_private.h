@@ -36,11 +36,23 @@
     NSRange _innerRange;
     GRMustacheTagType _type;
     NSArray *_components;
+    BOOL _usesLastIterationMetadata;
 }
 
 // Documented in GRMustacheSectionTag.h
 @property (nonatomic, readonly) NSString *innerTemplateString GRMUSTACHE_API_PUBLIC;
 
+/**
+ * The template components of the section content.
+ */
+@property (nonatomic, retain, readonly) NSArray *components GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The template string containing the section. The section content is the
+ * innerTemplateString substring.
+ */
+@property (nonatomic, retain, readonly) NSString *templateString GRMUSTACHE_API_INTERNAL;
+
 
 /**
  * Builds a GRMustacheSectionTag.
@@ -0,0 +1,150 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <errno.h>
+#import <fcntl.h>
+#import <stdlib.h>
+#import <string.h>
+#import <unistd.h>
+#import "GRMustacheSpooledString_private.h"
+
+@interface GRMustacheSpooledString()
+- (id)initWithFileDescriptor:(int)fileDescriptor;
+@end
+
+@implementation GRMustacheSpooledString
+
++ (instancetype)spooledStringReturningError:(NSError **)error
+{
+    NSString *template = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheSpool.XXXXXX"];
+    char *path = strdup([template fileSystemRepresentation]);
+    int fileDescriptor = mkstemp(path);
+    if (fileDescriptor >= 0) {
+        // The file disappears when the descriptor is closed.
+        unlink(path);
+    }
+    free(path);
+    
+    if (fileDescriptor < 0) {
+        if (error != NULL) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+        }
+        return nil;
+    }
+    return [[[self alloc] initWithFileDescriptor:fileDescriptor] autorelease];
+}
+
+- (void)dealloc
+{
+    close(_fileDescriptor);
+    [super dealloc];
+}
+
+- (id)initWithFileDescriptor:(int)fileDescriptor
+{
+    self = [super init];
+    if (self) {
+        _fileDescriptor = fileDescriptor;
+    }
+    return self;
+}
+
+- (BOOL)appendString:(NSString *)string error:(NSError **)error
+{
+    NSUInteger length = string.length;
+    if (length == 0) {
+        return YES;
+    }
+    
+    unichar *characters = malloc(length * sizeof(unichar));
+    [string getCharacters:characters range:NSMakeRange(0, length)];
+    
+    const char *bytes = (const char *)characters;
+    size_t remaining = length * sizeof(unichar);
+    off_t offset = (off_t)(_length * sizeof(unichar));
+    while (remaining > 0) {
+        ssize_t written = pwrite(_fileDescriptor, bytes, remaining, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (error != NULL) {
+                *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+            }
+            free(characters);
+            return NO;
+        }
+        bytes += written;
+        remaining -= (size_t)written;
+        offset += written;
+    }
+    free(characters);
+    
+    _length += length;
+    return YES;
+}
+
+
+#pragma mark - NSString
+
+- (NSUInteger)length
+{
+    return _length;
+}
+
+- (unichar)characterAtIndex:(NSUInteger)index
+{
+    unichar character;
+    [self getCharacters:&character range:NSMakeRange(index, 1)];
+    return character;
+}
+
+- (void)getCharacters:(unichar *)buffer range:(NSRange)range
+{
+    if (NSMaxRange(range) > _length) {
+        [NSException raise:NSRangeException format:@"Range %@ out of bounds", NSStringFromRange(range)];
+    }
+    
+    char *bytes = (char *)buffer;
+    size_t remaining = range.length * sizeof(unichar);
+    off_t offset = (off_t)(range.location * sizeof(unichar));
+    while (remaining > 0) {
+        ssize_t readLength = pread(_fileDescriptor, bytes, remaining, offset);
+        if (readLength < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readLength <= 0) {
+            [NSException raise:NSGenericException format:@"Could not read spooled template: %s", strerror(errno)];
+        }
+        bytes += readLength;
+        remaining -= (size_t)readLength;
+        offset += readLength;
+    }
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable once parsed
+    return [self retain];
+}
+
+@end
@@ -0,0 +1,71 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+/**
+ * A GRMustacheSpooledString is a string whose characters are stored in an
+ * anonymous temporary file, instead of memory.
+ *
+ * The parser spools the source of streamed templates into such a string, so
+ * that tokens and section tags can refer to it, as they refer to the source of
+ * regular templates, without keeping it in memory. Characters are read from the
+ * file when they are needed: when a tag describes itself, or when the
+ * innerTemplateString of a section tag is required.
+ *
+ * The temporary file is removed from the file system as soon as it is created,
+ * and disappears when the string is deallocated.
+ *
+ * @see [GRMustacheParser parseTemplateStream:encoding:templateID:]
+ */
+@interface GRMustacheSpooledString : NSString {
+@private
+    int _fileDescriptor;
+    NSUInteger _length;
+}
+
+/**
+ * Returns an empty spooled string.
+ *
+ * @param error  If the temporary file could not be created, upon return
+ *               contains an NSError object that describes the problem.
+ *
+ * @return A spooled string, or nil.
+ */
++ (instancetype)spooledStringReturningError:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Appends characters to the receiver.
+ *
+ * Spooled strings are only mutated while the parser reads a stream: the
+ * string is immutable as soon as the parsing is over.
+ *
+ * @param string  A string.
+ * @param error   If the characters could not be written, upon return
+ *                contains an NSError object that describes the problem.
+ *
+ * @return YES if the characters could be appended.
+ */
+- (BOOL)appendString:(NSString *)string error:(NSError **)error GRMUSTACHE_API_INTERNAL;
+
+@end
@@ -27,6 +27,80 @@
 #import "GRMustacheContext_private.h"
 #import "GRMustache_private.h"
 #import "GRMustacheRendering.h"
+#import "GRMustacheProfiler_private.h"
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheIncrementalRendering_private.h"
+#import "GRMustacheFilteredExpression_private.h"
+#import "GRMustacheIdentifierExpression_private.h"
+#import "GRMustacheImplicitIteratorExpression_private.h"
+#import "GRMustacheScopedExpression_private.h"
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheKeyPathCollector
+
+/**
+ * Collects the key paths read by an expression: `name`, `user.name`, and, for
+ * `f(x.y)`, `f` and `x.y`.
+ *
+ * Key paths that start from the implicit iterator, such as `.name`, are
+ * collected without their leading dot.
+ */
+@interface GRMustacheKeyPathCollector : NSObject<GRMustacheExpressionVisitor> {
+@private
+    NSMutableSet *_keyPaths;
+    NSString *_keyPath;
+}
++ (void)collectKeyPathsOfExpression:(GRMustacheExpression *)expression inSet:(NSMutableSet *)keyPaths;
+@end
+
+@implementation GRMustacheKeyPathCollector
+
++ (void)collectKeyPathsOfExpression:(GRMustacheExpression *)expression inSet:(NSMutableSet *)keyPaths
+{
+    GRMustacheKeyPathCollector *collector = [[[self alloc] init] autorelease];
+    collector->_keyPaths = keyPaths;    // not retained: the collector does not outlive this method
+    [expression acceptExpressionVisitor:collector];
+    if (collector->_keyPath) {
+        [keyPaths addObject:collector->_keyPath];
+    }
+}
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    [expression.filterExpression acceptExpressionVisitor:self];
+    if (_keyPath) { [_keyPaths addObject:_keyPath]; }
+    [expression.argumentExpression acceptExpressionVisitor:self];
+    if (_keyPath) { [_keyPaths addObject:_keyPath]; }
+    _keyPath = nil;
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    _keyPath = expression.identifier;
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+    _keyPath = nil;
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    GRMustacheExpression *baseExpression = expression.baseExpression;
+    [baseExpression acceptExpressionVisitor:self];
+    if (_keyPath) {
+        _keyPath = [NSString stringWithFormat:@"%@.%@", _keyPath, expression.scopeIdentifier];
+    } else if ([baseExpression isKindOfClass:[GRMustacheImplicitIteratorExpression class]]) {
+        _keyPath = expression.scopeIdentifier;
+    }
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheTag
 
 @implementation GRMustacheTag
 @synthesize expression=_expression;
@@ -74,6 +148,14 @@
     return YES;
 }
 
+- (BOOL)usesLastIterationMetadata
+{
+    // Default NO.
+    // This method is overrided by GRMustacheSectionTag and
+    // GRMustacheAccumulatorTag.
+    return NO;
+}
+
 - (NSString *)innerTemplateString
 {
     // Default empty string.
@@ -114,6 +196,19 @@
     
     BOOL success = YES;
     
+    // Profiling is opt-in: contexts without profiler only pay for this test.
+    GRMustacheProfiler *profiler = context.profiler;
+    if (profiler) {
+        [profiler beginFrameForTag:self];
+    }
+    
+    // Incremental rendering is opt-in: contexts without rendering segment
+    // only pay for this test.
+    GRMustacheRenderingSegment *renderingSegment = context.renderingSegment;
+    if (renderingSegment) {
+        [GRMustacheKeyPathCollector collectKeyPathsOfExpression:_expression inSet:renderingSegment.keyPaths];
+    }
+    
     @autoreleasepool {
         
         // Evaluate expression
@@ -186,11 +281,28 @@
             
             // 4. Render
         
+            GRMustacheRenderingSession *renderingSession = context.renderingSession;
+            NSUInteger renderedLengthBefore = renderingSession.renderedLength;
+            
             id<GRMustacheRendering> renderingObject = [GRMustache renderingObjectForObject:object];
             BOOL objectHTMLSafe = NO;
             NSError *renderingError = nil;
             NSString *rendering = [renderingObject renderForMustacheTag:self context:context HTMLSafe:&objectHTMLSafe error:&renderingError];
             
+            // Rendering limits. The content of sections has already been
+            // accounted for by its own text and variable tags. So has the
+            // content of the templates rendered by variable tags, such as
+            // dynamic partials: only count what has not been counted yet,
+            // such as the strings built by rendering objects, or returned by
+            // fragment caches.
+            
+            if (renderingSession && rendering) {
+                NSUInteger countedLength = renderingSession.renderedLength - renderedLengthBefore;
+                if (rendering.length > countedLength && ![renderingSession addRenderedLength:rendering.length - countedLength error:&renderingError]) {
+                    rendering = nil;
+                }
+            }
+            
             // If rendering is nil, but rendering error is not set,
             // assume lazy coder, and the intention to render nothing:
             // fail if and only if rendering is nil and renderingError is
@@ -222,10 +334,19 @@
                 if (rendering.length > 0) {
                     if ((requiredContentType == GRMustacheContentTypeHTML) && !objectHTMLSafe && self.escapesHTML) {
                         rendering = [GRMustache escapeHTML:rendering];
+                        [renderingSegment didProcessRenderingOfInnerSegments];
                     }
                     [buffer appendString:rendering];
                 }
                 
+                // Incremental rendering can update the inner segments of
+                // sections rendered by GRMustache itself only: rendering
+                // objects and filters may process their rendering.
+                
+                if (renderingSegment && (self.type == GRMustacheTagTypeVariable || ![GRMustache isBuiltInRenderingObject:renderingObject])) {
+                    [renderingSegment didProcessRenderingOfInnerSegments];
+                }
+                
                 // Tag delegates post-rendering callbacks
                 
                 if (rendering == nil) { rendering = @""; }  // Don't expose nil as a success
@@ -238,6 +359,10 @@
         }
     }
     
+    if (profiler) {
+        [profiler endFrame];
+    }
+    
     if (!success && error) [*error autorelease];    // the error has been retained inside the @autoreleasepool block
     return success;
 }
@@ -269,4 +394,9 @@
     return [otherTag tagWithOverridingTag:self];
 }
 
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    NSAssert(NO, @"Subclasses must override");
+}
+
 @end
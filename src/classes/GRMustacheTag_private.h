@@ -89,6 +89,21 @@ typedef NS_ENUM(NSUInteger, GRMustacheTagType) {
  */
 @property (nonatomic, readonly) BOOL escapesHTML GRMUSTACHE_API_INTERNAL;
 
+/**
+ * Returns YES if the content of the receiver may read the `@last` loop
+ * metadata key.
+ *
+ * Enumerable objects always provide the `@index`, `@first`, `@odd` and `@even`
+ * keys. Enumerable objects that do not respond to `count` only tell their last
+ * item when this property is YES.
+ *
+ * Default NO. This property is overrided by GRMustacheSectionTag and
+ * GRMustacheAccumulatorTag.
+ *
+ * @see [GRMustacheContext contextByAddingObject:iterationIndex:last:]
+ */
+@property (nonatomic, readonly) BOOL usesLastIterationMetadata GRMUSTACHE_API_INTERNAL;
+
 /**
  * The expression evaluated and rendered by the tag.
  *
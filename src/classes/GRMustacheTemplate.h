@@ -25,6 +25,7 @@
 #import "GRMustacheConfiguration.h"
 
 @class GRMustacheContext;
+@class GRMustacheMemoryFootprint;
 
 /**
  * The GRMustacheTemplate class provides with Mustache template rendering
@@ -39,6 +40,9 @@
     NSArray *_components;
     GRMustacheContext *_baseContext;
     GRMustacheContentType _contentType;
+    id _templateID;
+    id _metrics;
+    id _renderingBudget;
 }
 
 
@@ -234,4 +238,73 @@
  */
 - (NSString *)renderContentWithContext:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER;
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Measuring Memory
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns a report of the memory retained by the template, and by the
+ * partials it embeds: template components, tags, expressions, parser tokens,
+ * and template sources.
+ *
+ *     GRMustacheTemplate *template = ...;
+ *     NSLog(@"%@", [template.memoryFootprint dictionaryRepresentation]);
+ *
+ * The report is computed on each call, by walking the compiled template.
+ *
+ * @return A memory footprint.
+ *
+ * @see GRMustacheMemoryFootprint
+ *
+ * @since v6.5
+ */
+- (GRMustacheMemoryFootprint *)memoryFootprint AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Specializing Templates
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Returns a residual template, where the tags that only depend on the frozen
+ * values of _context_ have been evaluated once and for all.
+ *
+ * Frozen values are the values of the protected objects of _context_: since
+ * they can not be overriden by runtime data, they always render the same:
+ *
+ *     id constants = @{ @"brand": @"Acme", @"beta": @NO };
+ *     GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:constants];
+ *     GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{brand}} {{^beta}}welcomes {{name}}{{/beta}}" error:NULL];
+ *     GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+ *
+ *     // The residual template is equivalent to "Acme welcomes {{name}}".
+ *     [residual renderObject:@{ @"name": @"Arthur" } error:NULL];
+ *
+ * Variable tags that render frozen strings, numbers, or missing values are
+ * pre-rendered, and HTML-escaped when needed. Sections controlled by frozen
+ * booleans or missing values are pruned or unrolled. Other tags, and the
+ * content of the sections that can not be pruned or unrolled, are kept
+ * untouched. Partials are specialized as well.
+ *
+ * The residual template has _context_ as its base context. It renders the
+ * same as the receiver would, as long as filters of frozen values return the
+ * same result on each call.
+ *
+ * Caveat: pre-rendered tags are text in the residual template: they do
+ * not notify tag delegates, whether delegates come from _context_, from the
+ * base context, or from the rendered data. Do not specialize templates whose
+ * tag delegates need to observe or alter frozen values.
+ *
+ * @param context  A context whose protected objects are frozen.
+ *
+ * @return A residual template.
+ *
+ * @see [GRMustacheContext contextWithProtectedObject:]
+ *
+ * @since v6.5
+ */
+- (GRMustacheTemplate *)templateBySpecializingWithContext:(GRMustacheContext *)context AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
 @end
@@ -25,6 +25,13 @@
 #import "GRMustacheTemplateRepository_private.h"
 #import "GRMustacheSectionTag_private.h"
 #import "GRMustacheRendering.h"
+#import "GRMustacheProfiler_private.h"
+#import "GRMustacheMetrics_private.h"
+#import "GRMustacheInstrumentation_private.h"
+#import "GRMustacheRenderingBudget_private.h"
+#import "GRMustacheIncrementalRendering_private.h"
+#import "GRMustacheMemoryFootprint_private.h"
+#import "GRMustacheTemplateSpecializer_private.h"
 
 @interface GRMustacheTemplate()<GRMustacheRendering>
 @end
@@ -33,6 +40,9 @@
 @synthesize components=_components;
 @synthesize contentType=_contentType;
 @synthesize baseContext=_baseContext;
+@synthesize templateID=_templateID;
+@synthesize metrics=_metrics;
+@synthesize renderingBudget=_renderingBudget;
 
 + (instancetype)templateFromString:(NSString *)templateString error:(NSError **)error
 {
@@ -80,22 +90,41 @@
 {
     [_components release];
     [_baseContext release];
+    [_templateID release];
+    [_metrics release];
+    [_renderingBudget release];
     [super dealloc];
 }
 
 - (NSString *)renderObject:(id)object error:(NSError **)error
 {
+    uint64_t start = GRMustacheInstrumentationNanoseconds();
     GRMustacheContext *context = [self.baseContext contextByAddingObject:object];
-    return [self renderContentWithContext:context HTMLSafe:NULL error:error];
+    if (_renderingBudget) {
+        context = [context contextByAddingRenderingSession:[GRMustacheRenderingSession renderingSessionWithBudget:_renderingBudget]];
+    }
+    NSString *rendering = [self renderContentWithContext:context HTMLSafe:NULL error:error];
+    if (rendering) {
+        [_metrics didRenderLength:rendering.length withLatency:GRMustacheInstrumentationNanoseconds() - start];
+    }
+    return rendering;
 }
 
 - (NSString *)renderObjectsFromArray:(NSArray *)objects error:(NSError **)error
 {
+    uint64_t start = GRMustacheInstrumentationNanoseconds();
     GRMustacheContext *context = self.baseContext;
     for (id object in objects) {
         context = [context contextByAddingObject:object];
     }
-    return [self renderContentWithContext:context HTMLSafe:NULL error:error];
+    if (_renderingBudget) {
+        context = [context contextByAddingRenderingSession:[GRMustacheRenderingSession renderingSessionWithBudget:_renderingBudget]];
+    }
+    NSString *rendering = [self renderContentWithContext:context HTMLSafe:NULL error:error];
+    if (rendering) {
+        [_metrics didRenderLength:rendering.length withLatency:GRMustacheInstrumentationNanoseconds() - start];
+    }
+    return rendering;
 }
 
 - (NSString *)renderContentWithContext:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error
@@ -124,6 +153,22 @@
 }
 
 
+- (GRMustacheMemoryFootprint *)memoryFootprint
+{
+    return [GRMustacheMemoryFootprint memoryFootprintWithTemplates:[NSArray arrayWithObject:self]];
+}
+
+- (GRMustacheTemplate *)templateBySpecializingWithContext:(GRMustacheContext *)context
+{
+    if (!context) {
+        [NSException raise:NSInvalidArgumentException format:@"Invalid context:nil"];
+        return nil;
+    }
+    
+    return [GRMustacheTemplateSpecializer templateBySpecializingTemplate:self withContext:context];
+}
+
+
 #pragma mark - <GRMustacheTemplateComponent>
 
 - (BOOL)renderContentType:(GRMustacheContentType)requiredContentType inBuffer:(NSMutableString *)buffer withContext:(GRMustacheContext *)context error:(NSError **)error
@@ -153,21 +198,67 @@
         renderingBuffer = buffer;
     }
     
-    for (id<GRMustacheTemplateComponent> component in _components) {
-        // component may be overriden by a GRMustacheTemplateOverride: resolve it.
-        component = [context resolveTemplateComponent:component];
-        
-        // render
-        if (![component renderContentType:self.contentType inBuffer:renderingBuffer withContext:context error:error]) {
-            return NO;
+    // Rendering limits are opt-in: contexts without session only pay for this
+    // test.
+    GRMustacheRenderingSession *renderingSession = context.renderingSession;
+    if (renderingSession && ![renderingSession enterTemplateWithError:error]) {
+        return NO;
+    }
+    
+    // Profiling is opt-in: contexts without profiler only pay for this test.
+    GRMustacheProfiler *profiler = context.profiler;
+    if (profiler) {
+        [profiler beginFrameForTemplate:self];
+    }
+    
+    // Tracing is opt-in: contexts without tracer only pay for this test.
+    id<GRMustacheTracer> tracer = context.tracer;
+    uint64_t traceStart = 0;
+    NSUInteger traceStartLength = 0;
+    if (tracer) {
+        [tracer mustacheTemplate:self willBeginSpanWithTemplateID:_templateID];
+        traceStartLength = buffer.length;
+        traceStart = GRMustacheInstrumentationNanoseconds();
+    }
+    
+    BOOL success = YES;
+    
+    // Incremental rendering is opt-in: contexts without rendering segment
+    // only pay for this test.
+    GRMustacheRenderingSegment *renderingSegment = context.renderingSegment;
+    if (renderingSegment) {
+        success = [renderingSegment renderComponents:_components contentType:self.contentType inBuffer:renderingBuffer withContext:context error:error];
+    } else {
+        for (id<GRMustacheTemplateComponent> component in _components) {
+            // component may be overriden by a GRMustacheTemplateOverride: resolve it.
+            component = [context resolveTemplateComponent:component];
+            
+            // render
+            if (![component renderContentType:self.contentType inBuffer:renderingBuffer withContext:context error:error]) {
+                success = NO;
+                break;
+            }
         }
     }
     
-    if (needsEscapingBuffer) {
+    if (profiler) {
+        [profiler endFrame];
+    }
+    
+    if (renderingSession) {
+        [renderingSession exitTemplate];
+    }
+    
+    if (success && needsEscapingBuffer) {
         [buffer appendString:[GRMustache escapeHTML:needsEscapingBuffer]];
     }
     
-    return YES;
+    if (tracer) {
+        NSTimeInterval duration = (double)(GRMustacheInstrumentationNanoseconds() - traceStart) / NSEC_PER_SEC;
+        [tracer mustacheTemplate:self didEndSpanWithTemplateID:_templateID duration:duration renderedLength:buffer.length - traceStartLength success:success];
+    }
+    
+    return success;
 }
 
 - (id<GRMustacheTemplateComponent>)resolveTemplateComponent:(id<GRMustacheTemplateComponent>)component
@@ -193,6 +284,12 @@
 }
 
 
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    [visitor visitTemplate:self];
+}
+
+
 #pragma mark - <GRMustacheRendering>
 
 // Allows template to render as "dynamic partials"
@@ -0,0 +1,262 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+@class GRMustacheTemplate;
+
+/**
+ * The GRMustacheTemplateAnalysis class performs a static analysis of a
+ * template, and of the partials it embeds.
+ *
+ * Its purpose is to estimate the cost of templates before they are rendered,
+ * so that costly templates, such as user-provided templates, can be rejected
+ * or throttled.
+ *
+ * Tag and filter counts are computed on the template whose partial tags have
+ * been replaced by the content of the partials: a tag that lies in a partial
+ * that is embedded twice is counted twice. Recursive partials are not expanded
+ * beyond their first occurrence: check the hasRecursivePartials property.
+ *
+ * Counts saturate at NSUIntegerMax.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/templates.md
+ *
+ * @see GRMustacheTemplate
+ *
+ * @since v6.5
+ */
+@interface GRMustacheTemplateAnalysis : NSObject {
+@private
+    id _template;
+    NSUInteger _variableTagCount;
+    NSUInteger _sectionTagCount;
+    NSUInteger _invertedSectionTagCount;
+    NSUInteger _overridableSectionTagCount;
+    NSUInteger _filterCallCount;
+    NSUInteger _maximumSectionDepth;
+    NSUInteger _partialCount;
+    NSUInteger _maximumPartialFanOut;
+    NSUInteger _maximumPartialDepth;
+    BOOL _hasRecursivePartials;
+    NSUInteger _maximumOverrideDepth;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Analyzing Templates
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns the static analysis of a template.
+ *
+ * @param template  A template.
+ *
+ * @return A template analysis.
+ *
+ * @since v6.5
+ */
++ (instancetype)analysisWithTemplate:(GRMustacheTemplate *)template AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Counting Tags
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The number of variable tags: `{{name}}` and `{{{name}}}`.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger variableTagCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of regular section tags: `{{#name}}...{{/name}}`.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger sectionTagCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of inverted section tags: `{{^name}}...{{/name}}`.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger invertedSectionTagCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of overridable section tags: `{{$name}}...{{/name}}`.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger overridableSectionTagCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of filter calls: `{{ f(x) }}` contains one filter call, as well
+ * as `{{ f(x,y) }}`. `{{ f(g(x)) }}` contains two.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger filterCallCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum nesting depth of section tags, partials included.
+ *
+ * `{{name}}` has depth 0, `{{#a}}{{#b}}{{/b}}{{/a}}` has depth 2.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger maximumSectionDepth AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Analyzing Partials
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The number of distinct partials embedded by the template, directly or
+ * indirectly, overridden partials of `{{<partial}}...{{/partial}}` tags
+ * included.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger partialCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum number of partial tags contained by a single template or partial.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger maximumPartialFanOut AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The length of the longest chain of embedded partials: a template without
+ * any partial has depth 0, a template that embeds a partial without any
+ * partial has depth 1, etc.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger maximumPartialDepth AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * YES if a partial embeds itself, directly or indirectly.
+ *
+ * Rendering such a template may not end, unless the recursion is stopped by
+ * the rendered data.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) BOOL hasRecursivePartials AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The length of the longest chain of overridden partials: a template without
+ * any `{{<partial}}...{{/partial}}` tag has depth 0. A template that overrides
+ * a partial has depth 1. Should the overridden partial itself override a
+ * partial, the depth would be 2, etc.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger maximumOverrideDepth AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Estimating Rendering Cost
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns an estimation of the number of operations performed by a rendering
+ * of the template.
+ *
+ * Each evaluation of a tag, and each filter call, counts for one operation.
+ * The content of regular sections is counted as many times as the number of
+ * items the section is expected to iterate.
+ *
+ * This number is given by the _cardinalities_ dictionary, whose keys are
+ * section expressions, as written in the template, without white space (such
+ * as `items`, `user.friends`, or `reverse(items)`), and values are NSNumber.
+ * Sections whose expression is not in the dictionary are expected to iterate
+ * _defaultCardinality_ items.
+ *
+ * For example, with the `{{#items}}{{name}}{{/items}}` template:
+ *
+ *     // 1 + 10 * 1 = 11
+ *     [analysis estimatedCostWithCardinalities:@{ @"items": @10 } defaultCardinality:1];
+ *
+ * Inverted and overridable sections are expected to render their content once.
+ *
+ * @param cardinalities       A dictionary of expected section cardinalities.
+ * @param defaultCardinality  The cardinality of sections whose expression is
+ *                            not in the _cardinalities_ dictionary.
+ *
+ * @return An estimation of the number of operations of a rendering.
+ *
+ * @since v6.5
+ */
+- (double)estimatedCostWithCardinalities:(NSDictionary *)cardinalities defaultCardinality:(double)defaultCardinality AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @name Extracting Data Requirements
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * Returns the tree of the keys that a rendering of the template may read, so
+ * that you can fetch only the data that the template needs.
+ *
+ * The tree is a dictionary whose keys are identifiers, and values are the
+ * trees of the keys read on the values of those identifiers. Leaves are empty
+ * dictionaries. Keys read inside a section are read on the section value,
+ * or on each of its items when it is a collection: they are nested below the
+ * section expression.
+ *
+ * For example, with the `{{user.name}}{{#items}}{{price}}{{/items}}`
+ * template:
+ *
+ *     // @{ @"user": @{ @"name": @{} }, @"items": @{ @"price": @{} } }
+ *     [analysis dataRequirements];
+ *
+ * Partials, overridden partials, filters, and filter arguments are included:
+ * `{{ uppercase(user.name) }}` reads the `uppercase` key, and `user.name`.
+ * The content of a section whose expression is a filter call is nested below
+ * the argument of the filter: `{{# reverse(items) }}{{price}}{{/}}` reads
+ * `items.price`. Inverted sections do not change the nesting level. Loop
+ * metadata such as `@index` are not listed. Recursive partials are expanded
+ * once: with the `{{name}}{{#friends}}{{>person}}{{/friends}}` person partial,
+ * the tree lists `name`, `friends.name`, and `friends.friends`.
+ *
+ * Keys that a section value does not provide are looked up in enclosing
+ * contexts: a key listed below a section expression may also be read on the
+ * objects above it. Rendering objects and filters may read other keys.
+ *
+ * @return A tree of dictionaries.
+ *
+ * @since v6.5
+ */
+- (NSDictionary *)dataRequirements AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
@@ -0,0 +1,681 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheTemplateAnalysis_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateOverride_private.h"
+#import "GRMustacheSectionTag_private.h"
+#import "GRMustacheVariableTag_private.h"
+#import "GRMustacheTextComponent_private.h"
+#import "GRMustacheExpression_private.h"
+#import "GRMustacheFilteredExpression_private.h"
+#import "GRMustacheIdentifierExpression_private.h"
+#import "GRMustacheImplicitIteratorExpression_private.h"
+#import "GRMustacheScopedExpression_private.h"
+
+static inline NSUInteger GRMustacheSaturatingAdd(NSUInteger a, NSUInteger b)
+{
+    return (a > NSUIntegerMax - b) ? NSUIntegerMax : (a + b);
+}
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheExpressionStringifier
+
+/**
+ * Builds the canonical string of an expression.
+ */
+@interface GRMustacheExpressionStringifier : NSObject<GRMustacheExpressionVisitor> {
+@private
+    NSString *_string;
+    NSUInteger _filterCallCount;
+}
+@property (nonatomic, retain) NSString *string;
+@property (nonatomic) NSUInteger filterCallCount;
+- (NSString *)stringWithExpression:(GRMustacheExpression *)expression;
+@end
+
+@implementation GRMustacheExpressionStringifier
+@synthesize string=_string;
+@synthesize filterCallCount=_filterCallCount;
+
+- (void)dealloc
+{
+    [_string release];
+    [super dealloc];
+}
+
+- (NSString *)stringWithExpression:(GRMustacheExpression *)expression
+{
+    [expression acceptExpressionVisitor:self];
+    return self.string;
+}
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    NSString *filterString = [self stringWithExpression:expression.filterExpression];
+    NSString *argumentString = [self stringWithExpression:expression.argumentExpression];
+    
+    // `f(x,y)` is compiled as the curried expression `f(x)(y)`.
+    GRMustacheExpression *filterExpression = expression.filterExpression;
+    if ([filterExpression isKindOfClass:[GRMustacheFilteredExpression class]] && ((GRMustacheFilteredExpression *)filterExpression).curry) {
+        self.string = [NSString stringWithFormat:@"%@,%@)", [filterString substringToIndex:filterString.length - 1], argumentString];
+    } else {
+        self.string = [NSString stringWithFormat:@"%@(%@)", filterString, argumentString];
+    }
+    
+    if (!expression.curry) {
+        _filterCallCount = GRMustacheSaturatingAdd(_filterCallCount, 1);
+    }
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    self.string = expression.identifier;
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+    self.string = @".";
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    NSString *baseString = [self stringWithExpression:expression.baseExpression];
+    if ([baseString isEqualToString:@"."]) {
+        self.string = [NSString stringWithFormat:@".%@", expression.scopeIdentifier];
+    } else {
+        self.string = [NSString stringWithFormat:@"%@.%@", baseString, expression.scopeIdentifier];
+    }
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheTemplateAnalyzer
+
+/**
+ * Analyzes a single template, and merges the analysis of the partials it
+ * embeds.
+ *
+ * Analyzers are memoized by template, so that a partial embedded many times
+ * is analyzed once, and that templates that embed the same partials in a
+ * combinatorial way are analyzed in linear time.
+ */
+@interface GRMustacheTemplateAnalyzer : NSObject<GRMustacheTemplateComponentVisitor> {
+@private
+    NSMapTable *_analyzerForTemplate;
+    NSDictionary *_cardinalities;
+    double _defaultCardinality;
+    BOOL _complete;
+    
+    // Traversal state
+    NSUInteger _sectionDepth;
+    NSUInteger _partialTagCount;
+    double _multiplier;
+    
+    // Results
+    NSUInteger _variableTagCount;
+    NSUInteger _sectionTagCount;
+    NSUInteger _invertedSectionTagCount;
+    NSUInteger _overridableSectionTagCount;
+    NSUInteger _filterCallCount;
+    NSUInteger _maximumSectionDepth;
+    NSUInteger _maximumPartialFanOut;
+    NSUInteger _maximumPartialDepth;
+    NSUInteger _maximumOverrideDepth;
+    BOOL _hasRecursivePartials;
+    double _cost;
+}
+@property (nonatomic, readonly) BOOL complete;
+@property (nonatomic, readonly) NSUInteger variableTagCount;
+@property (nonatomic, readonly) NSUInteger sectionTagCount;
+@property (nonatomic, readonly) NSUInteger invertedSectionTagCount;
+@property (nonatomic, readonly) NSUInteger overridableSectionTagCount;
+@property (nonatomic, readonly) NSUInteger filterCallCount;
+@property (nonatomic, readonly) NSUInteger maximumSectionDepth;
+@property (nonatomic, readonly) NSUInteger maximumPartialFanOut;
+@property (nonatomic, readonly) NSUInteger maximumPartialDepth;
+@property (nonatomic, readonly) NSUInteger maximumOverrideDepth;
+@property (nonatomic, readonly) BOOL hasRecursivePartials;
+@property (nonatomic, readonly) double cost;
++ (NSMapTable *)analyzerForTemplateMapTable;
+- (id)initWithAnalyzerForTemplate:(NSMapTable *)analyzerForTemplate cardinalities:(NSDictionary *)cardinalities defaultCardinality:(double)defaultCardinality;
+- (void)analyzeTemplate:(GRMustacheTemplate *)template;
+- (void)includeTemplate:(GRMustacheTemplate *)template overridden:(BOOL)overridden;
+- (void)visitComponents:(NSArray *)components;
+- (void)visitExpression:(GRMustacheExpression *)expression;
+@end
+
+@implementation GRMustacheTemplateAnalyzer
+@synthesize complete=_complete;
+@synthesize variableTagCount=_variableTagCount;
+@synthesize sectionTagCount=_sectionTagCount;
+@synthesize invertedSectionTagCount=_invertedSectionTagCount;
+@synthesize overridableSectionTagCount=_overridableSectionTagCount;
+@synthesize filterCallCount=_filterCallCount;
+@synthesize maximumSectionDepth=_maximumSectionDepth;
+@synthesize maximumPartialFanOut=_maximumPartialFanOut;
+@synthesize maximumPartialDepth=_maximumPartialDepth;
+@synthesize maximumOverrideDepth=_maximumOverrideDepth;
+@synthesize hasRecursivePartials=_hasRecursivePartials;
+@synthesize cost=_cost;
+
++ (NSMapTable *)analyzerForTemplateMapTable
+{
+    return [[[NSMapTable alloc] initWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                      valueOptions:NSPointerFunctionsStrongMemory
+                                          capacity:0] autorelease];
+}
+
+- (void)dealloc
+{
+    [_cardinalities release];
+    [super dealloc];
+}
+
+- (id)initWithAnalyzerForTemplate:(NSMapTable *)analyzerForTemplate cardinalities:(NSDictionary *)cardinalities defaultCardinality:(double)defaultCardinality
+{
+    self = [super init];
+    if (self) {
+        _analyzerForTemplate = analyzerForTemplate; // do not retain, since analyzerForTemplate retains self.
+        _cardinalities = [cardinalities retain];
+        _defaultCardinality = defaultCardinality;
+    }
+    return self;
+}
+
+- (void)analyzeTemplate:(GRMustacheTemplate *)template
+{
+    _multiplier = 1;
+    [self visitComponents:template.components];
+    _maximumPartialFanOut = MAX(_maximumPartialFanOut, _partialTagCount);
+    _complete = YES;
+}
+
+- (void)includeTemplate:(GRMustacheTemplate *)template overridden:(BOOL)overridden
+{
+    _partialTagCount += 1;
+    
+    GRMustacheTemplateAnalyzer *analyzer = [_analyzerForTemplate objectForKey:template];
+    if (analyzer == nil) {
+        analyzer = [[[GRMustacheTemplateAnalyzer alloc] initWithAnalyzerForTemplate:_analyzerForTemplate cardinalities:_cardinalities defaultCardinality:_defaultCardinality] autorelease];
+        [_analyzerForTemplate setObject:analyzer forKey:template];
+        [analyzer analyzeTemplate:template];
+    }
+    
+    if (!analyzer.complete) {
+        // The template is being analyzed: this is a recursive partial.
+        _hasRecursivePartials = YES;
+        return;
+    }
+    
+    _variableTagCount = GRMustacheSaturatingAdd(_variableTagCount, analyzer.variableTagCount);
+    _sectionTagCount = GRMustacheSaturatingAdd(_sectionTagCount, analyzer.sectionTagCount);
+    _invertedSectionTagCount = GRMustacheSaturatingAdd(_invertedSectionTagCount, analyzer.invertedSectionTagCount);
+    _overridableSectionTagCount = GRMustacheSaturatingAdd(_overridableSectionTagCount, analyzer.overridableSectionTagCount);
+    _filterCallCount = GRMustacheSaturatingAdd(_filterCallCount, analyzer.filterCallCount);
+    _maximumSectionDepth = MAX(_maximumSectionDepth, _sectionDepth + analyzer.maximumSectionDepth);
+    _maximumPartialFanOut = MAX(_maximumPartialFanOut, analyzer.maximumPartialFanOut);
+    _maximumPartialDepth = MAX(_maximumPartialDepth, 1 + analyzer.maximumPartialDepth);
+    _maximumOverrideDepth = MAX(_maximumOverrideDepth, (overridden ? 1 : 0) + analyzer.maximumOverrideDepth);
+    _hasRecursivePartials = _hasRecursivePartials || analyzer.hasRecursivePartials;
+    _cost += _multiplier * analyzer.cost;
+}
+
+- (void)visitComponents:(NSArray *)components
+{
+    for (id<GRMustacheTemplateComponent> component in components) {
+        [component acceptTemplateComponentVisitor:self];
+    }
+}
+
+- (void)visitExpression:(GRMustacheExpression *)expression
+{
+    GRMustacheExpressionStringifier *stringifier = [[[GRMustacheExpressionStringifier alloc] init] autorelease];
+    [stringifier stringWithExpression:expression];
+    _filterCallCount = GRMustacheSaturatingAdd(_filterCallCount, stringifier.filterCallCount);
+    _cost += _multiplier * (1 + stringifier.filterCallCount);   // one tag evaluation, plus filter calls
+}
+
+
+#pragma mark <GRMustacheTemplateComponentVisitor>
+
+- (void)visitTemplate:(GRMustacheTemplate *)template
+{
+    // Partial tag
+    [self includeTemplate:template overridden:NO];
+}
+
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride
+{
+    [self includeTemplate:templateOverride.template overridden:YES];
+    [self visitComponents:templateOverride.components];
+}
+
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag
+{
+    [self visitExpression:sectionTag.expression];
+    
+    double cardinality = 1;
+    switch (sectionTag.type) {
+        case GRMustacheTagTypeSection: {
+            _sectionTagCount = GRMustacheSaturatingAdd(_sectionTagCount, 1);
+            NSNumber *number = [_cardinalities objectForKey:[GRMustacheTemplateAnalysis stringWithExpression:sectionTag.expression]];
+            cardinality = number ? [number doubleValue] : _defaultCardinality;
+        } break;
+            
+        case GRMustacheTagTypeInvertedSection:
+            _invertedSectionTagCount = GRMustacheSaturatingAdd(_invertedSectionTagCount, 1);
+            break;
+            
+        case GRMustacheTagTypeOverridableSection:
+            _overridableSectionTagCount = GRMustacheSaturatingAdd(_overridableSectionTagCount, 1);
+            break;
+            
+        default:
+            break;
+    }
+    
+    double multiplier = _multiplier;
+    _multiplier *= cardinality;
+    _sectionDepth += 1;
+    _maximumSectionDepth = MAX(_maximumSectionDepth, _sectionDepth);
+    [self visitComponents:sectionTag.components];
+    _sectionDepth -= 1;
+    _multiplier = multiplier;
+}
+
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag
+{
+    _variableTagCount = GRMustacheSaturatingAdd(_variableTagCount, 1);
+    [self visitExpression:variableTag.expression];
+}
+
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent
+{
+    // Text is not an operation.
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheKeyPathExtractor
+
+/**
+ * Extracts the key paths read by an expression, as arrays of identifiers:
+ * `user.name` gives `(user, name)`, and `f(x.y)` gives `(f)` and `(x, y)`.
+ *
+ * The keyPath property contains the key path of the value of the expression,
+ * if any: `f(x.y)` has the `(x, y)` key path, since filters usually derive
+ * their result from their argument. The implicit iterator `.` has the empty
+ * key path. Loop metadata such as `@index` have no key path.
+ */
+@interface GRMustacheKeyPathExtractor : NSObject<GRMustacheExpressionVisitor> {
+@private
+    NSMutableArray *_keyPaths;
+    NSArray *_keyPath;
+}
+@property (nonatomic, retain, readonly) NSMutableArray *keyPaths;
+@property (nonatomic, retain) NSArray *keyPath;
+- (void)extractKeyPathsFromExpression:(GRMustacheExpression *)expression;
+@end
+
+@implementation GRMustacheKeyPathExtractor
+@synthesize keyPaths=_keyPaths;
+@synthesize keyPath=_keyPath;
+
+- (void)dealloc
+{
+    [_keyPaths release];
+    [_keyPath release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _keyPaths = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)extractKeyPathsFromExpression:(GRMustacheExpression *)expression
+{
+    [expression acceptExpressionVisitor:self];
+    if (_keyPath.count > 0) {
+        [_keyPaths addObject:_keyPath];
+    }
+}
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    [self extractKeyPathsFromExpression:expression.filterExpression];
+    [expression.argumentExpression acceptExpressionVisitor:self];
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    NSString *identifier = expression.identifier;
+    if (identifier.length > 0 && [identifier characterAtIndex:0] == '@') {
+        self.keyPath = nil;
+    } else {
+        self.keyPath = [NSArray arrayWithObject:identifier];
+    }
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+    self.keyPath = [NSArray array];
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    [expression.baseExpression acceptExpressionVisitor:self];
+    if (_keyPath) {
+        self.keyPath = [_keyPath arrayByAddingObject:expression.scopeIdentifier];
+    }
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheDataRequirementsCollector
+
+/**
+ * Collects the data requirements of a single template, and merges the
+ * requirements of the partials it embeds.
+ *
+ * Requirements are trees of mutable dictionaries: keys are identifiers, and
+ * values are the requirements of the values of those identifiers. The content
+ * of a section is collected in the node of the section expression.
+ *
+ * Collectors are memoized by template, so that a partial embedded many times
+ * is walked once.
+ *
+ * A recursive partial is included while its collection is not complete: the
+ * including scope is recorded, and receives the requirements of the partial
+ * once they are complete. Recursion is thus unrolled once.
+ */
+@interface GRMustacheDataRequirementsCollector : NSObject<GRMustacheTemplateComponentVisitor> {
+@private
+    NSMapTable *_collectorForTemplate;
+    NSMutableDictionary *_requirements;
+    NSMutableDictionary *_scope;
+    NSMutableArray *_pendingScopes;
+    BOOL _complete;
+}
+@property (nonatomic, readonly) BOOL complete;
+@property (nonatomic, retain, readonly) NSMutableDictionary *requirements;
+- (id)initWithCollectorForTemplate:(NSMapTable *)collectorForTemplate;
+- (void)collectTemplate:(GRMustacheTemplate *)template;
+- (void)includeTemplate:(GRMustacheTemplate *)template;
+- (void)visitComponents:(NSArray *)components;
++ (NSMutableDictionary *)nodeForKeyPath:(NSArray *)keyPath inRequirements:(NSMutableDictionary *)requirements;
++ (void)mergeRequirements:(NSDictionary *)requirements intoRequirements:(NSMutableDictionary *)targetRequirements;
++ (NSDictionary *)immutableRequirements:(NSDictionary *)requirements;
+@end
+
+@implementation GRMustacheDataRequirementsCollector
+@synthesize complete=_complete;
+@synthesize requirements=_requirements;
+
+- (void)dealloc
+{
+    [_requirements release];
+    [_pendingScopes release];
+    [super dealloc];
+}
+
+- (id)initWithCollectorForTemplate:(NSMapTable *)collectorForTemplate
+{
+    self = [super init];
+    if (self) {
+        _collectorForTemplate = collectorForTemplate;   // do not retain, since collectorForTemplate retains self.
+        _requirements = [[NSMutableDictionary alloc] init];
+        _pendingScopes = [[NSMutableArray alloc] init];
+        _scope = _requirements;
+    }
+    return self;
+}
+
+- (void)collectTemplate:(GRMustacheTemplate *)template
+{
+    [self visitComponents:template.components];
+    _complete = YES;
+    
+    // Pending scopes may be nodes of our own requirements: merge a copy.
+    NSDictionary *requirements = [GRMustacheDataRequirementsCollector immutableRequirements:_requirements];
+    for (NSMutableDictionary *scope in _pendingScopes) {
+        [GRMustacheDataRequirementsCollector mergeRequirements:requirements intoRequirements:scope];
+    }
+    [_pendingScopes removeAllObjects];
+}
+
+- (void)includeTemplate:(GRMustacheTemplate *)template
+{
+    GRMustacheDataRequirementsCollector *collector = [_collectorForTemplate objectForKey:template];
+    if (collector == nil) {
+        collector = [[[GRMustacheDataRequirementsCollector alloc] initWithCollectorForTemplate:_collectorForTemplate] autorelease];
+        [_collectorForTemplate setObject:collector forKey:template];
+        [collector collectTemplate:template];
+    }
+    
+    if (!collector.complete) {
+        // The template is being collected: this is a recursive partial.
+        [collector->_pendingScopes addObject:_scope];
+        return;
+    }
+    
+    [GRMustacheDataRequirementsCollector mergeRequirements:collector.requirements intoRequirements:_scope];
+}
+
+- (void)visitComponents:(NSArray *)components
+{
+    for (id<GRMustacheTemplateComponent> component in components) {
+        [component acceptTemplateComponentVisitor:self];
+    }
+}
+
++ (NSMutableDictionary *)nodeForKeyPath:(NSArray *)keyPath inRequirements:(NSMutableDictionary *)requirements
+{
+    NSMutableDictionary *node = requirements;
+    for (NSString *identifier in keyPath) {
+        NSMutableDictionary *child = [node objectForKey:identifier];
+        if (child == nil) {
+            child = [NSMutableDictionary dictionary];
+            [node setObject:child forKey:identifier];
+        }
+        node = child;
+    }
+    return node;
+}
+
++ (void)mergeRequirements:(NSDictionary *)requirements intoRequirements:(NSMutableDictionary *)targetRequirements
+{
+    for (NSString *identifier in requirements) {
+        NSMutableDictionary *node = [self nodeForKeyPath:[NSArray arrayWithObject:identifier] inRequirements:targetRequirements];
+        [self mergeRequirements:[requirements objectForKey:identifier] intoRequirements:node];
+    }
+}
+
++ (NSDictionary *)immutableRequirements:(NSDictionary *)requirements
+{
+    NSMutableDictionary *immutableRequirements = [NSMutableDictionary dictionaryWithCapacity:requirements.count];
+    for (NSString *identifier in requirements) {
+        [immutableRequirements setObject:[self immutableRequirements:[requirements objectForKey:identifier]] forKey:identifier];
+    }
+    return [[immutableRequirements copy] autorelease];
+}
+
+
+#pragma mark <GRMustacheTemplateComponentVisitor>
+
+- (void)visitTemplate:(GRMustacheTemplate *)template
+{
+    // Partial tag
+    [self includeTemplate:template];
+}
+
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride
+{
+    [self includeTemplate:templateOverride.template];
+    [self visitComponents:templateOverride.components];
+}
+
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag
+{
+    GRMustacheKeyPathExtractor *extractor = [[[GRMustacheKeyPathExtractor alloc] init] autorelease];
+    [extractor extractKeyPathsFromExpression:sectionTag.expression];
+    for (NSArray *keyPath in extractor.keyPaths) {
+        [GRMustacheDataRequirementsCollector nodeForKeyPath:keyPath inRequirements:_scope];
+    }
+    
+    // Inverted sections render their content in the same context: other
+    // sections push their value on top of the context stack.
+    NSMutableDictionary *scope = _scope;
+    if (sectionTag.type != GRMustacheTagTypeInvertedSection && extractor.keyPath) {
+        _scope = [GRMustacheDataRequirementsCollector nodeForKeyPath:extractor.keyPath inRequirements:_scope];
+    }
+    [self visitComponents:sectionTag.components];
+    _scope = scope;
+}
+
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag
+{
+    GRMustacheKeyPathExtractor *extractor = [[[GRMustacheKeyPathExtractor alloc] init] autorelease];
+    [extractor extractKeyPathsFromExpression:variableTag.expression];
+    for (NSArray *keyPath in extractor.keyPaths) {
+        [GRMustacheDataRequirementsCollector nodeForKeyPath:keyPath inRequirements:_scope];
+    }
+}
+
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent
+{
+    // Text does not read any data.
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheTemplateAnalysis
+
+@interface GRMustacheTemplateAnalysis()
+- (id)initWithTemplate:(GRMustacheTemplate *)template;
+@end
+
+@implementation GRMustacheTemplateAnalysis
+@synthesize variableTagCount=_variableTagCount;
+@synthesize sectionTagCount=_sectionTagCount;
+@synthesize invertedSectionTagCount=_invertedSectionTagCount;
+@synthesize overridableSectionTagCount=_overridableSectionTagCount;
+@synthesize filterCallCount=_filterCallCount;
+@synthesize maximumSectionDepth=_maximumSectionDepth;
+@synthesize partialCount=_partialCount;
+@synthesize maximumPartialFanOut=_maximumPartialFanOut;
+@synthesize maximumPartialDepth=_maximumPartialDepth;
+@synthesize hasRecursivePartials=_hasRecursivePartials;
+@synthesize maximumOverrideDepth=_maximumOverrideDepth;
+
++ (instancetype)analysisWithTemplate:(GRMustacheTemplate *)template
+{
+    return [[[self alloc] initWithTemplate:template] autorelease];
+}
+
++ (NSString *)stringWithExpression:(GRMustacheExpression *)expression
+{
+    GRMustacheExpressionStringifier *stringifier = [[[GRMustacheExpressionStringifier alloc] init] autorelease];
+    return [stringifier stringWithExpression:expression];
+}
+
+- (void)dealloc
+{
+    [_template release];
+    [super dealloc];
+}
+
+- (id)initWithTemplate:(GRMustacheTemplate *)template
+{
+    if (!template) {
+        [self release];
+        [NSException raise:NSInvalidArgumentException format:@"Invalid template:nil"];
+        return nil;
+    }
+    
+    self = [super init];
+    if (self) {
+        _template = [template retain];
+        
+        @autoreleasepool {
+            NSMapTable *analyzerForTemplate = [GRMustacheTemplateAnalyzer analyzerForTemplateMapTable];
+            GRMustacheTemplateAnalyzer *analyzer = [[[GRMustacheTemplateAnalyzer alloc] initWithAnalyzerForTemplate:analyzerForTemplate cardinalities:nil defaultCardinality:1] autorelease];
+            [analyzerForTemplate setObject:analyzer forKey:template];
+            [analyzer analyzeTemplate:template];
+            
+            _variableTagCount = analyzer.variableTagCount;
+            _sectionTagCount = analyzer.sectionTagCount;
+            _invertedSectionTagCount = analyzer.invertedSectionTagCount;
+            _overridableSectionTagCount = analyzer.overridableSectionTagCount;
+            _filterCallCount = analyzer.filterCallCount;
+            _maximumSectionDepth = analyzer.maximumSectionDepth;
+            _partialCount = analyzerForTemplate.count - 1;  // all analyzed templates but the analyzed one
+            _maximumPartialFanOut = analyzer.maximumPartialFanOut;
+            _maximumPartialDepth = analyzer.maximumPartialDepth;
+            _hasRecursivePartials = analyzer.hasRecursivePartials;
+            _maximumOverrideDepth = analyzer.maximumOverrideDepth;
+        }
+    }
+    return self;
+}
+
+- (double)estimatedCostWithCardinalities:(NSDictionary *)cardinalities defaultCardinality:(double)defaultCardinality
+{
+    double cost = 0;
+    @autoreleasepool {
+        NSMapTable *analyzerForTemplate = [GRMustacheTemplateAnalyzer analyzerForTemplateMapTable];
+        GRMustacheTemplateAnalyzer *analyzer = [[[GRMustacheTemplateAnalyzer alloc] initWithAnalyzerForTemplate:analyzerForTemplate cardinalities:cardinalities defaultCardinality:defaultCardinality] autorelease];
+        [analyzerForTemplate setObject:analyzer forKey:_template];
+        [analyzer analyzeTemplate:_template];
+        cost = analyzer.cost;
+    }
+    return cost;
+}
+
+- (NSDictionary *)dataRequirements
+{
+    NSDictionary *dataRequirements = nil;
+    @autoreleasepool {
+        NSMapTable *collectorForTemplate = [GRMustacheTemplateAnalyzer analyzerForTemplateMapTable];
+        GRMustacheDataRequirementsCollector *collector = [[[GRMustacheDataRequirementsCollector alloc] initWithCollectorForTemplate:collectorForTemplate] autorelease];
+        [collectorForTemplate setObject:collector forKey:_template];
+        [collector collectTemplate:_template];
+        dataRequirements = [[GRMustacheDataRequirementsCollector immutableRequirements:collector.requirements] retain];
+    }
+    return [dataRequirements autorelease];
+}
+
+@end
@@ -0,0 +1,100 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+
+@class GRMustacheTemplate;
+@class GRMustacheExpression;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@interface GRMustacheTemplateAnalysis : NSObject {
+@private
+    GRMustacheTemplate *_template;
+    NSUInteger _variableTagCount;
+    NSUInteger _sectionTagCount;
+    NSUInteger _invertedSectionTagCount;
+    NSUInteger _overridableSectionTagCount;
+    NSUInteger _filterCallCount;
+    NSUInteger _maximumSectionDepth;
+    NSUInteger _partialCount;
+    NSUInteger _maximumPartialFanOut;
+    NSUInteger _maximumPartialDepth;
+    BOOL _hasRecursivePartials;
+    NSUInteger _maximumOverrideDepth;
+}
+
+// Documented in GRMustacheTemplateAnalysis.h
++ (instancetype)analysisWithTemplate:(GRMustacheTemplate *)template GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger variableTagCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger sectionTagCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger invertedSectionTagCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger overridableSectionTagCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger filterCallCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger maximumSectionDepth GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger partialCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger maximumPartialFanOut GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger maximumPartialDepth GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) BOOL hasRecursivePartials GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+@property (nonatomic, readonly) NSUInteger maximumOverrideDepth GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+- (double)estimatedCostWithCardinalities:(NSDictionary *)cardinalities defaultCardinality:(double)defaultCardinality GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateAnalysis.h
+- (NSDictionary *)dataRequirements GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Returns the canonical string of an expression, as used for the keys of the
+ * cardinalities dictionary: `name`, `.`, `a.b`, `f(x)`, `f(x,y)`, etc.
+ *
+ * @param expression  An expression.
+ *
+ * @return A string.
+ *
+ * @see estimatedCostWithCardinalities:defaultCardinality:
+ */
++ (NSString *)stringWithExpression:(GRMustacheExpression *)expression GRMUSTACHE_API_INTERNAL;
+
+@end
@@ -0,0 +1,104 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+/**
+ * A GRMustacheTemplateCache shares the parsing of template strings between
+ * template repositories.
+ *
+ * Template repositories whose configurations share the same template cache
+ * parse each template string only once per process, as long as the template
+ * string, its template ID, and the tag delimiters of the configuration are
+ * identical. Only the parsing is shared: each repository still compiles its
+ * own templates from the shared tokens, so that tags keep on referring to
+ * their own repository, base context, and content type.
+ *
+ * A template cache keeps at most maximumTemplateCount parsings, and forgets
+ * the least recently used ones first. Template strings that are not loaded
+ * from a data source (see [GRMustacheTemplateRepository
+ * templateFromString:error:]) are cached as well, and count against this
+ * limit.
+ *
+ * A template cache also keeps the template strings of the templates that
+ * repositories load from remote URLs (see [GRMustacheTemplateRepository
+ * templateRepositoryWithBaseURL:]), along with their HTTP validators. A
+ * repository that loads a template already loaded by another repository
+ * sends conditional requests for this template and the partials it has used
+ * so far, in parallel, and does not parse the templates that have not changed.
+ *
+ * A template cache is thread-safe.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/configuration.md
+ *
+ * @see [GRMustacheConfiguration templateCache]
+ *
+ * @since v6.5
+ */
+@interface GRMustacheTemplateCache : NSObject {
+@private
+    NSMutableDictionary *_parsedTemplateForKey;
+    NSMutableDictionary *_remoteTemplateForURL;
+    NSUInteger _maximumTemplateCount;
+    uint64_t _useStamp;
+}
+
+/**
+ * @return A new empty template cache.
+ *
+ * @since v6.5
+ */
++ (instancetype)templateCache AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The number of template strings parsed by the receiver.
+ *
+ * Remote templates are not counted.
+ *
+ * @since v6.5
+ */
+@property (nonatomic, readonly) NSUInteger count AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * The maximum number of template strings whose parsing is kept by the
+ * receiver. Its default value is 1000.
+ *
+ * When this number is reached, the least recently used parsings are forgotten
+ * first. When it is 0, no parsing is kept.
+ *
+ * Remote templates are not counted.
+ *
+ * @since v6.5
+ */
+@property (nonatomic) NSUInteger maximumTemplateCount AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Empties the receiver, including its remote templates.
+ *
+ * Templates that have already been compiled are not affected.
+ *
+ * @since v6.5
+ */
+- (void)removeAllTemplates AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
@@ -0,0 +1,370 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheTemplateCache_private.h"
+#import "GRMustacheRemoteTemplate_private.h"
+#import "GRMustacheConfiguration_private.h"
+
+
+// =============================================================================
+#pragma mark - GRMustacheTemplateCacheKey
+
+/**
+ * The keys of a template cache.
+ *
+ * NSArray can not be used, since its hash is its count.
+ */
+@interface GRMustacheTemplateCacheKey : NSObject<NSCopying> {
+@private
+    NSString *_templateString;
+    id _templateID;
+    NSString *_tagStartDelimiter;
+    NSString *_tagEndDelimiter;
+}
+- (id)initWithTemplateString:(NSString *)templateString templateID:(id)templateID configuration:(GRMustacheConfiguration *)configuration;
+@end
+
+@implementation GRMustacheTemplateCacheKey
+
+- (void)dealloc
+{
+    [_templateString release];
+    [_templateID release];
+    [_tagStartDelimiter release];
+    [_tagEndDelimiter release];
+    [super dealloc];
+}
+
+- (id)initWithTemplateString:(NSString *)templateString templateID:(id)templateID configuration:(GRMustacheConfiguration *)configuration
+{
+    self = [super init];
+    if (self) {
+        _templateString = [templateString copy];
+        _templateID = [templateID retain];
+        _tagStartDelimiter = [configuration.tagStartDelimiter retain];
+        _tagEndDelimiter = [configuration.tagEndDelimiter retain];
+    }
+    return self;
+}
+
+- (NSUInteger)hash
+{
+    return [_templateString hash] ^ [_templateID hash] ^ [_tagStartDelimiter hash];
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (object == self) {
+        return YES;
+    }
+    if (![object isKindOfClass:[GRMustacheTemplateCacheKey class]]) {
+        return NO;
+    }
+    GRMustacheTemplateCacheKey *other = object;
+    return ((_templateID == other->_templateID || [_templateID isEqual:other->_templateID]) &&
+            [_tagStartDelimiter isEqualToString:other->_tagStartDelimiter] &&
+            [_tagEndDelimiter isEqualToString:other->_tagEndDelimiter] &&
+            [_templateString isEqualToString:other->_templateString]);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // immutable
+    return [self retain];
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheParsedTemplate
+
+/**
+ * The values of a template cache: the tokens of a template string.
+ *
+ * Tokens do not retain their text, expression, partial name and pragma. The
+ * parsed template retains them instead.
+ */
+@interface GRMustacheParsedTemplate : NSObject {
+@private
+    NSMutableArray *_tokens;
+    NSMutableArray *_tokenObjects;
+    uint64_t _useStamp;
+}
+@property (nonatomic, readonly) NSArray *tokens;
+@property (nonatomic) uint64_t useStamp;
+- (void)addToken:(GRMustacheToken *)token;
+@end
+
+@implementation GRMustacheParsedTemplate
+@synthesize tokens=_tokens;
+@synthesize useStamp=_useStamp;
+
+- (void)dealloc
+{
+    [_tokens release];
+    [_tokenObjects release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _tokens = [[NSMutableArray alloc] init];
+        _tokenObjects = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)addToken:(GRMustacheToken *)token
+{
+    [_tokens addObject:token];
+    if (token.text) [_tokenObjects addObject:token.text];
+    if (token.expression) [_tokenObjects addObject:token.expression];
+    if (token.partialName) [_tokenObjects addObject:token.partialName];
+    if (token.pragma) [_tokenObjects addObject:token.pragma];
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheParsedTemplateRecorder
+
+/**
+ * The GRMustacheParsedTemplateRecorder records the tokens of a parser into a
+ * parsed template, and forwards them to another parser delegate.
+ */
+@interface GRMustacheParsedTemplateRecorder : NSObject<GRMustacheParserDelegate> {
+@private
+    id<GRMustacheParserDelegate> _delegate;
+    GRMustacheParsedTemplate *_parsedTemplate;
+    BOOL _interrupted;
+}
+@property (nonatomic, readonly) GRMustacheParsedTemplate *parsedTemplate;
+@property (nonatomic, readonly, getter = isInterrupted) BOOL interrupted;
+- (id)initWithDelegate:(id<GRMustacheParserDelegate>)delegate;
+@end
+
+@implementation GRMustacheParsedTemplateRecorder
+@synthesize parsedTemplate=_parsedTemplate;
+@synthesize interrupted=_interrupted;
+
+- (void)dealloc
+{
+    [_parsedTemplate release];
+    [super dealloc];
+}
+
+- (id)initWithDelegate:(id<GRMustacheParserDelegate>)delegate
+{
+    self = [super init];
+    if (self) {
+        _delegate = delegate;   // do not retain, since the delegate outlives self.
+        _parsedTemplate = [[GRMustacheParsedTemplate alloc] init];
+    }
+    return self;
+}
+
+- (BOOL)parser:(GRMustacheParser *)parser shouldContinueAfterParsingToken:(GRMustacheToken *)token
+{
+    [_parsedTemplate addToken:token];
+    if ([_delegate respondsToSelector:@selector(parser:shouldContinueAfterParsingToken:)] && ![_delegate parser:parser shouldContinueAfterParsingToken:token]) {
+        _interrupted = YES;
+        return NO;
+    }
+    return YES;
+}
+
+- (void)parser:(GRMustacheParser *)parser didFailWithError:(NSError *)error
+{
+    _interrupted = YES;
+    if ([_delegate respondsToSelector:@selector(parser:didFailWithError:)]) {
+        [_delegate parser:parser didFailWithError:error];
+    }
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheTemplateCache
+
+@interface GRMustacheTemplateCache()
+- (void)removeLeastRecentlyUsedParsedTemplate;
+@end
+
+@implementation GRMustacheTemplateCache
+@synthesize maximumTemplateCount=_maximumTemplateCount;
+
++ (instancetype)templateCache
+{
+    return [[[self alloc] init] autorelease];
+}
+
+- (void)dealloc
+{
+    [_parsedTemplateForKey release];
+    [_remoteTemplateForURL release];
+    [super dealloc];
+}
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _parsedTemplateForKey = [[NSMutableDictionary alloc] init];
+        _remoteTemplateForURL = [[NSMutableDictionary alloc] init];
+        _maximumTemplateCount = 1000;
+    }
+    return self;
+}
+
+- (void)setMaximumTemplateCount:(NSUInteger)maximumTemplateCount
+{
+    @synchronized(self) {
+        _maximumTemplateCount = maximumTemplateCount;
+        while (_parsedTemplateForKey.count > _maximumTemplateCount) {
+            [self removeLeastRecentlyUsedParsedTemplate];
+        }
+    }
+}
+
+- (NSUInteger)count
+{
+    @synchronized(self) {
+        return _parsedTemplateForKey.count;
+    }
+}
+
+- (void)removeAllTemplates
+{
+    @synchronized(self) {
+        [_parsedTemplateForKey removeAllObjects];
+        [_remoteTemplateForURL removeAllObjects];
+    }
+}
+
+- (void)parseTemplateString:(NSString *)templateString templateID:(id)templateID configuration:(GRMustacheConfiguration *)configuration delegate:(id<GRMustacheParserDelegate>)delegate
+{
+    GRMustacheTemplateCacheKey *key = [[[GRMustacheTemplateCacheKey alloc] initWithTemplateString:templateString templateID:templateID configuration:configuration] autorelease];
+    
+    GRMustacheParsedTemplate *parsedTemplate = nil;
+    @synchronized(self) {
+        parsedTemplate = [[[_parsedTemplateForKey objectForKey:key] retain] autorelease];
+        parsedTemplate.useStamp = ++_useStamp;
+    }
+    
+    if (parsedTemplate) {
+        // Replay cached tokens
+        if ([delegate respondsToSelector:@selector(parser:shouldContinueAfterParsingToken:)]) {
+            for (GRMustacheToken *token in parsedTemplate.tokens) {
+                if (![delegate parser:nil shouldContinueAfterParsingToken:token]) {
+                    break;
+                }
+            }
+        }
+        return;
+    }
+    
+    // Parse, and cache complete parsings only. Concurrent parsings of the same
+    // template string may happen: the last one wins.
+    GRMustacheParsedTemplateRecorder *recorder = [[[GRMustacheParsedTemplateRecorder alloc] initWithDelegate:delegate] autorelease];
+    GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:configuration] autorelease];
+    parser.delegate = recorder;
+    [parser parseTemplateString:templateString templateID:templateID];
+    
+    if (!recorder.isInterrupted) {
+        @synchronized(self) {
+            if (_maximumTemplateCount == 0) {
+                return;
+            }
+            if ([_parsedTemplateForKey objectForKey:key] == nil) {
+                while (_parsedTemplateForKey.count >= _maximumTemplateCount) {
+                    [self removeLeastRecentlyUsedParsedTemplate];
+                }
+            }
+            recorder.parsedTemplate.useStamp = ++_useStamp;
+            [_parsedTemplateForKey setObject:recorder.parsedTemplate forKey:key];
+        }
+    }
+}
+
+- (GRMustacheRemoteTemplate *)remoteTemplateForURL:(NSURL *)URL
+{
+    @synchronized(self) {
+        return [[[_remoteTemplateForURL objectForKey:URL] retain] autorelease];
+    }
+}
+
+- (NSArray *)remoteTemplateClosureForURL:(NSURL *)URL
+{
+    NSMutableArray *closure = [NSMutableArray array];
+    NSMutableSet *visitedURLs = [NSMutableSet set];
+    NSMutableArray *pendingURLs = [NSMutableArray arrayWithObject:URL];
+    while (pendingURLs.count > 0) {
+        NSURL *pendingURL = [pendingURLs lastObject];
+        [pendingURLs removeLastObject];
+        if ([visitedURLs containsObject:pendingURL]) {
+            continue;
+        }
+        [visitedURLs addObject:pendingURL];
+        
+        GRMustacheRemoteTemplate *remoteTemplate = [self remoteTemplateForURL:pendingURL];
+        if (remoteTemplate) {
+            [closure addObject:remoteTemplate];
+            [pendingURLs addObjectsFromArray:remoteTemplate.partialURLs];
+        }
+    }
+    return closure;
+}
+
+- (void)setRemoteTemplate:(GRMustacheRemoteTemplate *)remoteTemplate
+{
+    @synchronized(self) {
+        [_remoteTemplateForURL setObject:remoteTemplate forKey:remoteTemplate.URL];
+    }
+}
+
+
+
+#pragma mark - Private
+
+- (void)removeLeastRecentlyUsedParsedTemplate
+{
+    // Eviction only happens when the cache is full, and scans it: this keeps
+    // cache hits cheap.
+    __block id leastRecentlyUsedKey = nil;
+    __block uint64_t leastRecentUseStamp = UINT64_MAX;
+    [_parsedTemplateForKey enumerateKeysAndObjectsUsingBlock:^(id key, GRMustacheParsedTemplate *parsedTemplate, BOOL *stop) {
+        if (parsedTemplate.useStamp < leastRecentUseStamp) {
+            leastRecentUseStamp = parsedTemplate.useStamp;
+            leastRecentlyUsedKey = key;
+        }
+    }];
+    if (leastRecentlyUsedKey) {
+        [_parsedTemplateForKey removeObjectForKey:leastRecentlyUsedKey];
+    }
+}
+
+@end
@@ -0,0 +1,98 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+#import "GRMustacheParser_private.h"
+
+@class GRMustacheConfiguration;
+@class GRMustacheRemoteTemplate;
+
+// Documented in GRMustacheTemplateCache.h
+@interface GRMustacheTemplateCache : NSObject {
+@private
+    NSMutableDictionary *_parsedTemplateForKey;
+    NSMutableDictionary *_remoteTemplateForURL;
+    NSUInteger _maximumTemplateCount;
+    uint64_t _useStamp;
+}
+
+// Documented in GRMustacheTemplateCache.h
++ (instancetype)templateCache GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateCache.h
+@property (nonatomic, readonly) NSUInteger count GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateCache.h
+@property (nonatomic) NSUInteger maximumTemplateCount GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateCache.h
+- (void)removeAllTemplates GRMUSTACHE_API_PUBLIC;
+
+/**
+ * Feeds a parser delegate with the tokens of a template string.
+ *
+ * If the template string has already been parsed with the same template ID and
+ * tag delimiters, the cached tokens are sent to the delegate. Otherwise, the
+ * template string is parsed, and its tokens are cached if the parsing
+ * succeeded, and was not interrupted by the delegate. The least recently used
+ * tokens are forgotten when maximumTemplateCount is reached.
+ *
+ * @param templateString  A Mustache template string
+ * @param templateID      A template ID (see GRMustacheTemplateRepository)
+ * @param configuration   The GRMustacheConfiguration that affects the
+ *                        parsing phase.
+ * @param delegate        A parser delegate
+ *
+ * @see GRMustacheParser
+ */
+- (void)parseTemplateString:(NSString *)templateString templateID:(id)templateID configuration:(GRMustacheConfiguration *)configuration delegate:(id<GRMustacheParserDelegate>)delegate GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns the remote template loaded from an URL, or nil.
+ *
+ * @param URL  The URL of a remote template.
+ *
+ * @see GRMustacheRemoteTemplate
+ */
+- (GRMustacheRemoteTemplate *)remoteTemplateForURL:(NSURL *)URL GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Returns the remote template loaded from an URL, and the remote templates of
+ * its partials, recursively. Partials that are not in the cache are ignored.
+ *
+ * @param URL  The URL of a remote template.
+ *
+ * @return An array of GRMustacheRemoteTemplate, empty if there is no remote
+ *         template for URL.
+ */
+- (NSArray *)remoteTemplateClosureForURL:(NSURL *)URL GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Stores a remote template, replacing the previous remote template loaded from
+ * the same URL.
+ *
+ * @param remoteTemplate  A remote template.
+ */
+- (void)setRemoteTemplate:(GRMustacheRemoteTemplate *)remoteTemplate GRMUSTACHE_API_INTERNAL;
+
+@end
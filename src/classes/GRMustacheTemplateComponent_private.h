@@ -26,6 +26,12 @@
 
 @class GRMustacheContext;
 @class GRMustacheTemplateRepository;
+@class GRMustacheTemplate;
+@class GRMustacheTemplateOverride;
+@class GRMustacheSectionTag;
+@class GRMustacheVariableTag;
+@class GRMustacheTextComponent;
+@protocol GRMustacheTemplateComponentVisitor;
 
 /**
  * The protocol for "template components".
@@ -95,4 +101,39 @@
  * @see GRMustacheTemplateOverride
  */
 - (id<GRMustacheTemplateComponent>)resolveTemplateComponent:(id<GRMustacheTemplateComponent>)component GRMUSTACHE_API_INTERNAL;
+
+/**
+ * Sends to the visitor the visit message that matches the class of the
+ * receiver.
+ *
+ * @param visitor  A template component visitor.
+ *
+ * @see GRMustacheTemplateComponentVisitor
+ */
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor GRMUSTACHE_API_INTERNAL;
+@end
+
+
+/**
+ * The protocol for objects that walk the abstract tree built by
+ * GRMustacheCompiler, without knowing the concrete classes of the template
+ * components they visit.
+ *
+ * Visitors are responsible for visiting inner components, if they need to:
+ * the components of templates, template overrides, and section tags.
+ *
+ * Partial tags such as `{{> partial }}` are compiled into the partial template
+ * itself: visitTemplate: is thus sent for both the visited template, and for
+ * the partials it embeds. Visitors that descend into partials must be ready for
+ * recursive partials.
+ *
+ * @see [GRMustacheTemplateComponent acceptTemplateComponentVisitor:]
+ */
+@protocol GRMustacheTemplateComponentVisitor<NSObject>
+@required
+- (void)visitTemplate:(GRMustacheTemplate *)template GRMUSTACHE_API_INTERNAL;
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride GRMUSTACHE_API_INTERNAL;
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag GRMUSTACHE_API_INTERNAL;
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag GRMUSTACHE_API_INTERNAL;
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent GRMUSTACHE_API_INTERNAL;
 @end
@@ -30,6 +30,7 @@
 
 @implementation GRMustacheTemplateOverride
 @synthesize template=_template;
+@synthesize components=_components;
 
 + (instancetype)templateOverrideWithTemplate:(GRMustacheTemplate *)template components:(NSArray *)components
 {
@@ -60,6 +61,11 @@
     return component;
 }
 
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    [visitor visitTemplateOverride:self];
+}
+
 
 #pragma mark - Private
 
@@ -51,6 +51,12 @@
  */
 @property (nonatomic, retain, readonly) GRMustacheTemplate *template GRMUSTACHE_API_INTERNAL;
 
+/**
+ * The components of the receiver, that may override components of the
+ * overriden template.
+ */
+@property (nonatomic, retain, readonly) NSArray *components GRMUSTACHE_API_INTERNAL;
+
 /**
  * Builds a GRMustacheTemplateOverride.
  *
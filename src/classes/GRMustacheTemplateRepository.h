@@ -27,6 +27,8 @@
 @class GRMustacheTemplate;
 @class GRMustacheTemplateRepository;
 @class GRMustacheConfiguration;
+@class GRMustacheMetrics;
+@class GRMustacheMemoryFootprint;
 
 /**
  * The protocol for a GRMustacheTemplateRepository's dataSource.
@@ -136,6 +138,8 @@
     NSMutableDictionary *_templateForTemplateID;
     id _currentlyParsedTemplateID;
     GRMustacheConfiguration *_configuration;
+    id _metrics;
+    id _missingTemplateCache;
 }
 
 
@@ -292,6 +296,14 @@
  *     // /path/to/templates/partials/achievements.mustache
  *     GRMustacheTemplate *template = [repository templateFromString:@"{{>partials/achievements}}" error:NULL];
  * 
+ * Remote templates (HTTP URLs, for example) are downloaded. When the
+ * configuration of the repository has a template cache, remote templates are
+ * stored in the cache along with their ETag and Last-Modified validators. Other
+ * repositories that share the cache send conditional requests, and revalidate
+ * a template and the partials it loaded in parallel. Templates that have not
+ * changed are not downloaded or parsed again. See
+ * [GRMustacheConfiguration templateCache].
+ * 
  * @param URL   the base URL where to look templates from.
  *
  * @return a GRMustacheTemplateRepository
@@ -425,6 +437,107 @@
  */
 + (instancetype)templateRepositoryWithDictionary:(NSDictionary *)templates AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER;
 
+/**
+ * Returns a GRMustacheTemplateRepository that loads Mustache template strings
+ * of extension .mustache, encoded in UTF8, from an archive built by the
+ * `src/bin/buildGRMustacheArchive` script.
+ *
+ * The archive is a single file that packs the templates of a directory, with
+ * an index. It is memory-mapped, and its index is loaded, when the repository
+ * is created: loading a template does not access the file system.
+ *
+ * Template and partial names are resolved as in repositories created with
+ * templateRepositoryWithDirectory:. For example:
+ *
+ *     // $ src/bin/buildGRMustacheArchive /path/to/templates templates.archive
+ *     GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:@"templates.archive" error:NULL];
+ *
+ *     // Returns a template for the file that was stored in
+ *     // /path/to/templates/profile.mustache
+ *     GRMustacheTemplate *template = [repository templateNamed:@"profile" error:NULL];
+ *
+ * @param path   The path of the archive.
+ * @param error  If there is an error reading the archive, upon return contains
+ *               an NSError object that describes the problem.
+ *
+ * @return a GRMustacheTemplateRepository, or nil if the archive could not be
+ *         read.
+ *
+ * @see templateRepositoryWithDirectory:
+ *
+ * @since v6.5
+ */
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns a GRMustacheTemplateRepository that loads Mustache template strings
+ * of provided extension, encoded in the provided encoding, from an archive
+ * built by the `src/bin/buildGRMustacheArchive` script.
+ *
+ * The archive must have been built with the same extension:
+ *
+ *     // $ src/bin/buildGRMustacheArchive --extension txt /path/to/templates templates.archive
+ *     GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:@"templates.archive"
+ *                                                                                               templateExtension:@"txt"
+ *                                                                                                        encoding:NSUTF8StringEncoding
+ *                                                                                                           error:NULL];
+ *
+ * @param path      The path of the archive.
+ * @param ext       The extension of template files.
+ * @param encoding  The encoding of template files.
+ * @param error     If there is an error reading the archive, upon return
+ *                  contains an NSError object that describes the problem.
+ *
+ * @return a GRMustacheTemplateRepository, or nil if the archive could not be
+ *         read.
+ *
+ * @see templateRepositoryWithArchiveAtPath:error:
+ *
+ * @since v6.5
+ */
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path templateExtension:(NSString *)ext encoding:(NSStringEncoding)encoding error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Packs the template files of provided extension stored in a directory into an
+ * archive, as the `src/bin/buildGRMustacheArchive` script does.
+ *
+ * The archive is written atomically: processes that load it with
+ * templateRepositoryWithArchiveAtPath:templateExtension:encoding:error: never
+ * see a partially written archive.
+ *
+ * Processes that load the same archive share its memory: the archive is mapped
+ * read-only, and templates whose characters are all single bytes keep their
+ * text in the mapping. Prefork servers can thus have a single process write
+ * the archive, for example in /dev/shm, and their workers load it:
+ *
+ *     // In the master process
+ *     [GRMustacheTemplateRepository writeArchiveWithDirectory:@"/path/to/templates"
+ *                                            templateExtension:@"mustache"
+ *                                                       toPath:@"/dev/shm/templates.archive"
+ *                                                        error:NULL];
+ *
+ *     // In worker processes
+ *     GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:@"/dev/shm/templates.archive" error:NULL];
+ *
+ * Template files are archived verbatim: the repository must be created with
+ * their encoding.
+ *
+ * @param directoryPath  The path of the directory that stores templates.
+ * @param ext            The extension of template files. An empty extension
+ *                       archives all files.
+ * @param path           The path of the archive.
+ * @param error          If there is an error reading templates or writing the
+ *                       archive, upon return contains an NSError object that
+ *                       describes the problem.
+ *
+ * @return YES if the archive could be written.
+ *
+ * @see templateRepositoryWithArchiveAtPath:templateExtension:encoding:error:
+ *
+ * @since v6.5
+ */
++ (BOOL)writeArchiveWithDirectory:(NSString *)directoryPath templateExtension:(NSString *)ext toPath:(NSString *)path error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @name Configuring Template Repositories
@@ -468,6 +581,51 @@
 @property (nonatomic, copy) GRMustacheConfiguration *configuration AVAILABLE_GRMUSTACHE_VERSION_6_2_AND_LATER;
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// @name Monitoring Template Repositories
+////////////////////////////////////////////////////////////////////////////////
+
+
+/**
+ * The metrics of the repository: template compilations, template cache hits
+ * and misses, and renderings of the templates built by the repository.
+ *
+ * Metrics can be read from any thread, without locking:
+ *
+ *     GRMustacheTemplateRepository *repo = ...;
+ *     NSDictionary *metrics = [repo.metrics dictionaryRepresentation];
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/template_repositories.md
+ *
+ * @see GRMustacheMetrics
+ *
+ * @since v6.5
+ */
+@property (nonatomic, retain, readonly) GRMustacheMetrics *metrics AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Returns a report of the memory retained by the templates cached by the
+ * repository: all templates and partials loaded by name.
+ *
+ * Templates built with templateFromString:error: are not cached, and are not
+ * included in the report. Use [GRMustacheTemplate memoryFootprint] for them.
+ *
+ * Objects shared by several templates, such as partials, are counted once.
+ *
+ * This method is not thread-safe: don't load templates from the repository
+ * while the report is computed.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/template_repositories.md
+ *
+ * @return A memory footprint.
+ *
+ * @see GRMustacheMemoryFootprint
+ *
+ * @since v6.5
+ */
+- (GRMustacheMemoryFootprint *)memoryFootprint AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @name Getting Templates out of a Repository
 ////////////////////////////////////////////////////////////////////////////////
@@ -509,4 +667,34 @@
  */
 - (GRMustacheTemplate *)templateFromString:(NSString *)templateString error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_0_AND_LATER;
 
+/**
+ * Returns a template built from the Mustache template read from an input
+ * stream.
+ *
+ * Use this method for templates that are too large to be loaded in memory as a
+ * single string. The stream is read and parsed in chunks. The source of the
+ * template is spooled to a temporary file, which is only read when the
+ * innerTemplateString of a section tag is required (see
+ * [GRMustacheTag innerTemplateString]).
+ *
+ *     NSInputStream *stream = [NSInputStream inputStreamWithFileAtPath:@"/path/to/report.mustache"];
+ *     GRMustacheTemplate *template = [repository templateFromStream:stream encoding:NSUTF8StringEncoding error:NULL];
+ *
+ * Partial tags such as `{{>partial}}` load partial templates as in
+ * templateFromString:error:.
+ *
+ * @param stream    An input stream, that is opened and closed by this method.
+ * @param encoding  The encoding of the stream.
+ * @param error     If there is an error reading the stream, loading or parsing
+ *                  template and partials, upon return contains an NSError
+ *                  object that describes the problem.
+ *
+ * @return a GRMustacheTemplate
+ *
+ * @see templateFromString:error:
+ *
+ * @since v6.5
+ */
+- (GRMustacheTemplate *)templateFromStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding error:(NSError **)error AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
 @end
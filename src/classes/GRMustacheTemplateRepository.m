@@ -25,9 +25,70 @@
 #import "GRMustacheCompiler_private.h"
 #import "GRMustacheError.h"
 #import "GRMustacheConfiguration_private.h"
+#import "GRMustacheMetrics_private.h"
+#import "GRMustacheInstrumentation_private.h"
+#import "GRMustacheMemoryFootprint_private.h"
+#import "GRMustacheMappedString_private.h"
+#import "GRMustacheTemplateCache_private.h"
+#import "GRMustacheRefetchableString_private.h"
+#import "GRMustacheMissingTemplateCache_private.h"
+#import "GRMustacheRemoteTemplate_private.h"
 
 static NSString* const GRMustacheDefaultExtension = @"mustache";
 
+// The first line of archives built by src/bin/buildGRMustacheArchive
+static NSString* const GRMustacheArchiveHeader = @"GRMustacheArchive 1";
+
+/**
+ * Returns the template ID stored by GRMustacheTemplateIDCacheStore(), or nil.
+ *
+ * Template ID caches memoize the resolution of template names, so that
+ * resolving an already resolved partial is a couple of hash lookups, and does
+ * not build any path or URL. They map base template IDs (NSNull for nil) to
+ * dictionaries of template IDs keyed by name.
+ */
+static id GRMustacheTemplateIDCacheLookup(NSMutableDictionary *cache, NSString *name, id baseTemplateID)
+{
+    return [[cache objectForKey:(baseTemplateID ?: [NSNull null])] objectForKey:name];
+}
+
+/**
+ * Stores a template ID in a template ID cache.
+ *
+ * @see GRMustacheTemplateIDCacheLookup
+ */
+static void GRMustacheTemplateIDCacheStore(NSMutableDictionary *cache, NSString *name, id baseTemplateID, id templateID)
+{
+    if (templateID == nil) {
+        return;
+    }
+    id baseKey = baseTemplateID ?: [NSNull null];
+    NSMutableDictionary *templateIDForName = [cache objectForKey:baseKey];
+    if (templateIDForName == nil) {
+        templateIDForName = [NSMutableDictionary dictionary];
+        [cache setObject:templateIDForName forKey:baseKey];
+    }
+    [templateIDForName setObject:templateID forKey:name];
+}
+
+
+/**
+ * Returns YES if the error tells that a template does not exist, rather than
+ * that it could not be loaded.
+ *
+ * @see [GRMustacheConfiguration missingTemplateLifetime]
+ */
+static BOOL GRMustacheErrorIsMissingTemplate(NSError *error)
+{
+    if ([error.domain isEqualToString:GRMustacheErrorDomain]) {
+        return error.code == GRMustacheErrorCodeTemplateNotFound;
+    }
+    if ([error.domain isEqualToString:NSCocoaErrorDomain]) {
+        return error.code == NSFileReadNoSuchFileError || error.code == NSFileNoSuchFileError;
+    }
+    return NO;
+}
+
 
 // =============================================================================
 #pragma mark - Private concrete class GRMustacheTemplateRepositoryBaseURL
@@ -39,10 +100,15 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 @interface GRMustacheTemplateRepositoryBaseURL : GRMustacheTemplateRepository {
 @private
     NSURL *_baseURL;
+    NSMutableDictionary *_templateIDCache;
     NSString *_templateExtension;
     NSStringEncoding _encoding;
+    NSMutableDictionary *_prefetchedRemoteTemplateForURL;
 }
 - (id)initWithBaseURL:(NSURL *)baseURL templateExtension:(NSString *)templateExtension encoding:(NSStringEncoding)encoding;
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID;
+- (NSString *)templateStringForRemoteURL:(NSURL *)URL error:(NSError **)error;
+- (void)prefetchRemoteTemplates:(NSArray *)cachedTemplates;
 @end
 
 
@@ -56,10 +122,12 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 @interface GRMustacheTemplateRepositoryDirectory : GRMustacheTemplateRepository {
 @private
     NSString *_directoryPath;
+    NSMutableDictionary *_templateIDCache;
     NSString *_templateExtension;
     NSStringEncoding _encoding;
 }
 - (id)initWithDirectory:(NSString *)directoryPath templateExtension:(NSString *)templateExtension encoding:(NSStringEncoding)encoding;
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID;
 @end
 
 
@@ -73,10 +141,12 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 @interface GRMustacheTemplateRepositoryBundle : GRMustacheTemplateRepository {
 @private
     NSBundle *_bundle;
+    NSMutableDictionary *_templateIDCache;
     NSString *_templateExtension;
     NSStringEncoding _encoding;
 }
 - (id)initWithBundle:(NSBundle *)bundle templateExtension:(NSString *)templateExtension encoding:(NSStringEncoding)encoding;
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID;
 @end
 
 
@@ -95,6 +165,38 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 @end
 
 
+// =============================================================================
+#pragma mark - Private concrete class GRMustacheTemplateRepositoryArchive
+
+/**
+ * Private subclass of GRMustacheTemplateRepository that is its own data source,
+ * and loads templates from a memory-mapped archive built by the
+ * src/bin/buildGRMustacheArchive script.
+ *
+ * An archive is made of:
+ *
+ * - the "GRMustacheArchive 1" line;
+ * - a line that contains the length of the index, in bytes;
+ * - the index: a JSON object whose keys are the paths of templates relative to
+ *   the archived directory, and values [offset, length] pairs of byte offsets
+ *   and lengths, relative to the end of the index;
+ * - the contents of templates.
+ *
+ * Template IDs are the keys of the index.
+ */
+@interface GRMustacheTemplateRepositoryArchive : GRMustacheTemplateRepository {
+@private
+    NSData *_archiveData;
+    NSDictionary *_rangeForTemplateID;
+    NSMutableDictionary *_templateIDCache;
+    NSString *_templateExtension;
+    NSStringEncoding _encoding;
+}
+- (id)initWithArchiveAtPath:(NSString *)path templateExtension:(NSString *)templateExtension encoding:(NSStringEncoding)encoding error:(NSError **)error;
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID;
+@end
+
+
 // =============================================================================
 #pragma mark - GRMustacheTemplateRepository
 
@@ -113,6 +215,14 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
  */
 - (GRMustacheTemplate *)templateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID error:(NSError **)error;
 
+/**
+ * Returns the ID of the template being compiled, or nil if no template is
+ * being compiled, or if it has no ID.
+ *
+ * Subclasses use it in order to know which template is loading a partial.
+ */
+- (id)currentlyParsedTemplateID;
+
 /**
  * Parses templateString and returns an abstract syntax tree.
  * 
@@ -128,11 +238,72 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
  */
 - (GRMustacheAST *)ASTFromString:(NSString *)templateString templateID:(id)templateID error:(NSError **)error;
 
+/**
+ * Returns a block that loads the template string of a template again, for
+ * templates that do not retain their template string.
+ *
+ * The block must not refer to the receiver, since templates may outlive their
+ * repository. Subclasses that are their own data source override this method.
+ *
+ * @param templateID  The template ID of a template loaded by the receiver.
+ *
+ * @return A template string loader, or nil if the template string can not be
+ *         loaded again without the receiver.
+ *
+ * @see [GRMustacheConfiguration retainsTemplateStrings]
+ */
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID;
+
+/**
+ * Remembers that a template could not be found, for the duration given by the
+ * missingTemplateLifetime property of the configuration.
+ *
+ * @param name            The name of the template
+ * @param baseTemplateID  The template ID of the enclosing template, or nil.
+ * @param error           The error that describes the missing template.
+ *
+ * @see [GRMustacheConfiguration missingTemplateLifetime]
+ */
+- (void)rememberMissingTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID error:(NSError *)error;
+
+/**
+ * Parses a template stream, and returns an abstract syntax tree.
+ *
+ * @param stream    An input stream.
+ * @param encoding  The encoding of the stream.
+ * @param error     If there is an error, upon return contains an NSError
+ *                  object that describes the problem.
+ *
+ * @return a GRMustacheAST instance.
+ *
+ * @see [GRMustacheParser parseTemplateStream:encoding:templateID:]
+ */
+- (GRMustacheAST *)ASTFromStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding error:(NSError **)error;
+
+/**
+ * Locks the configuration, creates a compiler, has the block feed it with
+ * tokens, and returns the abstract syntax tree built by the compiler.
+ *
+ * @param parse  A block that feeds the compiler.
+ * @param error  If there is an error, upon return contains an NSError object
+ *               that describes the problem.
+ *
+ * @return a GRMustacheAST instance.
+ */
+- (GRMustacheAST *)ASTByParsingWithBlock:(void(^)(GRMustacheCompiler *compiler))parse error:(NSError **)error;
+
+/**
+ * Returns a template that renders the components of an abstract syntax tree
+ * with the configuration of the receiver.
+ */
+- (GRMustacheTemplate *)templateWithAST:(GRMustacheAST *)AST;
+
 @end
 
 @implementation GRMustacheTemplateRepository
 @synthesize dataSource=_dataSource;
 @synthesize configuration=_configuration;
+@synthesize metrics=_metrics;
 
 + (instancetype)templateRepositoryWithBaseURL:(NSURL *)URL
 {
@@ -169,6 +340,58 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     return [[[GRMustacheTemplateRepositoryPartialsDictionary alloc] initWithPartialsDictionary:partialsDictionary] autorelease];
 }
 
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path error:(NSError **)error
+{
+    return [[[GRMustacheTemplateRepositoryArchive alloc] initWithArchiveAtPath:path templateExtension:GRMustacheDefaultExtension encoding:NSUTF8StringEncoding error:error] autorelease];
+}
+
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path templateExtension:(NSString *)ext encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    return [[[GRMustacheTemplateRepositoryArchive alloc] initWithArchiveAtPath:path templateExtension:ext encoding:encoding error:error] autorelease];
+}
+
++ (BOOL)writeArchiveWithDirectory:(NSString *)directoryPath templateExtension:(NSString *)ext toPath:(NSString *)path error:(NSError **)error
+{
+    NSFileManager *fileManager = [[[NSFileManager alloc] init] autorelease];
+    NSArray *subpaths = [fileManager subpathsOfDirectoryAtPath:directoryPath error:error];
+    if (!subpaths) {
+        return NO;
+    }
+    
+    // Same order as src/bin/buildGRMustacheArchive
+    subpaths = [subpaths sortedArrayUsingSelector:@selector(compare:)];
+    
+    NSMutableDictionary *index = [NSMutableDictionary dictionary];
+    NSMutableData *contents = [NSMutableData data];
+    for (NSString *subpath in subpaths) {
+        if (ext.length > 0 && ![[subpath pathExtension] isEqualToString:ext]) {
+            continue;
+        }
+        NSString *filePath = [directoryPath stringByAppendingPathComponent:subpath];
+        BOOL isDirectory;
+        if (![fileManager fileExistsAtPath:filePath isDirectory:&isDirectory] || isDirectory) {
+            continue;
+        }
+        NSData *data = [NSData dataWithContentsOfFile:filePath options:0 error:error];
+        if (!data) {
+            return NO;
+        }
+        [index setObject:[NSArray arrayWithObjects:[NSNumber numberWithUnsignedInteger:contents.length], [NSNumber numberWithUnsignedInteger:data.length], nil] forKey:subpath];
+        [contents appendData:data];
+    }
+    
+    NSData *indexData = [NSJSONSerialization dataWithJSONObject:index options:0 error:error];
+    if (!indexData) {
+        return NO;
+    }
+    
+    NSMutableData *archiveData = [NSMutableData data];
+    [archiveData appendData:[[NSString stringWithFormat:@"%@\n%lu\n", GRMustacheArchiveHeader, (unsigned long)indexData.length] dataUsingEncoding:NSUTF8StringEncoding]];
+    [archiveData appendData:indexData];
+    [archiveData appendData:contents];
+    return [archiveData writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
 + (instancetype)templateRepository
 {
     return [[[GRMustacheTemplateRepository alloc] init] autorelease];
@@ -179,6 +402,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     self = [super init];
     if (self) {
         _templateForTemplateID = [[NSMutableDictionary alloc] init];
+        _metrics = [[GRMustacheMetrics alloc] init];
         self.configuration = [GRMustacheConfiguration defaultConfiguration];    // copy
     }
     return self;
@@ -188,6 +412,8 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 {
     [_templateForTemplateID release];
     [_configuration release];
+    [_metrics release];
+    [_missingTemplateCache release];
     [super dealloc];
 }
 
@@ -202,12 +428,16 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     if (!AST) {
         return nil;
     }
-    
-    GRMustacheTemplate *template = [[[GRMustacheTemplate alloc] init] autorelease];
-    template.components = AST.templateComponents;
-    template.contentType = AST.contentType;
-    template.baseContext = self.configuration.baseContext;
-    return template;
+    return [self templateWithAST:AST];
+}
+
+- (GRMustacheTemplate *)templateFromStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    GRMustacheAST *AST = [self ASTFromStream:stream encoding:encoding error:error];
+    if (!AST) {
+        return nil;
+    }
+    return [self templateWithAST:AST];
 }
 
 - (void)setConfiguration:(GRMustacheConfiguration *)configuration
@@ -223,11 +453,63 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     }
 }
 
+- (GRMustacheMemoryFootprint *)memoryFootprint
+{
+    return [GRMustacheMemoryFootprint memoryFootprintWithTemplates:[_templateForTemplateID allValues]];
+}
+
 #pragma mark Private
 
 - (GRMustacheAST *)ASTFromString:(NSString *)templateString templateID:(id)templateID error:(NSError **)error
+{
+    return [self ASTByParsingWithBlock:^(GRMustacheCompiler *compiler) {
+        GRMustacheTemplateStringLoader templateStringLoader = nil;
+        if (templateID && !self.configuration.retainsTemplateStrings) {
+            templateStringLoader = [self templateStringLoaderForTemplateID:templateID];
+        }
+        if (templateStringLoader) {
+            // Have tokens and section tags refer to a string that loads the
+            // template string again when needed.
+            GRMustacheRefetchableString *tokenTemplateString = [GRMustacheRefetchableString stringWithTemplateString:templateString templateStringLoader:templateStringLoader templateID:templateID];
+            GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:self.configuration] autorelease];
+            parser.delegate = compiler;
+            [parser parseTemplateString:templateString tokenTemplateString:tokenTemplateString templateID:templateID];
+            return;
+        }
+        
+        // Parse, or load shared tokens, and feed the compiler
+        GRMustacheTemplateCache *templateCache = self.configuration.templateCache;
+        if (templateCache) {
+            [templateCache parseTemplateString:templateString templateID:templateID configuration:self.configuration delegate:compiler];
+        } else {
+            GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:self.configuration] autorelease];
+            parser.delegate = compiler;
+            [parser parseTemplateString:templateString templateID:templateID];
+        }
+    } error:error];
+}
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    // Custom data sources can not be queried once the repository is gone.
+    return nil;
+}
+
+- (GRMustacheAST *)ASTFromStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    return [self ASTByParsingWithBlock:^(GRMustacheCompiler *compiler) {
+        // Streamed templates are not shared through the template cache: they
+        // are assumed to be large, and generated.
+        GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:self.configuration] autorelease];
+        parser.delegate = compiler;
+        [parser parseTemplateStream:stream encoding:encoding templateID:nil];
+    } error:error];
+}
+
+- (GRMustacheAST *)ASTByParsingWithBlock:(void(^)(GRMustacheCompiler *compiler))parse error:(NSError **)error
 {
     GRMustacheAST *AST = nil;
+    uint64_t start = GRMustacheInstrumentationNanoseconds();
     @autoreleasepool {
         // It's time to lock the configuration.
         [self.configuration lock];
@@ -236,23 +518,47 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
         GRMustacheCompiler *compiler = [[[GRMustacheCompiler alloc] initWithConfiguration:self.configuration] autorelease];
         compiler.templateRepository = self;
         
-        // Create a Mustache parser that feeds the compiler
-        GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:self.configuration] autorelease];
-        parser.delegate = compiler;
+        // Feed the compiler
+        parse(compiler);
         
-        // Parse and extract template components from the compiler
-        [parser parseTemplateString:templateString templateID:templateID];
+        // Extract template components from the compiler
         AST = [[compiler ASTReturningError:error] retain];  // make sure AST is not released by autoreleasepool
         
         // make sure error is not released by autoreleasepool
         if (!AST && error != NULL) [*error retain];
     }
     if (!AST && error != NULL) [*error autorelease];
+    if (AST) {
+        [_metrics didCompileTemplateWithLatency:GRMustacheInstrumentationNanoseconds() - start];
+    }
     return [AST autorelease];
 }
 
+- (GRMustacheTemplate *)templateWithAST:(GRMustacheAST *)AST
+{
+    GRMustacheTemplate *template = [[[GRMustacheTemplate alloc] init] autorelease];
+    template.components = AST.templateComponents;
+    template.contentType = AST.contentType;
+    template.baseContext = self.configuration.baseContext;
+    template.renderingBudget = self.configuration.renderingBudget;
+    template.metrics = _metrics;
+    return template;
+}
+
 - (GRMustacheTemplate *)templateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID error:(NSError **)error
 {
+    if (_missingTemplateCache && name) {
+        NSError *missingTemplateError = [_missingTemplateCache errorForTemplateNamed:name relativeToTemplateID:baseTemplateID now:GRMustacheInstrumentationNanoseconds()];
+        if (missingTemplateError) {
+            // Don't log known missing templates.
+            [_metrics didHitMissingTemplateCache];
+            if (error != NULL) {
+                *error = missingTemplateError;
+            }
+            return nil;
+        }
+    }
+    
     id templateID = nil;
     if (name) {
        templateID = [self.dataSource templateRepository:self templateIDForName:name relativeToTemplateID:baseTemplateID];
@@ -262,6 +568,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
                                                             code:GRMustacheErrorCodeTemplateNotFound
                                                         userInfo:[NSDictionary dictionaryWithObject:[NSString stringWithFormat:@"No such template: `%@`", name, nil]
                                                                                              forKey:NSLocalizedDescriptionKey]];
+        [self rememberMissingTemplateNamed:name relativeToTemplateID:baseTemplateID error:missingTemplateError];
         if (error != NULL) {
             *error = missingTemplateError;
         } else {
@@ -272,12 +579,18 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     
     GRMustacheTemplate *template = [_templateForTemplateID objectForKey:templateID];
     
-    if (template == nil) {
+    if (template) {
+        [_metrics didHitTemplateCache];
+    } else {
+        [_metrics didMissTemplateCache];
+        
         // templateRepository:templateStringForTemplateID:error: is a dataSource method.
         // We are not sure the dataSource will set error when not returning any templateString.
         // We thus have to take extra care of error handling here.
         NSError *templateStringError = nil;
+        uint64_t loadStart = GRMustacheInstrumentationNanoseconds();
         NSString *templateString = [self.dataSource templateRepository:self templateStringForTemplateID:templateID error:&templateStringError];
+        [_metrics didLoadTemplateStringWithLatency:GRMustacheInstrumentationNanoseconds() - loadStart];
         if (!templateString) {
             if (templateStringError == nil) {
                 templateStringError = [NSError errorWithDomain:GRMustacheErrorDomain
@@ -285,6 +598,9 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
                                                       userInfo:[NSDictionary dictionaryWithObject:[NSString stringWithFormat:@"No such template: `%@`", name, nil]
                                                                                            forKey:NSLocalizedDescriptionKey]];
             }
+            if (GRMustacheErrorIsMissingTemplate(templateStringError)) {
+                [self rememberMissingTemplateNamed:name relativeToTemplateID:baseTemplateID error:templateStringError];
+            }
             if (error != NULL) {
                 *error = templateStringError;
             } else {
@@ -298,6 +614,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
         // recursive partials
         
         template = [[[GRMustacheTemplate alloc] init] autorelease];
+        template.templateID = templateID;
         [_templateForTemplateID setObject:template forKey:templateID];
         
         
@@ -324,6 +641,9 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
             template.components = AST.templateComponents;
             template.contentType = AST.contentType;
             template.baseContext = self.configuration.baseContext;
+            template.renderingBudget = self.configuration.renderingBudget;
+            template.metrics = _metrics;
+            [_metrics didCacheTemplateSourceOfLength:templateString.length];
         } else {
             // forget invalid empty template
             [_templateForTemplateID removeObjectForKey:templateID];
@@ -334,6 +654,27 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     return template;
 }
 
+- (id)currentlyParsedTemplateID
+{
+    return _currentlyParsedTemplateID;
+}
+
+- (void)rememberMissingTemplateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID error:(NSError *)error
+{
+    NSTimeInterval lifetime = self.configuration.missingTemplateLifetime;
+    if (name == nil || lifetime <= 0) {
+        return;
+    }
+    
+    if (_missingTemplateCache == nil) {
+        _missingTemplateCache = [[GRMustacheMissingTemplateCache alloc] init];
+    }
+    
+    // Beyond a few centuries, avoid overflowing 64 bits of nanoseconds.
+    uint64_t expirationTime = (lifetime < 1e9) ? GRMustacheInstrumentationNanoseconds() + (uint64_t)(lifetime * 1e9) : UINT64_MAX;
+    [_missingTemplateCache setError:error forTemplateNamed:name relativeToTemplateID:baseTemplateID expirationTime:expirationTime capacity:self.configuration.maximumMissingTemplateCount];
+}
+
 @end
 
 
@@ -350,6 +691,8 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     self = [super init];
     if (self) {
         _baseURL = [baseURL retain];
+        _templateIDCache = [[NSMutableDictionary alloc] init];
+        _prefetchedRemoteTemplateForURL = [[NSMutableDictionary alloc] init];
         _templateExtension = [templateExtension retain];
         _encoding = encoding;
         self.dataSource = self;
@@ -360,13 +703,70 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 - (void)dealloc
 {
     [_baseURL release];
+    [_templateIDCache release];
     [_templateExtension release];
+    [_prefetchedRemoteTemplateForURL release];
     [super dealloc];
 }
 
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplate *)templateNamed:(NSString *)name relativeToTemplateID:(id)baseTemplateID error:(NSError **)error
+{
+    GRMustacheTemplate *template = [super templateNamed:name relativeToTemplateID:baseTemplateID error:error];
+    if ([self currentlyParsedTemplateID] == nil) {
+        // The root template and its partials are compiled: forget the
+        // prefetched templates that it did not use, before they get stale.
+        [_prefetchedRemoteTemplateForURL removeAllObjects];
+    }
+    return template;
+}
+
 #pragma mark GRMustacheTemplateRepositoryDataSource
 
 - (id<NSCopying>)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    id templateID = GRMustacheTemplateIDCacheLookup(_templateIDCache, name, baseTemplateID);
+    if (templateID == nil) {
+        templateID = [self resolvedTemplateIDForName:name relativeToTemplateID:baseTemplateID];
+        GRMustacheTemplateIDCacheStore(_templateIDCache, name, baseTemplateID, templateID);
+    }
+    return templateID;
+}
+
+- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
+{
+    NSAssert([templateID isKindOfClass:[NSURL class]], @"");
+    if ([(NSURL *)templateID isFileURL]) {
+        return [GRMustacheMappedString stringWithContentsOfFile:[(NSURL *)templateID path] encoding:_encoding error:error];
+    }
+    return [self templateStringForRemoteURL:(NSURL *)templateID error:error];
+}
+
+
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    if (self.dataSource != self) {
+        return [super templateStringLoaderForTemplateID:templateID];
+    }
+    NSURL *URL = templateID;
+    NSStringEncoding encoding = _encoding;
+    if ([URL isFileURL]) {
+        return [[^NSString *(NSError **error) {
+            return [GRMustacheMappedString stringWithContentsOfFile:[URL path] encoding:encoding error:error];
+        } copy] autorelease];
+    }
+    return [[^NSString *(NSError **error) {
+        return [NSString stringWithContentsOfURL:URL encoding:encoding error:error];
+    } copy] autorelease];
+}
+
+
+#pragma mark Private
+
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
 {
     // Rebase template names starting with a /
     if ([name characterAtIndex:0] == '/') {
@@ -391,10 +791,73 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     return [[[_baseURL URLByAppendingPathComponent:name] URLByAppendingPathExtension:_templateExtension] URLByStandardizingPath];
 }
 
-- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
+- (NSString *)templateStringForRemoteURL:(NSURL *)URL error:(NSError **)error
 {
-    NSAssert([templateID isKindOfClass:[NSURL class]], @"");
-    return [NSString stringWithContentsOfURL:(NSURL *)templateID encoding:_encoding error:error];
+    // Without any template cache, there is nothing to revalidate.
+    GRMustacheTemplateCache *templateCache = self.configuration.templateCache;
+    if (templateCache == nil) {
+        return [GRMustacheRemoteTemplate remoteTemplateWithURL:URL encoding:_encoding cachedTemplate:nil error:error].templateString;
+    }
+    
+    URL = [URL absoluteURL];
+    NSURL *parentURL = [[self currentlyParsedTemplateID] absoluteURL];
+    GRMustacheRemoteTemplate *remoteTemplate = [[[_prefetchedRemoteTemplateForURL objectForKey:URL] retain] autorelease];
+    if (remoteTemplate) {
+        [_prefetchedRemoteTemplateForURL removeObjectForKey:URL];
+    } else {
+        GRMustacheRemoteTemplate *cachedTemplate = [templateCache remoteTemplateForURL:URL];
+        if (cachedTemplate && parentURL == nil) {
+            // Revalidate the template and all the partials it has loaded so
+            // far at once, instead of one after the other as the template
+            // gets compiled.
+            [self prefetchRemoteTemplates:[templateCache remoteTemplateClosureForURL:URL]];
+            remoteTemplate = [[[_prefetchedRemoteTemplateForURL objectForKey:URL] retain] autorelease];
+            [_prefetchedRemoteTemplateForURL removeObjectForKey:URL];
+        }
+        if (remoteTemplate == nil) {
+            remoteTemplate = [GRMustacheRemoteTemplate remoteTemplateWithURL:URL encoding:_encoding cachedTemplate:cachedTemplate error:error];
+            if (remoteTemplate == nil) {
+                return nil;
+            }
+        }
+    }
+    
+    // Store new and modified templates, and remember the partials of the
+    // template being compiled.
+    [templateCache setRemoteTemplate:remoteTemplate];
+    if (parentURL) {
+        [[templateCache remoteTemplateForURL:parentURL] addPartialURL:URL];
+    }
+    
+    return remoteTemplate.templateString;
+}
+
+- (void)prefetchRemoteTemplates:(NSArray *)cachedTemplates
+{
+    NSUInteger count = cachedTemplates.count;
+    GRMustacheRemoteTemplate **remoteTemplates = calloc(count, sizeof(GRMustacheRemoteTemplate *));
+    if (remoteTemplates == NULL) {
+        return;
+    }
+    
+    // Failed requests are not prefetched: they will be performed again when
+    // the template is actually needed, and report their error then.
+    NSStringEncoding encoding = _encoding;
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        @autoreleasepool {
+            GRMustacheRemoteTemplate *cachedTemplate = [cachedTemplates objectAtIndex:index];
+            remoteTemplates[index] = [[GRMustacheRemoteTemplate remoteTemplateWithURL:cachedTemplate.URL encoding:encoding cachedTemplate:cachedTemplate error:NULL] retain];
+        }
+    });
+    
+    for (NSUInteger index = 0; index < count; ++index) {
+        GRMustacheRemoteTemplate *remoteTemplate = remoteTemplates[index];
+        if (remoteTemplate) {
+            [_prefetchedRemoteTemplateForURL setObject:remoteTemplate forKey:remoteTemplate.URL];
+            [remoteTemplate release];
+        }
+    }
+    free(remoteTemplates);
 }
 
 @end
@@ -413,6 +876,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     self = [super init];
     if (self) {
         _directoryPath = [directoryPath retain];
+        _templateIDCache = [[NSMutableDictionary alloc] init];
         _templateExtension = [templateExtension retain];
         _encoding = encoding;
         self.dataSource = self;
@@ -423,6 +887,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 - (void)dealloc
 {
     [_directoryPath release];
+    [_templateIDCache release];
     [_templateExtension release];
     [super dealloc];
 }
@@ -430,6 +895,40 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 #pragma mark GRMustacheTemplateRepositoryDataSource
 
 - (id<NSCopying>)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    id templateID = GRMustacheTemplateIDCacheLookup(_templateIDCache, name, baseTemplateID);
+    if (templateID == nil) {
+        templateID = [self resolvedTemplateIDForName:name relativeToTemplateID:baseTemplateID];
+        GRMustacheTemplateIDCacheStore(_templateIDCache, name, baseTemplateID, templateID);
+    }
+    return templateID;
+}
+
+- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
+{
+    NSAssert([templateID isKindOfClass:[NSString class]], @"");
+    return [GRMustacheMappedString stringWithContentsOfFile:(NSString *)templateID encoding:_encoding error:error];
+}
+
+
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    if (self.dataSource != self) {
+        return [super templateStringLoaderForTemplateID:templateID];
+    }
+    NSString *path = templateID;
+    NSStringEncoding encoding = _encoding;
+    return [[^NSString *(NSError **error) {
+        return [GRMustacheMappedString stringWithContentsOfFile:path encoding:encoding error:error];
+    } copy] autorelease];
+}
+
+
+#pragma mark Private
+
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
 {
     // Rebase template names starting with a /
     if ([name characterAtIndex:0] == '/') {
@@ -455,12 +954,6 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     return [[[_directoryPath stringByAppendingPathComponent:name] stringByAppendingPathExtension:_templateExtension] stringByStandardizingPath];
 }
 
-- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
-{
-    NSAssert([templateID isKindOfClass:[NSString class]], @"");
-    return [NSString stringWithContentsOfFile:(NSString *)templateID encoding:_encoding error:error];
-}
-
 @end
 
 
@@ -480,6 +973,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
             bundle = [NSBundle mainBundle];
         }
         _bundle = [bundle retain];
+        _templateIDCache = [[NSMutableDictionary alloc] init];
         _templateExtension = [templateExtension retain];
         _encoding = encoding;
         self.dataSource = self;
@@ -490,6 +984,7 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 - (void)dealloc
 {
     [_bundle release];
+    [_templateIDCache release];
     [_templateExtension release];
     [super dealloc];
 }
@@ -498,13 +993,41 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
 
 - (id<NSCopying>)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
 {
-    return [_bundle pathForResource:name ofType:_templateExtension];
+    id templateID = GRMustacheTemplateIDCacheLookup(_templateIDCache, name, baseTemplateID);
+    if (templateID == nil) {
+        templateID = [self resolvedTemplateIDForName:name relativeToTemplateID:baseTemplateID];
+        GRMustacheTemplateIDCacheStore(_templateIDCache, name, baseTemplateID, templateID);
+    }
+    return templateID;
 }
 
 - (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
 {
     NSAssert([templateID isKindOfClass:[NSString class]], @"");
-    return [NSString stringWithContentsOfFile:(NSString *)templateID encoding:_encoding error:error];
+    return [GRMustacheMappedString stringWithContentsOfFile:(NSString *)templateID encoding:_encoding error:error];
+}
+
+
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    if (self.dataSource != self) {
+        return [super templateStringLoaderForTemplateID:templateID];
+    }
+    NSString *path = templateID;
+    NSStringEncoding encoding = _encoding;
+    return [[^NSString *(NSError **error) {
+        return [GRMustacheMappedString stringWithContentsOfFile:path encoding:encoding error:error];
+    } copy] autorelease];
+}
+
+
+#pragma mark Private
+
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    return [_bundle pathForResource:name ofType:_templateExtension];
 }
 
 @end
@@ -546,6 +1069,233 @@ static NSString* const GRMustacheDefaultExtension = @"mustache";
     return [_partialsDictionary objectForKey:templateID];
 }
 
+
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    if (self.dataSource != self) {
+        return [super templateStringLoaderForTemplateID:templateID];
+    }
+    NSString *templateString = [_partialsDictionary objectForKey:templateID];
+    return [[^NSString *(NSError **error) {
+        return templateString;
+    } copy] autorelease];
+}
+
+@end
+
+
+
+
+// =============================================================================
+#pragma mark - Private concrete class GRMustacheTemplateRepositoryArchive
+
+/**
+ * Returns the line that starts at *location in bytes, and moves *location after
+ * the line. Returns nil if there is no line feed.
+ */
+static NSString *GRMustacheArchiveReadLine(const char *bytes, NSUInteger length, NSUInteger *location)
+{
+    if (*location >= length) {
+        return nil;
+    }
+    const char *start = bytes + *location;
+    const char *end = memchr(start, '\n', length - *location);
+    if (end == NULL) {
+        return nil;
+    }
+    *location += (end - start) + 1;
+    return [[[NSString alloc] initWithBytes:start length:(end - start) encoding:NSUTF8StringEncoding] autorelease];
+}
+
+/**
+ * Resolves the `.` and `..` components of a relative path, without accessing
+ * the file system. Returns nil if the path escapes the archive.
+ */
+static NSString *GRMustacheArchivePathByResolvingDots(NSString *path)
+{
+    if ([path rangeOfString:@"."].location == NSNotFound && [path rangeOfString:@"//"].location == NSNotFound) {
+        return path;
+    }
+    NSMutableArray *components = [NSMutableArray array];
+    for (NSString *component in [path componentsSeparatedByString:@"/"]) {
+        if (component.length == 0 || [component isEqualToString:@"."]) {
+            continue;
+        }
+        if ([component isEqualToString:@".."]) {
+            if (components.count == 0) {
+                return nil;
+            }
+            [components removeLastObject];
+            continue;
+        }
+        [components addObject:component];
+    }
+    return [components componentsJoinedByString:@"/"];
+}
+
+@interface GRMustacheTemplateRepositoryArchive()<GRMustacheTemplateRepositoryDataSource>
 @end
 
+@implementation GRMustacheTemplateRepositoryArchive
+
+- (id)initWithArchiveAtPath:(NSString *)path templateExtension:(NSString *)templateExtension encoding:(NSStringEncoding)encoding error:(NSError **)error
+{
+    // Always map archives, so that processes that load the same archive share
+    // its memory.
+    NSData *archiveData = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:error];
+    if (!archiveData) {
+        [self release];
+        return nil;
+    }
+    
+    // Header and index length
+    
+    const char *bytes = archiveData.bytes;
+    NSUInteger length = archiveData.length;
+    NSUInteger location = 0;
+    NSString *header = GRMustacheArchiveReadLine(bytes, length, &location);
+    NSString *indexLengthString = [header isEqualToString:GRMustacheArchiveHeader] ? GRMustacheArchiveReadLine(bytes, length, &location) : nil;
+    NSInteger indexLength = [indexLengthString integerValue];
+    
+    // Index
+    
+    NSDictionary *index = nil;
+    if (indexLengthString && indexLength >= 0 && (NSUInteger)indexLength <= length - location) {
+        NSData *indexData = [archiveData subdataWithRange:NSMakeRange(location, (NSUInteger)indexLength)];
+        index = [NSJSONSerialization JSONObjectWithData:indexData options:0 error:NULL];
+        location += (NSUInteger)indexLength;
+    }
+    
+    NSMutableDictionary *rangeForTemplateID = nil;
+    if ([index isKindOfClass:[NSDictionary class]]) {
+        rangeForTemplateID = [NSMutableDictionary dictionaryWithCapacity:index.count];
+        for (NSString *templateID in index) {
+            NSArray *entry = [index objectForKey:templateID];
+            if (![entry isKindOfClass:[NSArray class]] || entry.count != 2) {
+                rangeForTemplateID = nil;
+                break;
+            }
+            NSNumber *offsetNumber = [entry objectAtIndex:0];
+            NSNumber *entryLengthNumber = [entry objectAtIndex:1];
+            if (![offsetNumber isKindOfClass:[NSNumber class]] || ![entryLengthNumber isKindOfClass:[NSNumber class]] || [offsetNumber longLongValue] < 0 || [entryLengthNumber longLongValue] < 0) {
+                rangeForTemplateID = nil;
+                break;
+            }
+            unsigned long long offset = [offsetNumber unsignedLongLongValue];
+            unsigned long long entryLength = [entryLengthNumber unsignedLongLongValue];
+            if (offset > length - location || entryLength > length - location - offset) {
+                rangeForTemplateID = nil;
+                break;
+            }
+            [rangeForTemplateID setObject:[NSValue valueWithRange:NSMakeRange(location + (NSUInteger)offset, (NSUInteger)entryLength)] forKey:templateID];
+        }
+    }
+    
+    if (!rangeForTemplateID) {
+        if (error != NULL) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileReadCorruptFileError
+                                     userInfo:[NSDictionary dictionaryWithObjectsAndKeys:
+                                               [NSString stringWithFormat:@"Invalid template archive: %@", path], NSLocalizedDescriptionKey,
+                                               path, NSFilePathErrorKey,
+                                               nil]];
+        }
+        [self release];
+        return nil;
+    }
+    
+    self = [super init];
+    if (self) {
+        _archiveData = [archiveData retain];
+        _rangeForTemplateID = [rangeForTemplateID copy];
+        _templateIDCache = [[NSMutableDictionary alloc] init];
+        _templateExtension = [templateExtension retain];
+        _encoding = encoding;
+        self.dataSource = self;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_archiveData release];
+    [_rangeForTemplateID release];
+    [_templateIDCache release];
+    [_templateExtension release];
+    [super dealloc];
+}
+
+#pragma mark GRMustacheTemplateRepositoryDataSource
 
+- (id<NSCopying>)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    id templateID = GRMustacheTemplateIDCacheLookup(_templateIDCache, name, baseTemplateID);
+    if (templateID == nil) {
+        templateID = [self resolvedTemplateIDForName:name relativeToTemplateID:baseTemplateID];
+        GRMustacheTemplateIDCacheStore(_templateIDCache, name, baseTemplateID, templateID);
+    }
+    return templateID;
+}
+
+- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
+{
+    NSValue *range = [_rangeForTemplateID objectForKey:templateID];
+    if (range == nil) {
+        return nil;
+    }
+    return [GRMustacheMappedString stringWithData:_archiveData range:[range rangeValue] encoding:_encoding error:error];
+}
+
+
+#pragma mark GRMustacheTemplateRepository
+
+- (GRMustacheTemplateStringLoader)templateStringLoaderForTemplateID:(id)templateID
+{
+    if (self.dataSource != self) {
+        return [super templateStringLoaderForTemplateID:templateID];
+    }
+    NSData *archiveData = _archiveData;
+    NSRange range = [[_rangeForTemplateID objectForKey:templateID] rangeValue];
+    NSStringEncoding encoding = _encoding;
+    return [[^NSString *(NSError **error) {
+        return [GRMustacheMappedString stringWithData:archiveData range:range encoding:encoding error:error];
+    } copy] autorelease];
+}
+
+
+#pragma mark Private
+
+- (id<NSCopying>)resolvedTemplateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    // Rebase template names starting with a /
+    if ([name characterAtIndex:0] == '/') {
+        name = [name substringFromIndex:1];
+        baseTemplateID = nil;
+    }
+    
+    if (name.length == 0) {
+        return nil;
+    }
+    
+    NSString *path = name;
+    if (_templateExtension.length > 0) {
+        path = [path stringByAppendingPathExtension:_templateExtension];
+    }
+    if (baseTemplateID) {
+        NSAssert([baseTemplateID isKindOfClass:[NSString class]], @"");
+        NSString *basePath = [(NSString *)baseTemplateID stringByDeletingLastPathComponent];
+        if (basePath.length > 0) {
+            path = [basePath stringByAppendingPathComponent:path];
+        }
+    }
+    path = GRMustacheArchivePathByResolvingDots(path);
+    
+    if (path == nil || [_rangeForTemplateID objectForKey:path] == nil) {
+        return nil;
+    }
+    return path;
+}
+
+@end
@@ -27,6 +27,9 @@
 @class GRMustacheTemplate;
 @class GRMustacheTemplateRepository;
 @class GRMustacheConfiguration;
+@class GRMustacheMetrics;
+@class GRMustacheMissingTemplateCache;
+@class GRMustacheMemoryFootprint;
 @protocol GRMustacheTemplateComponent;
 
 // Documented in GRMustacheTemplateRepository.h
@@ -46,6 +49,8 @@
     NSMutableDictionary *_templateForTemplateID;
     id _currentlyParsedTemplateID;
     GRMustacheConfiguration *_configuration;
+    GRMustacheMetrics *_metrics;
+    GRMustacheMissingTemplateCache *_missingTemplateCache;
 }
 
 // Documented in GRMustacheTemplateRepository.h
@@ -54,6 +59,12 @@
 // Documented in GRMustacheTemplateRepository.h
 @property (nonatomic, copy) GRMustacheConfiguration *configuration GRMUSTACHE_API_PUBLIC;
 
+// Documented in GRMustacheTemplateRepository.h
+@property (nonatomic, retain, readonly) GRMustacheMetrics *metrics GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateRepository.h
+- (GRMustacheMemoryFootprint *)memoryFootprint GRMUSTACHE_API_PUBLIC;
+
 // Documented in GRMustacheTemplateRepository.h
 + (instancetype)templateRepositoryWithBaseURL:(NSURL *)URL GRMUSTACHE_API_PUBLIC;
 
@@ -75,6 +86,15 @@
 // Documented in GRMustacheTemplateRepository.h
 + (instancetype)templateRepositoryWithDictionary:(NSDictionary *)partialsDictionary GRMUSTACHE_API_PUBLIC;
 
+// Documented in GRMustacheTemplateRepository.h
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateRepository.h
++ (instancetype)templateRepositoryWithArchiveAtPath:(NSString *)path templateExtension:(NSString *)ext encoding:(NSStringEncoding)encoding error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplateRepository.h
++ (BOOL)writeArchiveWithDirectory:(NSString *)directoryPath templateExtension:(NSString *)ext toPath:(NSString *)path error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
 // Documented in GRMustacheTemplateRepository.h
 + (instancetype)templateRepository GRMUSTACHE_API_PUBLIC;
 
@@ -84,4 +104,7 @@
 // Documented in GRMustacheTemplateRepository.h
 - (GRMustacheTemplate *)templateFromString:(NSString *)templateString error:(NSError **)error GRMUSTACHE_API_PUBLIC;
 
+// Documented in GRMustacheTemplateRepository.h
+- (GRMustacheTemplate *)templateFromStream:(NSInputStream *)stream encoding:(NSStringEncoding)encoding error:(NSError **)error GRMUSTACHE_API_PUBLIC;
+
 @end
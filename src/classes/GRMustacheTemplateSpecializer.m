@@ -0,0 +1,303 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheTemplateSpecializer_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateOverride_private.h"
+#import "GRMustacheSectionTag_private.h"
+#import "GRMustacheVariableTag_private.h"
+#import "GRMustacheTextComponent_private.h"
+#import "GRMustacheContext_private.h"
+#import "GRMustacheExpression_private.h"
+#import "GRMustacheFilteredExpression_private.h"
+#import "GRMustacheIdentifierExpression_private.h"
+#import "GRMustacheImplicitIteratorExpression_private.h"
+#import "GRMustacheScopedExpression_private.h"
+
+
+// =============================================================================
+#pragma mark - Private class GRMustacheFrozenExpressionDetector
+
+/**
+ * Tells whether an expression only reads frozen values: all its identifiers
+ * are provided by the protected context stack, and it does not read the
+ * implicit iterator or loop metadata.
+ */
+@interface GRMustacheFrozenExpressionDetector : NSObject<GRMustacheExpressionVisitor> {
+@private
+    GRMustacheContext *_context;
+    BOOL _frozen;
+}
++ (BOOL)isExpression:(GRMustacheExpression *)expression frozenInContext:(GRMustacheContext *)context;
+@end
+
+@implementation GRMustacheFrozenExpressionDetector
+
++ (BOOL)isExpression:(GRMustacheExpression *)expression frozenInContext:(GRMustacheContext *)context
+{
+    GRMustacheFrozenExpressionDetector *detector = [[[self alloc] init] autorelease];
+    detector->_context = context;   // not retained: the detector does not outlive this method
+    detector->_frozen = YES;
+    [expression acceptExpressionVisitor:detector];
+    return detector->_frozen;
+}
+
+- (void)visitFilteredExpression:(GRMustacheFilteredExpression *)expression
+{
+    [expression.filterExpression acceptExpressionVisitor:self];
+    [expression.argumentExpression acceptExpressionVisitor:self];
+}
+
+- (void)visitIdentifierExpression:(GRMustacheIdentifierExpression *)expression
+{
+    NSString *identifier = expression.identifier;
+    
+    // Loop metadata is provided by the runtime loop, not by the frozen context.
+    if (identifier.length > 0 && [identifier characterAtIndex:0] == '@') {
+        _frozen = NO;
+        return;
+    }
+    
+    BOOL protected = NO;
+    [_context contextValueForKey:identifier protected:&protected];
+    if (!protected) {
+        _frozen = NO;
+    }
+}
+
+- (void)visitImplicitIteratorExpression:(GRMustacheImplicitIteratorExpression *)expression
+{
+    _frozen = NO;
+}
+
+- (void)visitScopedExpression:(GRMustacheScopedExpression *)expression
+{
+    [expression.baseExpression acceptExpressionVisitor:self];
+}
+
+@end
+
+
+// =============================================================================
+#pragma mark - GRMustacheTemplateSpecializer
+
+@interface GRMustacheTemplateSpecializer()
+- (id)initWithContext:(GRMustacheContext *)context;
+- (GRMustacheTemplate *)residualTemplateForTemplate:(GRMustacheTemplate *)template;
+- (NSArray *)residualComponentsForComponents:(NSArray *)components;
+- (BOOL)hasFrozenValue:(id *)value forTag:(GRMustacheTag *)tag;
++ (NSArray *)componentsByMergingTextComponents:(NSArray *)components;
+@end
+
+@implementation GRMustacheTemplateSpecializer
+
++ (GRMustacheTemplate *)templateBySpecializingTemplate:(GRMustacheTemplate *)template withContext:(GRMustacheContext *)context
+{
+    GRMustacheTemplateSpecializer *specializer = [[[self alloc] initWithContext:context] autorelease];
+    GRMustacheTemplate *residualTemplate = [specializer residualTemplateForTemplate:template];
+    residualTemplate.baseContext = context;
+    return residualTemplate;
+}
+
+- (void)dealloc
+{
+    [_context release];
+    [_residualTemplates release];
+    [super dealloc];
+}
+
+
+#pragma mark - <GRMustacheTemplateComponentVisitor>
+
+- (void)visitTemplate:(GRMustacheTemplate *)template
+{
+    // Partial
+    [_components addObject:[self residualTemplateForTemplate:template]];
+}
+
+- (void)visitTemplateOverride:(GRMustacheTemplateOverride *)templateOverride
+{
+    // Overridable partials resolve their components by identity: keep them
+    // untouched.
+    [_components addObject:templateOverride];
+}
+
+- (void)visitSectionTag:(GRMustacheSectionTag *)sectionTag
+{
+    GRMustacheTagType type = sectionTag.type;
+    id value = nil;
+    
+    // Overridable sections may be overriden: keep them untouched.
+    //
+    // Other sections are evaluated when their value is frozen, and is nil,
+    // NSNull or a number. Those values do not look at the section content: the
+    // section is either pruned, or unrolled.
+    if (type != GRMustacheTagTypeOverridableSection &&
+        [self hasFrozenValue:&value forTag:sectionTag] &&
+        (value == nil || [value isKindOfClass:[NSNull class]] || [value isKindOfClass:[NSNumber class]]))
+    {
+        BOOL truthy = [value isKindOfClass:[NSNumber class]] && [value boolValue];
+        
+        if (type == GRMustacheTagTypeInvertedSection) {
+            if (!truthy) {
+                // {{^ false }}...{{/}} renders its content in the same context.
+                [_components addObjectsFromArray:[self residualComponentsForComponents:sectionTag.components]];
+            }
+            return;
+        }
+        
+        if (!truthy) {
+            // {{# false }}...{{/}} renders nothing.
+            return;
+        }
+        
+        // {{# true }}...{{/}} pushes the number on top of the context stack:
+        // only unroll the section if its content does not depend on it.
+        NSArray *residualComponents = [self residualComponentsForComponents:sectionTag.components];
+        BOOL contentIsText = YES;
+        for (id<GRMustacheTemplateComponent> component in residualComponents) {
+            if (![component isKindOfClass:[GRMustacheTextComponent class]]) {
+                contentIsText = NO;
+                break;
+            }
+        }
+        if (contentIsText) {
+            [_components addObjectsFromArray:residualComponents];
+            return;
+        }
+    }
+    
+    // Keep the section. Its content is not specialized, since its rendering
+    // object may inspect it.
+    [_components addObject:sectionTag];
+}
+
+- (void)visitVariableTag:(GRMustacheVariableTag *)variableTag
+{
+    id value = nil;
+    
+    // Only pre-render strings, numbers, NSNull and nil: other values may
+    // render differently depending on the runtime context.
+    if ([self hasFrozenValue:&value forTag:variableTag] &&
+        (value == nil || [value isKindOfClass:[NSString class]] || [value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSNull class]]))
+    {
+        NSMutableString *buffer = [NSMutableString string];
+        NSError *renderingError = nil;
+        if ([variableTag renderContentType:variableTag.contentType inBuffer:buffer withContext:_context error:&renderingError]) {
+            [_components addObject:[GRMustacheTextComponent textComponentWithString:buffer]];
+            return;
+        }
+        // The residual template will report the error.
+    }
+    
+    [_components addObject:variableTag];
+}
+
+- (void)visitTextComponent:(GRMustacheTextComponent *)textComponent
+{
+    [_components addObject:textComponent];
+}
+
+
+#pragma mark - Private
+
+- (id)initWithContext:(GRMustacheContext *)context
+{
+    self = [super init];
+    if (self) {
+        _context = [context retain];
+        _residualTemplates = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (GRMustacheTemplate *)residualTemplateForTemplate:(GRMustacheTemplate *)template
+{
+    // Recursive partials: the residual template is registered before its
+    // components are specialized.
+    NSValue *key = [NSValue valueWithNonretainedObject:template];
+    GRMustacheTemplate *residualTemplate = [_residualTemplates objectForKey:key];
+    if (residualTemplate) {
+        return residualTemplate;
+    }
+    
+    residualTemplate = [[[GRMustacheTemplate alloc] init] autorelease];
+    residualTemplate.contentType = template.contentType;
+    residualTemplate.templateID = template.templateID;
+    residualTemplate.baseContext = template.baseContext;
+    residualTemplate.renderingBudget = template.renderingBudget;
+    residualTemplate.metrics = template.metrics;
+    [_residualTemplates setObject:residualTemplate forKey:key];
+    
+    residualTemplate.components = [self residualComponentsForComponents:template.components];
+    return residualTemplate;
+}
+
+- (NSArray *)residualComponentsForComponents:(NSArray *)components
+{
+    NSMutableArray *previousComponents = _components;
+    _components = [NSMutableArray arrayWithCapacity:components.count];
+    for (id<GRMustacheTemplateComponent> component in components) {
+        [component acceptTemplateComponentVisitor:self];
+    }
+    NSArray *residualComponents = [GRMustacheTemplateSpecializer componentsByMergingTextComponents:_components];
+    _components = previousComponents;
+    return residualComponents;
+}
+
+- (BOOL)hasFrozenValue:(id *)value forTag:(GRMustacheTag *)tag
+{
+    GRMustacheExpression *expression = tag.expression;
+    if (![GRMustacheFrozenExpressionDetector isExpression:expression frozenInContext:_context]) {
+        return NO;
+    }
+    
+    // Evaluation errors are left to the residual template.
+    NSError *valueError = nil;
+    return [expression hasValue:value withContext:_context protected:NULL error:&valueError];
+}
+
++ (NSArray *)componentsByMergingTextComponents:(NSArray *)components
+{
+    NSMutableArray *mergedComponents = [NSMutableArray arrayWithCapacity:components.count];
+    NSMutableString *text = nil;
+    for (id<GRMustacheTemplateComponent> component in components) {
+        if ([component isKindOfClass:[GRMustacheTextComponent class]]) {
+            if (!text) {
+                text = [NSMutableString string];
+            }
+            [text appendString:[(GRMustacheTextComponent *)component text]];
+        } else {
+            if (text.length > 0) {
+                [mergedComponents addObject:[GRMustacheTextComponent textComponentWithString:text]];
+            }
+            text = nil;
+            [mergedComponents addObject:component];
+        }
+    }
+    if (text.length > 0) {
+        [mergedComponents addObject:[GRMustacheTextComponent textComponentWithString:text]];
+    }
+    return mergedComponents;
+}
+
+@end
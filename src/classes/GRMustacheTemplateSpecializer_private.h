@@ -0,0 +1,66 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros_private.h"
+#import "GRMustacheTemplateComponent_private.h"
+
+@class GRMustacheTemplate;
+@class GRMustacheContext;
+
+/**
+ * The GRMustacheTemplateSpecializer builds the residual template of a template
+ * and a frozen context.
+ *
+ * Values are frozen when they are provided by the protected context stack of
+ * the frozen context: they can not be shadowed by runtime data. Tags whose
+ * expression only reads frozen values are evaluated once:
+ *
+ * - variable tags that evaluate to strings, numbers, NSNull or nil are
+ *   pre-rendered into text components.
+ * - sections that evaluate to nil, NSNull or numbers are pruned, or unrolled
+ *   into their specialized content.
+ *
+ * Other components are kept untouched. Sections that are kept are not
+ * specialized, since their rendering object may inspect their content. Partials
+ * are specialized once, even when they are recursive.
+ *
+ * @see [GRMustacheTemplate templateBySpecializingWithContext:]
+ */
+@interface GRMustacheTemplateSpecializer : NSObject<GRMustacheTemplateComponentVisitor> {
+@private
+    GRMustacheContext *_context;
+    NSMutableDictionary *_residualTemplates;
+    NSMutableArray *_components;
+}
+
+/**
+ * Returns the residual template of _template_ and _context_.
+ *
+ * @param template  A template
+ * @param context   A frozen context
+ *
+ * @return A template
+ */
++ (GRMustacheTemplate *)templateBySpecializingTemplate:(GRMustacheTemplate *)template withContext:(GRMustacheContext *)context GRMUSTACHE_API_INTERNAL;
+
+@end
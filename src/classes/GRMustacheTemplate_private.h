@@ -26,12 +26,19 @@
 #import "GRMustacheTemplateComponent_private.h"
 #import "GRMustacheConfiguration_private.h"
 
+@class GRMustacheMetrics;
+@class GRMustacheRenderingBudget;
+@class GRMustacheMemoryFootprint;
+
 // Documented in GRMustacheTemplate.h
 @interface GRMustacheTemplate: NSObject<GRMustacheTemplateComponent> {
 @private
     NSArray *_components;
     GRMustacheContext *_baseContext;
     GRMustacheContentType _contentType;
+    id _templateID;
+    GRMustacheMetrics *_metrics;
+    GRMustacheRenderingBudget *_renderingBudget;
 }
 
 /**
@@ -51,6 +58,30 @@
  */
 @property (nonatomic) GRMustacheContentType contentType GRMUSTACHE_API_INTERNAL;
 
+/**
+ * The template ID of the receiver, as provided by the data source of its
+ * template repository, or nil for templates built from strings.
+ *
+ * @see GRMustacheTemplateRepositoryDataSource
+ */
+@property (nonatomic, retain) id templateID GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The metrics of the template repository that has built the receiver.
+ *
+ * @see [GRMustacheTemplateRepository metrics]
+ */
+@property (nonatomic, retain) GRMustacheMetrics *metrics GRMUSTACHE_API_INTERNAL;
+
+/**
+ * The rendering limits of the configuration of the template repository that
+ * has built the receiver, or nil if the configuration does not define any
+ * limit.
+ *
+ * @see [GRMustacheConfiguration renderingBudget]
+ */
+@property (nonatomic, retain) GRMustacheRenderingBudget *renderingBudget GRMUSTACHE_API_INTERNAL;
+
 // Documented in GRMustacheTemplate.h
 @property (nonatomic, retain) GRMustacheContext *baseContext GRMUSTACHE_API_PUBLIC;
 
@@ -81,4 +112,10 @@
 // Documented in GRMustacheTemplate.h
 - (NSString *)renderContentWithContext:(GRMustacheContext *)context HTMLSafe:(BOOL *)HTMLSafe error:(NSError **)error GRMUSTACHE_API_PUBLIC;
 
+// Documented in GRMustacheTemplate.h
+- (GRMustacheMemoryFootprint *)memoryFootprint GRMUSTACHE_API_PUBLIC;
+
+// Documented in GRMustacheTemplate.h
+- (GRMustacheTemplate *)templateBySpecializingWithContext:(GRMustacheContext *)context GRMUSTACHE_API_PUBLIC;
+
 @end
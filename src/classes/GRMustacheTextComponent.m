@@ -21,6 +21,8 @@
 // THE SOFTWARE.
 
 #import "GRMustacheTextComponent_private.h"
+#import "GRMustacheContext_private.h"
+#import "GRMustacheRenderingBudget_private.h"
 
 
 @interface GRMustacheTextComponent()
@@ -47,6 +49,10 @@
 
 - (BOOL)renderContentType:(GRMustacheContentType)requiredContentType inBuffer:(NSMutableString *)buffer withContext:(GRMustacheContext *)context error:(NSError **)error
 {
+    GRMustacheRenderingSession *renderingSession = context.renderingSession;
+    if (renderingSession && ![renderingSession addRenderedLength:_text.length error:error]) {
+        return NO;
+    }
     [buffer appendString:_text];
     return YES;
 }
@@ -57,6 +63,11 @@
     return component;
 }
 
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    [visitor visitTextComponent:self];
+}
+
 #pragma mark Private
 
 - (id)initWithString:(NSString *)text
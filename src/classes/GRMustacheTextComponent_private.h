@@ -40,6 +40,11 @@
     NSString *_text;
 }
 
+/**
+ * The rendered text.
+ */
+@property (nonatomic, retain, readonly) NSString *text GRMUSTACHE_API_INTERNAL;
+
 /**
  * Builds and returns a GRMustacheTextComponent.
  *
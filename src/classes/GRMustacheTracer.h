@@ -0,0 +1,79 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheAvailabilityMacros.h"
+
+@class GRMustacheTemplate;
+
+/**
+ * Objects conforming to the GRMustacheTracer protocol receive a span for each
+ * rendering of a template or a partial template.
+ *
+ * Install a tracer with [GRMustacheContext contextByAddingTracer:]. When no
+ * tracer is installed, rendering pays a single nil test per template.
+ *
+ * Spans nest: a partial, or the layout template of an overridable partial
+ * `{{<layout}}...{{/layout}}`, begins and ends its span inside the span of the
+ * template that embeds it. The tracer is guaranteed to receive balanced
+ * begin and end messages, even when rendering fails.
+ *
+ * Tracers are sent messages on the rendering thread.
+ *
+ * **Companion guide:** https://github.com/groue/GRMustache/blob/master/Guides/profiling.md
+ *
+ * @see GRMustacheContext
+ *
+ * @since v6.5
+ */
+@protocol GRMustacheTracer<NSObject>
+@required
+
+/**
+ * Sent right before a template, or a partial template, renders.
+ *
+ * @param template    The template about to render.
+ * @param templateID  The template ID, as provided by the data source of the
+ *                    template repository, or nil for templates built from
+ *                    strings.
+ *
+ * @since v6.5
+ */
+- (void)mustacheTemplate:(GRMustacheTemplate *)template willBeginSpanWithTemplateID:(id)templateID AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+/**
+ * Sent right after a template, or a partial template, has rendered or failed
+ * rendering.
+ *
+ * @param template        The template that has rendered.
+ * @param templateID      The template ID, as provided by the data source of
+ *                        the template repository, or nil for templates built
+ *                        from strings.
+ * @param duration        The wall time of the rendering, in seconds.
+ * @param renderedLength  The length of the rendering.
+ * @param success         NO if the rendering has failed.
+ *
+ * @since v6.5
+ */
+- (void)mustacheTemplate:(GRMustacheTemplate *)template didEndSpanWithTemplateID:(id)templateID duration:(NSTimeInterval)duration renderedLength:(NSUInteger)renderedLength success:(BOOL)success AVAILABLE_GRMUSTACHE_VERSION_6_5_AND_LATER;
+
+@end
@@ -52,6 +52,14 @@
 }
 
 
+#pragma mark - <GRMustacheTemplateComponent>
+
+- (void)acceptTemplateComponentVisitor:(id<GRMustacheTemplateComponentVisitor>)visitor
+{
+    [visitor visitVariableTag:self];
+}
+
+
 #pragma mark - Private
 
 - (id)initWithTemplateRepository:(GRMustacheTemplateRepository *)templateRepository expression:(GRMustacheExpression *)expression contentType:(GRMustacheContentType)contentType escapesHTML:(BOOL)escapesHTML
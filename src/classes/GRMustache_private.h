@@ -65,4 +65,19 @@ typedef struct {
  */
 + (NSString *)escapeHTML:(NSString *)string;
 
+/**
+ * Returns YES if the rendering object is provided by GRMustache for nil,
+ * NSNull, NSNumber, NSString, enumerable, and other objects that do not
+ * provide their own rendering: such objects render the content of sections
+ * without processing it.
+ *
+ * @param renderingObject  A rendering object, as returned by
+ *                         renderingObjectForObject:.
+ *
+ * @return YES if the rendering object is provided by GRMustache.
+ *
+ * @see GRMustacheRenderingSegment
+ */
++ (BOOL)isBuiltInRenderingObject:(id<GRMustacheRendering>)renderingObject GRMUSTACHE_API_INTERNAL;
+
 @end
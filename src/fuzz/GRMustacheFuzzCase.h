@@ -0,0 +1,89 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+/**
+ * A fuzz case: a template string, the partials it may embed, and the data it
+ * renders.
+ */
+@interface GRMustacheFuzzCase : NSObject {
+@private
+    NSString *_name;
+    NSString *_templateString;
+    NSDictionary *_partials;
+    id _data;
+}
+
+/**
+ * A name that describes the origin of the case.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ * The template string.
+ */
+@property (nonatomic, copy, readonly) NSString *templateString;
+
+/**
+ * A dictionary of partial template strings, keyed by partial name.
+ */
+@property (nonatomic, copy, readonly) NSDictionary *partials;
+
+/**
+ * The rendered data: a property list, as loaded from JSON.
+ */
+@property (nonatomic, retain, readonly) id data;
+
+/**
+ * Returns a fuzz case.
+ */
++ (instancetype)fuzzCaseWithName:(NSString *)name templateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data;
+
+/**
+ * Returns the fuzz cases found in a test suite of the
+ * tests/Public/v6.0/GRMustacheSuites directory.
+ *
+ * Tests that load templates from the file system (`template_name` key) are
+ * ignored.
+ *
+ * @return An array of GRMustacheFuzzCase, or nil if the file could not be
+ *         read.
+ */
++ (NSArray *)fuzzCasesFromSuiteAtPath:(NSString *)path error:(NSError **)error;
+
+/**
+ * Returns a copy of the receiver, with other template string, partials and
+ * data. Nil arguments keep the values of the receiver.
+ */
+- (instancetype)fuzzCaseWithTemplateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data;
+
+/**
+ * Returns a JSON object in the format of the GRMustacheSuites test suites,
+ * so that a reproducer can be pasted into a test suite.
+ *
+ * @param expectedRendering  The expected rendering, or nil if rendering is
+ *                           expected to fail.
+ */
+- (NSDictionary *)JSONObjectWithExpectedRendering:(NSString *)expectedRendering;
+
+@end
@@ -0,0 +1,125 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheFuzzCase.h"
+
+@interface GRMustacheFuzzCase()
+- (id)initWithName:(NSString *)name templateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data;
+@end
+
+@implementation GRMustacheFuzzCase
+@synthesize name=_name;
+@synthesize templateString=_templateString;
+@synthesize partials=_partials;
+@synthesize data=_data;
+
++ (instancetype)fuzzCaseWithName:(NSString *)name templateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data
+{
+    return [[[self alloc] initWithName:name templateString:templateString partials:partials data:data] autorelease];
+}
+
++ (NSArray *)fuzzCasesFromSuiteAtPath:(NSString *)path error:(NSError **)error
+{
+    NSString *string = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:error];
+    if (!string) {
+        return nil;
+    }
+    
+    // Naive support for single line comments "// ...", as in
+    // GRMustacheTestBase.
+    NSMutableString *commentLessString = [NSMutableString string];
+    NSScanner *scanner = [NSScanner scannerWithString:string];
+    [scanner setCharactersToBeSkipped:nil]; // Keep newlines
+    while (![scanner isAtEnd]) {
+        NSString *chunk;
+        if ([scanner scanUpToString:@"//" intoString:&chunk]) {
+            [commentLessString appendString:chunk];
+        }
+        [scanner scanUpToString:@"\n" intoString:NULL];
+    }
+    
+    NSDictionary *suite = [NSJSONSerialization JSONObjectWithData:[commentLessString dataUsingEncoding:NSUTF8StringEncoding] options:0 error:error];
+    if (!suite) {
+        return nil;
+    }
+    
+    NSMutableArray *fuzzCases = [NSMutableArray array];
+    NSString *suiteName = [[path lastPathComponent] stringByDeletingPathExtension];
+    for (NSDictionary *test in [suite objectForKey:@"tests"]) {
+        NSString *templateString = [test objectForKey:@"template"];
+        id data = [test objectForKey:@"data"];
+        if (![templateString isKindOfClass:[NSString class]] || data == nil) {
+            continue;
+        }
+        NSString *name = [NSString stringWithFormat:@"%@: %@", suiteName, [test objectForKey:@"name"]];
+        [fuzzCases addObject:[self fuzzCaseWithName:name templateString:templateString partials:[test objectForKey:@"partials"] data:data]];
+    }
+    return fuzzCases;
+}
+
+- (void)dealloc
+{
+    [_name release];
+    [_templateString release];
+    [_partials release];
+    [_data release];
+    [super dealloc];
+}
+
+- (id)initWithName:(NSString *)name templateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _templateString = [templateString copy];
+        _partials = [(partials ?: [NSDictionary dictionary]) copy];
+        _data = [(data ?: [NSDictionary dictionary]) retain];
+    }
+    return self;
+}
+
+- (instancetype)fuzzCaseWithTemplateString:(NSString *)templateString partials:(NSDictionary *)partials data:(id)data
+{
+    return [GRMustacheFuzzCase fuzzCaseWithName:_name
+                                 templateString:(templateString ?: _templateString)
+                                       partials:(partials ?: _partials)
+                                           data:(data ?: _data)];
+}
+
+- (NSDictionary *)JSONObjectWithExpectedRendering:(NSString *)expectedRendering
+{
+    NSMutableDictionary *JSONObject = [NSMutableDictionary dictionary];
+    [JSONObject setObject:_name forKey:@"name"];
+    [JSONObject setObject:_data forKey:@"data"];
+    [JSONObject setObject:_templateString forKey:@"template"];
+    if (_partials.count > 0) {
+        [JSONObject setObject:_partials forKey:@"partials"];
+    }
+    if (expectedRendering) {
+        [JSONObject setObject:expectedRendering forKey:@"expected"];
+    } else {
+        [JSONObject setObject:@"" forKey:@"expected_error"];
+    }
+    return JSONObject;
+}
+
+@end
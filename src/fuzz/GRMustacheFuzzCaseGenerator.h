@@ -0,0 +1,65 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class GRMustacheFuzzCase;
+
+/**
+ * Generates random fuzz cases, from the Mustache grammar understood by
+ * GRMustacheParser, and by mutating existing cases.
+ *
+ * Generated templates use variable tags, triple mustaches, sections, inverted
+ * sections, overridable sections, comments, partial tags and template
+ * overrides, with identifiers, implicit iterators, scoped expressions and
+ * filter calls. Generated partials never embed themselves, so that renderings
+ * always terminate.
+ *
+ * Generation is deterministic: two generators created with the same seed
+ * generate the same cases, on all platforms.
+ */
+@interface GRMustacheFuzzCaseGenerator : NSObject {
+@private
+    uint64_t _state;
+    NSUInteger _caseCount;
+}
+
+/**
+ * Returns a generator seeded with _seed_.
+ */
++ (instancetype)generatorWithSeed:(uint64_t)seed;
+
+/**
+ * Returns a random fuzz case.
+ */
+- (GRMustacheFuzzCase *)fuzzCase;
+
+/**
+ * Returns a random mutation of _fuzzCase_: a generated fragment is inserted at
+ * a random position of its template string, generated partials are added to
+ * its partials, and generated values are added to its data.
+ *
+ * The mutated template string may be invalid.
+ */
+- (GRMustacheFuzzCase *)fuzzCaseByMutatingFuzzCase:(GRMustacheFuzzCase *)fuzzCase;
+
+@end
@@ -0,0 +1,282 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheFuzzCaseGenerator.h"
+#import "GRMustacheFuzzCase.h"
+
+// Text that exercises HTML escaping, and standalone lines.
+static NSString * const GRMustacheFuzzTexts[] = {
+    @"a", @"hello", @" ", @"\n", @"  \n", @"<b>", @"&amp;", @"\"'", @"{", @"}", @"é",
+};
+static const NSUInteger GRMustacheFuzzTextCount = sizeof(GRMustacheFuzzTexts) / sizeof(NSString *);
+
+// A small vocabulary, so that tags often find values in generated data.
+static NSString * const GRMustacheFuzzIdentifiers[] = {
+    @"a", @"b", @"list", @"flag", @"name", @"empty",
+};
+static const NSUInteger GRMustacheFuzzIdentifierCount = sizeof(GRMustacheFuzzIdentifiers) / sizeof(NSString *);
+
+// Filters of the standard library that accept any argument.
+static NSString * const GRMustacheFuzzFilters[] = {
+    @"uppercase", @"lowercase", @"capitalized", @"isBlank", @"isEmpty",
+};
+static const NSUInteger GRMustacheFuzzFilterCount = sizeof(GRMustacheFuzzFilters) / sizeof(NSString *);
+
+// Values that exercise escaping, and the boolean value of objects.
+static NSString * const GRMustacheFuzzStrings[] = {
+    @"", @"x", @"<i>&</i>", @"\"quoted\"", @"Hello World", @" ", @"é",
+};
+static const NSUInteger GRMustacheFuzzStringCount = sizeof(GRMustacheFuzzStrings) / sizeof(NSString *);
+
+// Generated partials. The partial at index i may only embed partials at lower
+// indexes, so that renderings always terminate.
+static NSString * const GRMustacheFuzzPartialNames[] = {
+    @"p0", @"p1",
+};
+static const NSUInteger GRMustacheFuzzPartialCount = sizeof(GRMustacheFuzzPartialNames) / sizeof(NSString *);
+
+@interface GRMustacheFuzzCaseGenerator()
+- (id)initWithSeed:(uint64_t)seed;
+- (NSUInteger)randomIntegerLessThan:(NSUInteger)bound;
+- (NSString *)identifier;
+- (NSString *)expressionWithDepth:(NSUInteger)depth;
+- (void)appendComponentsToString:(NSMutableString *)string depth:(NSUInteger)depth partialCount:(NSUInteger)partialCount;
+- (void)appendComponentToString:(NSMutableString *)string depth:(NSUInteger)depth partialCount:(NSUInteger)partialCount;
+- (NSDictionary *)partials;
+- (id)valueWithDepth:(NSUInteger)depth;
+- (NSMutableDictionary *)dictionaryWithDepth:(NSUInteger)depth;
+@end
+
+@implementation GRMustacheFuzzCaseGenerator
+
++ (instancetype)generatorWithSeed:(uint64_t)seed
+{
+    return [[[self alloc] initWithSeed:seed] autorelease];
+}
+
+- (id)initWithSeed:(uint64_t)seed
+{
+    self = [super init];
+    if (self) {
+        // xorshift generators must not be seeded with zero.
+        _state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    }
+    return self;
+}
+
+- (GRMustacheFuzzCase *)fuzzCase
+{
+    NSMutableString *templateString = [NSMutableString string];
+    [self appendComponentsToString:templateString depth:0 partialCount:GRMustacheFuzzPartialCount];
+    NSString *name = [NSString stringWithFormat:@"generated #%lu", (unsigned long)(++_caseCount)];
+    return [GRMustacheFuzzCase fuzzCaseWithName:name templateString:templateString partials:[self partials] data:[self dictionaryWithDepth:0]];
+}
+
+- (GRMustacheFuzzCase *)fuzzCaseByMutatingFuzzCase:(GRMustacheFuzzCase *)fuzzCase
+{
+    // Insert a fragment
+    NSMutableString *templateString = [NSMutableString stringWithString:fuzzCase.templateString];
+    NSMutableString *fragment = [NSMutableString string];
+    [self appendComponentToString:fragment depth:0 partialCount:GRMustacheFuzzPartialCount];
+    [templateString insertString:fragment atIndex:[self randomIntegerLessThan:templateString.length + 1]];
+    
+    // Add generated partials, without overriding existing ones
+    NSMutableDictionary *partials = [NSMutableDictionary dictionaryWithDictionary:[self partials]];
+    [partials addEntriesFromDictionary:fuzzCase.partials];
+    
+    // Add generated values, without overriding existing ones
+    id data = fuzzCase.data;
+    if ([data isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *dictionary = [self dictionaryWithDepth:0];
+        [dictionary addEntriesFromDictionary:data];
+        data = dictionary;
+    }
+    
+    _caseCount += 1;
+    return [GRMustacheFuzzCase fuzzCaseWithName:[NSString stringWithFormat:@"mutated #%lu of %@", (unsigned long)_caseCount, fuzzCase.name]
+                                 templateString:templateString
+                                       partials:partials
+                                           data:data];
+}
+
+
+#pragma mark - Private
+
+- (NSUInteger)randomIntegerLessThan:(NSUInteger)bound
+{
+    // xorshift64*
+    _state ^= _state >> 12;
+    _state ^= _state << 25;
+    _state ^= _state >> 27;
+    return (NSUInteger)((_state * 2685821657736338717ULL) >> 32) % bound;
+}
+
+- (NSString *)identifier
+{
+    return GRMustacheFuzzIdentifiers[[self randomIntegerLessThan:GRMustacheFuzzIdentifierCount]];
+}
+
+- (NSString *)expressionWithDepth:(NSUInteger)depth
+{
+    switch ((depth < 2) ? [self randomIntegerLessThan:6] : 0) {
+        case 0:
+        case 1:
+            return [self identifier];
+        case 2:
+            return @".";
+        case 3:
+            return [NSString stringWithFormat:@"%@.%@", [self identifier], [self identifier]];
+        case 4:
+            return [NSString stringWithFormat:@".%@", [self identifier]];
+        default:
+            return [NSString stringWithFormat:@"%@(%@)", GRMustacheFuzzFilters[[self randomIntegerLessThan:GRMustacheFuzzFilterCount]], [self expressionWithDepth:depth + 1]];
+    }
+}
+
+- (void)appendComponentsToString:(NSMutableString *)string depth:(NSUInteger)depth partialCount:(NSUInteger)partialCount
+{
+    NSUInteger count = [self randomIntegerLessThan:(depth < 3) ? 6 : 2];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [self appendComponentToString:string depth:depth partialCount:partialCount];
+    }
+}
+
+- (void)appendComponentToString:(NSMutableString *)string depth:(NSUInteger)depth partialCount:(NSUInteger)partialCount
+{
+    switch ([self randomIntegerLessThan:12]) {
+        case 0:
+        case 1:
+        case 2:
+            [string appendString:GRMustacheFuzzTexts[[self randomIntegerLessThan:GRMustacheFuzzTextCount]]];
+            break;
+            
+        case 3:
+        case 4:
+            [string appendFormat:@"{{%@}}", [self expressionWithDepth:0]];
+            break;
+            
+        case 5:
+            if ([self randomIntegerLessThan:2]) {
+                [string appendFormat:@"{{{%@}}}", [self expressionWithDepth:0]];
+            } else {
+                [string appendFormat:@"{{& %@ }}", [self expressionWithDepth:0]];
+            }
+            break;
+            
+        case 6:
+        case 7: {
+            // Sections, inverted sections and overridable sections.
+            // Closing tags must repeat the expression of opening tags.
+            static NSString * const types[] = { @"#", @"#", @"^", @"$" };
+            NSString *type = types[[self randomIntegerLessThan:4]];
+            NSString *expression = [type isEqualToString:@"$"] ? [self identifier] : [self expressionWithDepth:0];
+            [string appendFormat:@"{{%@%@}}", type, expression];
+            if (depth < 4) {
+                [self appendComponentsToString:string depth:depth + 1 partialCount:partialCount];
+            }
+            [string appendFormat:@"{{/%@}}", expression];
+        } break;
+            
+        case 8:
+            [string appendFormat:@"{{! %@ }}", [self identifier]];
+            break;
+            
+        case 9:
+            if (partialCount > 0) {
+                [string appendFormat:@"{{> %@ }}", GRMustacheFuzzPartialNames[[self randomIntegerLessThan:partialCount]]];
+            }
+            break;
+            
+        case 10:
+            if (partialCount > 0) {
+                // Template override
+                NSString *partialName = GRMustacheFuzzPartialNames[[self randomIntegerLessThan:partialCount]];
+                [string appendFormat:@"{{<%@}}", partialName];
+                NSString *identifier = [self identifier];
+                [string appendFormat:@"{{$%@}}", identifier];
+                if (depth < 4) {
+                    [self appendComponentsToString:string depth:depth + 1 partialCount:partialCount];
+                }
+                [string appendFormat:@"{{/%@}}{{/%@}}", identifier, partialName];
+            }
+            break;
+            
+        default:
+            if (depth < 4) {
+                // Standalone tags
+                NSString *identifier = [self identifier];
+                [string appendFormat:@"\n  {{#%@}}  \n", identifier];
+                [self appendComponentsToString:string depth:depth + 1 partialCount:partialCount];
+                [string appendFormat:@"\n  {{/%@}}  \n", identifier];
+            }
+            break;
+    }
+}
+
+- (NSDictionary *)partials
+{
+    NSMutableDictionary *partials = [NSMutableDictionary dictionary];
+    for (NSUInteger index = 0; index < GRMustacheFuzzPartialCount; ++index) {
+        NSMutableString *partialString = [NSMutableString string];
+        [self appendComponentsToString:partialString depth:1 partialCount:index];
+        [partials setObject:partialString forKey:GRMustacheFuzzPartialNames[index]];
+    }
+    return partials;
+}
+
+- (id)valueWithDepth:(NSUInteger)depth
+{
+    switch ([self randomIntegerLessThan:(depth < 3) ? 8 : 5]) {
+        case 0:
+        case 1:
+            return GRMustacheFuzzStrings[[self randomIntegerLessThan:GRMustacheFuzzStringCount]];
+        case 2:
+            return [NSNumber numberWithInteger:(NSInteger)[self randomIntegerLessThan:5] - 1];
+        case 3:
+            return [NSNumber numberWithBool:[self randomIntegerLessThan:2]];
+        case 4:
+            return [NSNull null];
+        case 5:
+        case 6: {
+            NSUInteger count = [self randomIntegerLessThan:4];
+            NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+            for (NSUInteger i = 0; i < count; ++i) {
+                [array addObject:[self valueWithDepth:depth + 1]];
+            }
+            return array;
+        }
+        default:
+            return [self dictionaryWithDepth:depth + 1];
+    }
+}
+
+- (NSMutableDictionary *)dictionaryWithDepth:(NSUInteger)depth
+{
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    NSUInteger count = [self randomIntegerLessThan:GRMustacheFuzzIdentifierCount + 1];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [dictionary setObject:[self valueWithDepth:depth] forKey:[self identifier]];
+    }
+    return dictionary;
+}
+
+@end
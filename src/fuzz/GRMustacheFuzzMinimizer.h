@@ -0,0 +1,51 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class GRMustacheFuzzCase;
+
+/**
+ * A predicate that tells whether a fuzz case still exhibits a failure.
+ */
+typedef BOOL (^GRMustacheFuzzPredicate)(GRMustacheFuzzCase *fuzzCase);
+
+/**
+ * Shrinks failing fuzz cases into minimal reproducers.
+ */
+@interface GRMustacheFuzzMinimizer : NSObject
+
+/**
+ * Returns a fuzz case that is smaller than, or equal to, _fuzzCase_, and that
+ * satisfies _predicate_.
+ *
+ * The template string and partials are shrunk by removing chunks of
+ * decreasing length (delta debugging), unused partials are removed, and data
+ * is shrunk by removing dictionary keys and array elements. Those steps are
+ * repeated until no further progress is made.
+ *
+ * @param fuzzCase   A fuzz case that satisfies _predicate_.
+ * @param predicate  The failure to preserve.
+ */
++ (GRMustacheFuzzCase *)minimizedFuzzCase:(GRMustacheFuzzCase *)fuzzCase predicate:(GRMustacheFuzzPredicate)predicate;
+
+@end
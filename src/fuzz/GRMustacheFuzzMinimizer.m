@@ -0,0 +1,161 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheFuzzMinimizer.h"
+#import "GRMustacheFuzzCase.h"
+
+// Bounds the number of passes over a case.
+static const NSUInteger GRMustacheFuzzMinimizerMaximumPassCount = 16;
+
+@interface GRMustacheFuzzMinimizer()
++ (NSString *)minimizedString:(NSString *)string predicate:(BOOL(^)(NSString *candidate))predicate;
++ (id)minimizedObject:(id)object predicate:(BOOL(^)(id candidate))predicate;
+@end
+
+@implementation GRMustacheFuzzMinimizer
+
++ (GRMustacheFuzzCase *)minimizedFuzzCase:(GRMustacheFuzzCase *)fuzzCase predicate:(GRMustacheFuzzPredicate)predicate
+{
+    __block GRMustacheFuzzCase *current = fuzzCase;
+    for (NSUInteger pass = 0; pass < GRMustacheFuzzMinimizerMaximumPassCount; ++pass) {
+        GRMustacheFuzzCase *passStart = current;
+        
+        // Template string
+        [self minimizedString:current.templateString predicate:^BOOL(NSString *candidate) {
+            GRMustacheFuzzCase *candidateCase = [current fuzzCaseWithTemplateString:candidate partials:nil data:nil];
+            if (!predicate(candidateCase)) return NO;
+            current = candidateCase;
+            return YES;
+        }];
+        
+        // Partials: remove them, or shrink them
+        for (NSString *partialName in [current.partials allKeys]) {
+            NSMutableDictionary *partials = [NSMutableDictionary dictionaryWithDictionary:current.partials];
+            [partials removeObjectForKey:partialName];
+            GRMustacheFuzzCase *candidateCase = [current fuzzCaseWithTemplateString:nil partials:partials data:nil];
+            if (predicate(candidateCase)) {
+                current = candidateCase;
+                continue;
+            }
+            
+            [self minimizedString:[current.partials objectForKey:partialName] predicate:^BOOL(NSString *candidate) {
+                NSMutableDictionary *partials = [NSMutableDictionary dictionaryWithDictionary:current.partials];
+                [partials setObject:candidate forKey:partialName];
+                GRMustacheFuzzCase *candidateCase = [current fuzzCaseWithTemplateString:nil partials:partials data:nil];
+                if (!predicate(candidateCase)) return NO;
+                current = candidateCase;
+                return YES;
+            }];
+        }
+        
+        // Data
+        [self minimizedObject:current.data predicate:^BOOL(id candidate) {
+            GRMustacheFuzzCase *candidateCase = [current fuzzCaseWithTemplateString:nil partials:nil data:candidate];
+            if (!predicate(candidateCase)) return NO;
+            current = candidateCase;
+            return YES;
+        }];
+        
+        if (current == passStart) {
+            break;
+        }
+    }
+    return current;
+}
+
+
+#pragma mark - Private
+
+/**
+ * Delta debugging: removes chunks of decreasing length from string, as long
+ * as predicate accepts the shorter string.
+ */
++ (NSString *)minimizedString:(NSString *)string predicate:(BOOL(^)(NSString *candidate))predicate
+{
+    for (NSUInteger chunkLength = MAX(string.length / 2, 1); ; chunkLength /= 2) {
+        NSUInteger location = 0;
+        while (location < string.length) {
+            NSRange range = NSMakeRange(location, MIN(chunkLength, string.length - location));
+            NSString *candidate = [string stringByReplacingCharactersInRange:range withString:@""];
+            if (predicate(candidate)) {
+                string = candidate;
+            } else {
+                location += chunkLength;
+            }
+        }
+        if (chunkLength == 1) {
+            break;
+        }
+    }
+    return string;
+}
+
+/**
+ * Removes dictionary keys and array elements from object, recursively, as
+ * long as predicate accepts the smaller object.
+ */
++ (id)minimizedObject:(id)object predicate:(BOOL(^)(id candidate))predicate
+{
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        __block NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithDictionary:object];
+        for (id key in [dictionary allKeys]) {
+            NSMutableDictionary *candidate = [NSMutableDictionary dictionaryWithDictionary:dictionary];
+            [candidate removeObjectForKey:key];
+            if (predicate(candidate)) {
+                dictionary = candidate;
+                continue;
+            }
+            [self minimizedObject:[dictionary objectForKey:key] predicate:^BOOL(id value) {
+                NSMutableDictionary *candidate = [NSMutableDictionary dictionaryWithDictionary:dictionary];
+                [candidate setObject:value forKey:key];
+                if (!predicate(candidate)) return NO;
+                dictionary = candidate;
+                return YES;
+            }];
+        }
+        return dictionary;
+    }
+    
+    if ([object isKindOfClass:[NSArray class]]) {
+        __block NSMutableArray *array = [NSMutableArray arrayWithArray:object];
+        for (NSUInteger index = array.count; index > 0; --index) {
+            NSMutableArray *candidate = [NSMutableArray arrayWithArray:array];
+            [candidate removeObjectAtIndex:index - 1];
+            if (predicate(candidate)) {
+                array = candidate;
+                continue;
+            }
+            [self minimizedObject:[array objectAtIndex:index - 1] predicate:^BOOL(id value) {
+                NSMutableArray *candidate = [NSMutableArray arrayWithArray:array];
+                [candidate replaceObjectAtIndex:index - 1 withObject:value];
+                if (!predicate(candidate)) return NO;
+                array = candidate;
+                return YES;
+            }];
+        }
+        return array;
+    }
+    
+    return object;
+}
+
+@end
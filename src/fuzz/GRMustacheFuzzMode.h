@@ -0,0 +1,72 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+@class GRMustacheFuzzCase;
+
+/**
+ * A rendering mode: a way to render a fuzz case.
+ *
+ * The reference mode renders templates built from strings, with the default
+ * configuration, and no tag delegate, profiler or tracer. Other modes enable
+ * the optional code paths of the rendering engine. They must all render the
+ * same outputs, and fail for the same cases, as the reference mode.
+ *
+ * New fast paths of the rendering engine should register a mode in
+ * +alternateModes.
+ */
+@interface GRMustacheFuzzMode : NSObject {
+@private
+    NSString *_name;
+    NSString *(^_block)(GRMustacheFuzzCase *fuzzCase, NSError **error);
+}
+
+/**
+ * The name of the mode.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ * The reference mode.
+ */
++ (instancetype)referenceMode;
+
+/**
+ * The modes that are compared to the reference mode.
+ */
++ (NSArray *)alternateModes;
+
+/**
+ * Renders a fuzz case, and returns a string that describes the outcome: the
+ * rendering, or the error code, or the name of an exception.
+ *
+ * Two modes agree on a case when they return equal outcomes.
+ */
+- (NSString *)outcomeForFuzzCase:(GRMustacheFuzzCase *)fuzzCase;
+
+/**
+ * Returns the rendering of a fuzz case, or nil if the rendering fails.
+ */
+- (NSString *)renderingForFuzzCase:(GRMustacheFuzzCase *)fuzzCase;
+
+@end
@@ -0,0 +1,342 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustacheFuzzMode.h"
+#import "GRMustacheFuzzCase.h"
+#import "GRMustache.h"
+
+typedef NSString *(^GRMustacheFuzzModeBlock)(GRMustacheFuzzCase *fuzzCase, NSError **error);
+
+// The name of the main template in repositories that load it by name.
+static NSString * const GRMustacheFuzzMainTemplateName = @"GRMustacheFuzzMain";
+
+
+// =============================================================================
+#pragma mark - Helpers
+
+/**
+ * A tag delegate that does not change anything.
+ */
+@interface GRMustacheFuzzTagDelegate : NSObject<GRMustacheTagDelegate>
+@end
+
+@implementation GRMustacheFuzzTagDelegate
+
+- (id)mustacheTag:(GRMustacheTag *)tag willRenderObject:(id)object
+{
+    return object;
+}
+
+- (void)mustacheTag:(GRMustacheTag *)tag didRenderObject:(id)object as:(NSString *)rendering
+{
+}
+
+- (void)mustacheTag:(GRMustacheTag *)tag didFailRenderingObject:(id)object withError:(NSError *)error
+{
+}
+
+@end
+
+/**
+ * A tracer that does not do anything.
+ */
+@interface GRMustacheFuzzTracer : NSObject<GRMustacheTracer>
+@end
+
+@implementation GRMustacheFuzzTracer
+
+- (void)mustacheTemplate:(GRMustacheTemplate *)template willBeginSpanWithTemplateID:(id)templateID
+{
+}
+
+- (void)mustacheTemplate:(GRMustacheTemplate *)template didEndSpanWithTemplateID:(id)templateID duration:(NSTimeInterval)duration renderedLength:(NSUInteger)renderedLength success:(BOOL)success
+{
+}
+
+@end
+
+/**
+ * A collection that enumerates the items of an array, but does not respond to
+ * `count`, so that enumerated sections can not know their last item in
+ * advance.
+ */
+@interface GRMustacheFuzzEnumerable : NSObject<NSFastEnumeration> {
+@private
+    NSArray *_array;
+}
+- (id)initWithArray:(NSArray *)array;
+@end
+
+@implementation GRMustacheFuzzEnumerable
+
+- (void)dealloc
+{
+    [_array release];
+    [super dealloc];
+}
+
+- (id)initWithArray:(NSArray *)array
+{
+    self = [super init];
+    if (self) {
+        _array = [array retain];
+    }
+    return self;
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id *)buffer count:(NSUInteger)len
+{
+    return [_array countByEnumeratingWithState:state objects:buffer count:len];
+}
+
+- (NSString *)description
+{
+    // Filters such as uppercase render the description of their argument.
+    return [_array description];
+}
+
+@end
+
+/**
+ * Returns a copy of _object_ where arrays have been replaced by
+ * GRMustacheFuzzEnumerable instances.
+ */
+static id GRMustacheFuzzObjectWithoutCounts(id object)
+{
+    if ([object isKindOfClass:[NSArray class]]) {
+        NSMutableArray *array = [NSMutableArray arrayWithCapacity:[object count]];
+        for (id item in object) {
+            [array addObject:GRMustacheFuzzObjectWithoutCounts(item)];
+        }
+        return [[[GRMustacheFuzzEnumerable alloc] initWithArray:array] autorelease];
+    }
+    if ([object isKindOfClass:[NSDictionary class]]) {
+        NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:[object count]];
+        for (id key in object) {
+            [dictionary setObject:GRMustacheFuzzObjectWithoutCounts([object objectForKey:key]) forKey:key];
+        }
+        return dictionary;
+    }
+    return object;
+}
+
+static GRMustacheTemplate *GRMustacheFuzzTemplateFromString(GRMustacheFuzzCase *fuzzCase, GRMustacheConfiguration *configuration, NSError **error)
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:fuzzCase.partials];
+    if (configuration) {
+        repository.configuration = configuration;
+    }
+    return [repository templateFromString:fuzzCase.templateString error:error];
+}
+
+
+// =============================================================================
+#pragma mark - GRMustacheFuzzMode
+
+@interface GRMustacheFuzzMode()
++ (instancetype)modeWithName:(NSString *)name block:(GRMustacheFuzzModeBlock)block;
+- (id)initWithName:(NSString *)name block:(GRMustacheFuzzModeBlock)block;
+@end
+
+@implementation GRMustacheFuzzMode
+@synthesize name=_name;
+
++ (instancetype)modeWithName:(NSString *)name block:(GRMustacheFuzzModeBlock)block
+{
+    return [[[self alloc] initWithName:name block:block] autorelease];
+}
+
++ (instancetype)referenceMode
+{
+    return [self modeWithName:@"reference" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+        GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+        return [template renderObject:fuzzCase.data error:error];
+    }];
+}
+
++ (NSArray *)alternateModes
+{
+    return [NSArray arrayWithObjects:
+            
+            // Rendering of an array of objects
+            [self modeWithName:@"objects_from_array" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                return [template renderObjectsFromArray:[NSArray arrayWithObject:fuzzCase.data] error:error];
+            }],
+            
+            // Templates loaded by name, cached by their repository, and
+            // rendered twice.
+            [self modeWithName:@"cached_template" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                NSMutableDictionary *templates = [NSMutableDictionary dictionaryWithDictionary:fuzzCase.partials];
+                [templates setObject:fuzzCase.templateString forKey:GRMustacheFuzzMainTemplateName];
+                GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+                GRMustacheTemplate *template = [repository templateNamed:GRMustacheFuzzMainTemplateName error:error];
+                [template renderObject:fuzzCase.data error:NULL];
+                template = [repository templateNamed:GRMustacheFuzzMainTemplateName error:error];
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Tag delegates
+            [self modeWithName:@"tag_delegate" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                GRMustacheFuzzTagDelegate *tagDelegate = [[[GRMustacheFuzzTagDelegate alloc] init] autorelease];
+                template.baseContext = [template.baseContext contextByAddingTagDelegate:tagDelegate];
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Profiling
+            [self modeWithName:@"profiler" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                template.baseContext = [template.baseContext contextByAddingProfiler:[GRMustacheProfiler profiler]];
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Tracing
+            [self modeWithName:@"tracer" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                GRMustacheFuzzTracer *tracer = [[[GRMustacheFuzzTracer alloc] init] autorelease];
+                template.baseContext = [template.baseContext contextByAddingTracer:tracer];
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Rendering limits that are never reached, so that renderings go
+            // through the accounting of rendering sessions.
+            [self modeWithName:@"rendering_limits" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheConfiguration *configuration = [GRMustacheConfiguration configuration];
+                configuration.maximumRenderedLength = NSUIntegerMax;
+                configuration.maximumIterationCount = NSUIntegerMax;
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, configuration, error);
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Collections that do not respond to count, so that sections go
+            // through the loop that renders items one step late.
+            [self modeWithName:@"collections_without_count" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                return [template renderObject:GRMustacheFuzzObjectWithoutCounts(fuzzCase.data) error:error];
+            }],
+            
+            // Fragment cache: the template is wrapped in a cached section,
+            // and the second rendering comes from the cache. The template is
+            // embedded as a partial, so that the wrapping section does not
+            // alter standalone lines.
+            [self modeWithName:@"fragment_cache" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                NSMutableDictionary *templates = [NSMutableDictionary dictionaryWithDictionary:fuzzCase.partials];
+                [templates setObject:fuzzCase.templateString forKey:GRMustacheFuzzMainTemplateName];
+                GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+                NSDictionary *cacheObject = [NSDictionary dictionaryWithObjectsAndKeys:
+                                             [GRMustacheFragmentCache fragmentCache], @"GRMustacheFuzzCache",
+                                             @"key", @"GRMustacheFuzzCacheKey",
+                                             nil];
+                repository.configuration.baseContext = [repository.configuration.baseContext contextByAddingProtectedObject:cacheObject];
+                NSString *templateString = [NSString stringWithFormat:@"{{#GRMustacheFuzzCache(GRMustacheFuzzCacheKey)}}{{>%@}}{{/}}", GRMustacheFuzzMainTemplateName];
+                GRMustacheTemplate *template = [repository templateFromString:templateString error:error];
+                [template renderObject:fuzzCase.data error:NULL];
+                return [template renderObject:fuzzCase.data error:error];
+            }],
+            
+            // Incremental rendering, updated for all the top-level keys of
+            // the data.
+            [self modeWithName:@"incremental_rendering" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                if (template == nil) {
+                    return nil;
+                }
+                GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:fuzzCase.data error:error];
+                if (rendering == nil) {
+                    return nil;
+                }
+                NSSet *keyPaths = [NSSet set];
+                if ([fuzzCase.data isKindOfClass:[NSDictionary class]]) {
+                    keyPaths = [NSSet setWithArray:[fuzzCase.data allKeys]];
+                }
+                if (![rendering updateWithChangedKeyPaths:keyPaths error:error]) {
+                    return nil;
+                }
+                return rendering.string;
+            }],
+            
+            // Template specialization. Generated data is not protected, so no
+            // value is frozen: this mode checks that residual templates, and
+            // the residual partials they embed, render like the original
+            // template. Frozen values are covered by the unit tests.
+            [self modeWithName:@"specialization" block:^NSString *(GRMustacheFuzzCase *fuzzCase, NSError **error) {
+                GRMustacheTemplate *template = GRMustacheFuzzTemplateFromString(fuzzCase, nil, error);
+                if (template == nil) {
+                    return nil;
+                }
+                GRMustacheTemplate *residual = [template templateBySpecializingWithContext:template.baseContext];
+                return [residual renderObject:fuzzCase.data error:error];
+            }],
+            
+            nil];
+}
+
+- (void)dealloc
+{
+    [_name release];
+    [_block release];
+    [super dealloc];
+}
+
+- (id)initWithName:(NSString *)name block:(GRMustacheFuzzModeBlock)block
+{
+    self = [super init];
+    if (self) {
+        _name = [name copy];
+        _block = [block copy];
+    }
+    return self;
+}
+
+- (NSString *)outcomeForFuzzCase:(GRMustacheFuzzCase *)fuzzCase
+{
+    NSString *outcome = nil;
+    @autoreleasepool {
+        @try {
+            NSError *error = nil;
+            NSString *rendering = _block(fuzzCase, &error);
+            if (rendering) {
+                outcome = [[NSString alloc] initWithFormat:@"rendering: %@", rendering];
+            } else {
+                // Error messages are not compared: only error codes are.
+                outcome = [[NSString alloc] initWithFormat:@"error: %@ %ld", error.domain, (long)error.code];
+            }
+        }
+        @catch (NSException *exception) {
+            outcome = [[NSString alloc] initWithFormat:@"exception: %@", exception.name];
+        }
+    }
+    return [outcome autorelease];
+}
+
+- (NSString *)renderingForFuzzCase:(GRMustacheFuzzCase *)fuzzCase
+{
+    @try {
+        return _block(fuzzCase, NULL);
+    }
+    @catch (NSException *exception) {
+        return nil;
+    }
+}
+
+@end
@@ -0,0 +1,162 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// GRMustacheFuzz renders random cases through the reference rendering mode,
+// and through alternate modes that enable optional code paths of the
+// rendering engine (see GRMustacheFuzzMode). It reports the cases where a mode
+// disagrees with the reference mode.
+//
+// Usage: GRMustacheFuzz [--seed <integer>] [--count <integer>]
+//                       [--suites <directory>] [--json]
+//
+// Cases are the tests of the GRMustacheSuites test suites, found in the
+// directory given by --suites, then --count cases that are either generated
+// from the Mustache grammar, or mutations of test suite cases.
+//
+// Each divergence is minimized (see GRMustacheFuzzMinimizer) before it is
+// reported. With --json, each minimized reproducer is printed as a JSON object
+// on its own line, in the format of the GRMustacheSuites test suites, with the
+// rendering of the reference mode as the expected rendering.
+//
+// The exit status is 1 when a divergence was found.
+
+#import <Foundation/Foundation.h>
+#import "GRMustacheFuzzCase.h"
+#import "GRMustacheFuzzCaseGenerator.h"
+#import "GRMustacheFuzzMode.h"
+#import "GRMustacheFuzzMinimizer.h"
+
+static NSString *GRMustacheFuzzJSONString(id JSONObject)
+{
+    NSData *data = [NSJSONSerialization dataWithJSONObject:JSONObject options:0 error:NULL];
+    return [[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding] autorelease];
+}
+
+/**
+ * Renders _fuzzCase_ through all modes, and reports divergences.
+ *
+ * @return YES if all modes agree with the reference mode.
+ */
+static BOOL GRMustacheFuzzCheck(GRMustacheFuzzCase *fuzzCase, GRMustacheFuzzMode *referenceMode, NSArray *alternateModes, BOOL JSON)
+{
+    BOOL success = YES;
+    NSString *referenceOutcome = [referenceMode outcomeForFuzzCase:fuzzCase];
+    for (GRMustacheFuzzMode *mode in alternateModes) {
+        if ([[mode outcomeForFuzzCase:fuzzCase] isEqualToString:referenceOutcome]) {
+            continue;
+        }
+        success = NO;
+        
+        GRMustacheFuzzCase *reproducer = [GRMustacheFuzzMinimizer minimizedFuzzCase:fuzzCase predicate:^BOOL(GRMustacheFuzzCase *candidate) {
+            return ![[mode outcomeForFuzzCase:candidate] isEqualToString:[referenceMode outcomeForFuzzCase:candidate]];
+        }];
+        
+        if (JSON) {
+            NSMutableDictionary *JSONObject = [NSMutableDictionary dictionaryWithDictionary:[reproducer JSONObjectWithExpectedRendering:[referenceMode renderingForFuzzCase:reproducer]]];
+            [JSONObject setObject:mode.name forKey:@"mode"];
+            printf("%s\n", [GRMustacheFuzzJSONString(JSONObject) UTF8String]);
+        } else {
+            printf("DIVERGENCE in mode %s: %s\n", [mode.name UTF8String], [fuzzCase.name UTF8String]);
+            printf("  template:  %s\n", [GRMustacheFuzzJSONString([NSArray arrayWithObject:reproducer.templateString]) UTF8String]);
+            printf("  partials:  %s\n", [GRMustacheFuzzJSONString(reproducer.partials) UTF8String]);
+            printf("  data:      %s\n", [GRMustacheFuzzJSONString([NSArray arrayWithObject:reproducer.data]) UTF8String]);
+            printf("  reference: %s\n", [[referenceMode outcomeForFuzzCase:reproducer] UTF8String]);
+            printf("  %-10s %s\n", [[mode.name stringByAppendingString:@":"] UTF8String], [[mode outcomeForFuzzCase:reproducer] UTF8String]);
+        }
+        fflush(stdout);
+    }
+    return success;
+}
+
+int main(int argc, const char * argv[])
+{
+    @autoreleasepool {
+        uint64_t seed = 1;
+        NSUInteger count = 1000;
+        NSString *suitesPath = @"../tests/Public/v6.0/GRMustacheSuites";
+        BOOL JSON = NO;
+        
+        for (int i = 1; i < argc; ++i) {
+            if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = strtoull(argv[++i], NULL, 10);
+            } else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+                count = (NSUInteger)strtoull(argv[++i], NULL, 10);
+            } else if (strcmp(argv[i], "--suites") == 0 && i + 1 < argc) {
+                suitesPath = [NSString stringWithUTF8String:argv[++i]];
+            } else if (strcmp(argv[i], "--json") == 0) {
+                JSON = YES;
+            } else {
+                fprintf(stderr, "usage: %s [--seed <integer>] [--count <integer>] [--suites <directory>] [--json]\n", argv[0]);
+                return 2;
+            }
+        }
+        
+        // Load test suites
+        NSMutableArray *suiteCases = [NSMutableArray array];
+        NSArray *fileNames = [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:suitesPath error:NULL] sortedArrayUsingSelector:@selector(compare:)];
+        for (NSString *fileName in fileNames) {
+            if (![[fileName pathExtension] isEqualToString:@"json"]) {
+                continue;
+            }
+            NSError *error;
+            NSArray *fuzzCases = [GRMustacheFuzzCase fuzzCasesFromSuiteAtPath:[suitesPath stringByAppendingPathComponent:fileName] error:&error];
+            if (!fuzzCases) {
+                fprintf(stderr, "%s: %s\n", [fileName UTF8String], [[error localizedDescription] UTF8String]);
+                return 1;
+            }
+            [suiteCases addObjectsFromArray:fuzzCases];
+        }
+        
+        GRMustacheFuzzMode *referenceMode = [GRMustacheFuzzMode referenceMode];
+        NSArray *alternateModes = [GRMustacheFuzzMode alternateModes];
+        NSUInteger divergenceCount = 0;
+        
+        for (GRMustacheFuzzCase *fuzzCase in suiteCases) {
+            @autoreleasepool {
+                if (!GRMustacheFuzzCheck(fuzzCase, referenceMode, alternateModes, JSON)) {
+                    ++divergenceCount;
+                }
+            }
+        }
+        
+        GRMustacheFuzzCaseGenerator *generator = [GRMustacheFuzzCaseGenerator generatorWithSeed:seed];
+        for (NSUInteger index = 0; index < count; ++index) {
+            @autoreleasepool {
+                GRMustacheFuzzCase *fuzzCase;
+                if (suiteCases.count > 0 && (index % 2 == 1)) {
+                    fuzzCase = [generator fuzzCaseByMutatingFuzzCase:[suiteCases objectAtIndex:(index / 2) % suiteCases.count]];
+                } else {
+                    fuzzCase = [generator fuzzCase];
+                }
+                if (!GRMustacheFuzzCheck(fuzzCase, referenceMode, alternateModes, JSON)) {
+                    ++divergenceCount;
+                }
+            }
+        }
+        
+        fprintf(stderr, "%lu cases, %lu modes, %lu divergent cases\n",
+                (unsigned long)(suiteCases.count + count),
+                (unsigned long)alternateModes.count,
+                (unsigned long)divergenceCount);
+        return (divergenceCount > 0) ? 1 : 0;
+    }
+}
@@ -0,0 +1,155 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustachePrivateAPITest.h"
+#import "GRMustacheMappedString_private.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateRepository_private.h"
+
+@interface GRMustacheMappedStringTest : GRMustachePrivateAPITest
+@end
+
+@implementation GRMustacheMappedStringTest
+
+- (NSString *)pathForString:(NSString *)string encoding:(NSStringEncoding)encoding
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheMappedStringTest.mustache"];
+    [[string dataUsingEncoding:encoding] writeToFile:path atomically:YES];
+    return path;
+}
+
+- (void)testASCIIFilesAreMapped
+{
+    NSString *source = [@"" stringByPaddingToLength:100 withString:@"<{{name}}>" startingAtIndex:0];
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:[self pathForString:source encoding:NSUTF8StringEncoding] encoding:NSUTF8StringEncoding error:NULL];
+    STAssertTrue([string isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(string, source, @"");
+    STAssertEquals([string characterAtIndex:1], (unichar)'{', @"");
+    
+    // Long substrings share the mapping, short ones don't.
+    NSString *longSubstring = [string substringFromIndex:10];
+    STAssertTrue([longSubstring isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(longSubstring, [source substringFromIndex:10], @"");
+    NSString *shortSubstring = [string substringWithRange:NSMakeRange(3, 4)];
+    STAssertFalse([shortSubstring isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(shortSubstring, @"name", @"");
+}
+
+- (void)testISOLatin1FilesAreMapped
+{
+    NSString *source = @"Ils s'étaient aimés";
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:[self pathForString:source encoding:NSISOLatin1StringEncoding] encoding:NSISOLatin1StringEncoding error:NULL];
+    STAssertTrue([string isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(string, source, @"");
+}
+
+- (void)testNonASCIIUTF8FilesAreDecoded
+{
+    NSString *source = @"Ils s'étaient aimés";
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:[self pathForString:source encoding:NSUTF8StringEncoding] encoding:NSUTF8StringEncoding error:NULL];
+    STAssertFalse([string isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(string, source, @"");
+}
+
+- (NSString *)pathForString:(NSString *)string encoding:(NSStringEncoding)encoding byteOrderMark:(NSData *)byteOrderMark
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheMappedStringTest.mustache"];
+    NSMutableData *data = [NSMutableData dataWithData:byteOrderMark];
+    [data appendData:[string dataUsingEncoding:encoding]];
+    [data writeToFile:path atomically:YES];
+    return path;
+}
+
+- (void)testLongASCIIFilesWithTrailingNonASCIICharacterAreDecoded
+{
+    NSString *source = [[@"" stringByPaddingToLength:100 withString:@"<{{name}}>" startingAtIndex:0] stringByAppendingString:@"é"];
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:[self pathForString:source encoding:NSUTF8StringEncoding] encoding:NSUTF8StringEncoding error:NULL];
+    STAssertFalse([string isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(string, source, @"");
+}
+
+- (void)testUTF8ByteOrderMarkIsSkipped
+{
+    const uint8_t byteOrderMark[] = { 0xEF, 0xBB, 0xBF };
+    NSString *source = [@"" stringByPaddingToLength:100 withString:@"<{{name}}>" startingAtIndex:0];
+    NSString *path = [self pathForString:source encoding:NSUTF8StringEncoding byteOrderMark:[NSData dataWithBytes:byteOrderMark length:sizeof(byteOrderMark)]];
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL];
+    STAssertTrue([string isKindOfClass:[GRMustacheMappedString class]], @"");
+    STAssertEqualObjects(string, source, @"");
+}
+
+- (void)testByteOrderMarkOverridesEncoding
+{
+    NSString *source = @"Ils s'étaient aimés";
+    
+    const uint8_t UTF8ByteOrderMark[] = { 0xEF, 0xBB, 0xBF };
+    NSString *path = [self pathForString:source encoding:NSUTF8StringEncoding byteOrderMark:[NSData dataWithBytes:UTF8ByteOrderMark length:sizeof(UTF8ByteOrderMark)]];
+    STAssertEqualObjects([GRMustacheMappedString stringWithContentsOfFile:path encoding:NSISOLatin1StringEncoding error:NULL], source, @"");
+    
+    const uint8_t UTF16LEByteOrderMark[] = { 0xFF, 0xFE };
+    path = [self pathForString:source encoding:NSUTF16LittleEndianStringEncoding byteOrderMark:[NSData dataWithBytes:UTF16LEByteOrderMark length:sizeof(UTF16LEByteOrderMark)]];
+    STAssertEqualObjects([GRMustacheMappedString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL], source, @"");
+    
+    const uint8_t UTF16BEByteOrderMark[] = { 0xFE, 0xFF };
+    path = [self pathForString:source encoding:NSUTF16BigEndianStringEncoding byteOrderMark:[NSData dataWithBytes:UTF16BEByteOrderMark length:sizeof(UTF16BEByteOrderMark)]];
+    STAssertEqualObjects([GRMustacheMappedString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL], source, @"");
+    
+    const uint8_t UTF32LEByteOrderMark[] = { 0xFF, 0xFE, 0x00, 0x00 };
+    path = [self pathForString:source encoding:NSUTF32LittleEndianStringEncoding byteOrderMark:[NSData dataWithBytes:UTF32LEByteOrderMark length:sizeof(UTF32LEByteOrderMark)]];
+    STAssertEqualObjects([GRMustacheMappedString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:NULL], source, @"");
+}
+
+- (void)testInvalidBytesReturnErrors
+{
+    const uint8_t bytes[] = { 'a', 0xC3, 'b' };
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheMappedStringTest.mustache"];
+    [[NSData dataWithBytes:bytes length:sizeof(bytes)] writeToFile:path atomically:YES];
+    NSError *error;
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:&error];
+    STAssertNil(string, @"");
+    STAssertEquals(error.code, (NSInteger)NSFileReadInapplicableStringEncodingError, @"");
+}
+
+- (void)testMissingFilesReturnErrors
+{
+    NSError *error;
+    NSString *string = [GRMustacheMappedString stringWithContentsOfFile:@"/GRMustacheMappedStringTest/missing" encoding:NSUTF8StringEncoding error:&error];
+    STAssertNil(string, @"");
+    STAssertNotNil(error, @"");
+}
+
+- (void)testMappedTemplatesRender
+{
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheMappedStringTest"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directoryPath withIntermediateDirectories:YES attributes:nil error:NULL];
+    NSString *text = [@"" stringByPaddingToLength:100 withString:@"-" startingAtIndex:0];
+    NSString *templateString = [NSString stringWithFormat:@"%@{{#items}}<{{name}}>{{/items}}%@", text, text];
+    [[templateString dataUsingEncoding:NSUTF8StringEncoding] writeToFile:[directoryPath stringByAppendingPathComponent:@"main.mustache"] atomically:YES];
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDirectory:directoryPath];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    id data = @{ @"items": @[@{ @"name": @"a" }, @{ @"name": @"b" }] };
+    NSString *rendering = [template renderObject:data error:NULL];
+    STAssertEqualObjects(rendering, ([NSString stringWithFormat:@"%@<a><b>%@", text, text]), @"");
+}
+
+@end
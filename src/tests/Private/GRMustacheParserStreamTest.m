@@ -0,0 +1,194 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustachePrivateAPITest.h"
+#import "GRMustacheParser_private.h"
+#import "GRMustacheSpooledString_private.h"
+#import "GRMustacheConfiguration_private.h"
+#import "GRMustacheError.h"
+
+@interface GRMustacheStreamTokenRecorder : NSObject<GRMustacheParserDelegate> {
+    NSMutableArray *_descriptions;
+    NSMutableArray *_tokens;
+    NSError *_error;
+}
+@property (nonatomic, retain, readonly) NSArray *descriptions;
+@property (nonatomic, retain, readonly) NSArray *tokens;
+@property (nonatomic, retain, readonly) NSError *error;
+@end
+
+@implementation GRMustacheStreamTokenRecorder
+@synthesize descriptions=_descriptions;
+@synthesize tokens=_tokens;
+@synthesize error=_error;
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _descriptions = [[NSMutableArray alloc] init];
+        _tokens = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_descriptions release];
+    [_tokens release];
+    [_error release];
+    [super dealloc];
+}
+
+- (BOOL)parser:(GRMustacheParser *)parser shouldContinueAfterParsingToken:(GRMustacheToken *)token
+{
+    [_tokens addObject:token];
+    [_descriptions addObject:[NSString stringWithFormat:@"%ld line:%lu range:%@ substring:%@ text:%@ partial:%@ pragma:%@",
+                              (long)token.type,
+                              (unsigned long)token.line,
+                              NSStringFromRange(token.range),
+                              token.templateSubstring,
+                              token.text,
+                              token.partialName,
+                              token.pragma]];
+    return YES;
+}
+
+- (void)parser:(GRMustacheParser *)parser didFailWithError:(NSError *)error
+{
+    [_error release];
+    _error = [error retain];
+}
+
+@end
+
+@interface GRMustacheParserStreamTest : GRMustachePrivateAPITest
+@end
+
+@implementation GRMustacheParserStreamTest
+
+- (GRMustacheStreamTokenRecorder *)recorderByParsingString:(NSString *)templateString
+{
+    GRMustacheStreamTokenRecorder *recorder = [[[GRMustacheStreamTokenRecorder alloc] init] autorelease];
+    GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:[GRMustacheConfiguration configuration]] autorelease];
+    parser.delegate = recorder;
+    [parser parseTemplateString:templateString templateID:nil];
+    return recorder;
+}
+
+- (GRMustacheStreamTokenRecorder *)recorderByParsingData:(NSData *)data encoding:(NSStringEncoding)encoding chunkLength:(NSUInteger)chunkLength
+{
+    GRMustacheStreamTokenRecorder *recorder = [[[GRMustacheStreamTokenRecorder alloc] init] autorelease];
+    GRMustacheParser *parser = [[[GRMustacheParser alloc] initWithConfiguration:[GRMustacheConfiguration configuration]] autorelease];
+    parser.delegate = recorder;
+    parser.streamChunkLength = chunkLength;
+    [parser parseTemplateStream:[NSInputStream inputStreamWithData:data] encoding:encoding templateID:nil];
+    return recorder;
+}
+
+// Text tokens may be split at chunk boundaries: compare the concatenation of
+// consecutive text tokens.
+- (NSArray *)descriptionsByJoiningTextTokens:(GRMustacheStreamTokenRecorder *)recorder
+{
+    NSMutableArray *descriptions = [NSMutableArray array];
+    NSMutableString *text = nil;
+    for (GRMustacheToken *token in recorder.tokens) {
+        if (token.type == GRMustacheTokenTypeText) {
+            if (!text) text = [NSMutableString string];
+            [text appendString:token.text];
+            continue;
+        }
+        if (text) {
+            [descriptions addObject:text];
+            text = nil;
+        }
+        [descriptions addObject:[recorder.descriptions objectAtIndex:[recorder.tokens indexOfObject:token]]];
+    }
+    if (text) {
+        [descriptions addObject:text];
+    }
+    return descriptions;
+}
+
+- (void)testStreamTokensMatchStringTokensForAllChunkLengths
+{
+    NSArray *templateStrings = @[@"text",
+                                 @"{{name}}",
+                                 @"a\n{{name}}\nb{{{raw}}}c{{&raw}}",
+                                 @"{{#items}}\n{{.}}\n{{/items}}{{^items}}none{{/items}}",
+                                 @"{{! comment\nover lines }}{{>partial}}{{<layout}}{{$block}}x{{/block}}{{/layout}}",
+                                 @"{{=<% %>=}}<%name%>{{name}}<%={{ }}=%>{{name}}",
+                                 @"{{%FILTERS}}{{ uppercase(name) }}",
+                                 @"Ça, c'est l'été — {{name}} 🎉 ok"];
+    for (NSString *templateString in templateStrings) {
+        GRMustacheStreamTokenRecorder *stringRecorder = [self recorderByParsingString:templateString];
+        NSData *data = [templateString dataUsingEncoding:NSUTF8StringEncoding];
+        for (NSUInteger chunkLength = 1; chunkLength <= data.length + 1; ++chunkLength) {
+            GRMustacheStreamTokenRecorder *streamRecorder = [self recorderByParsingData:data encoding:NSUTF8StringEncoding chunkLength:chunkLength];
+            STAssertNil(streamRecorder.error, @"%@ (chunk length %lu)", templateString, (unsigned long)chunkLength);
+            STAssertEqualObjects([self descriptionsByJoiningTextTokens:streamRecorder], [self descriptionsByJoiningTextTokens:stringRecorder], @"%@ (chunk length %lu)", templateString, (unsigned long)chunkLength);
+        }
+    }
+}
+
+- (void)testStreamTokensReferToSpooledString
+{
+    NSString *templateString = @"{{#a}}inner{{/a}}";
+    GRMustacheStreamTokenRecorder *recorder = [self recorderByParsingData:[templateString dataUsingEncoding:NSUTF8StringEncoding] encoding:NSUTF8StringEncoding chunkLength:4];
+    GRMustacheToken *token = [recorder.tokens objectAtIndex:0];
+    STAssertTrue([token.templateString isKindOfClass:[GRMustacheSpooledString class]], @"");
+    STAssertEqualObjects(token.templateString, templateString, @"");
+}
+
+- (void)testStreamParseErrors
+{
+    NSArray *templateStrings = @[@"{{", @"a\n{{name", @"{{}}", @"{{=a=}}", @"{{#a}}{{"];
+    for (NSString *templateString in templateStrings) {
+        GRMustacheStreamTokenRecorder *stringRecorder = [self recorderByParsingString:templateString];
+        GRMustacheStreamTokenRecorder *streamRecorder = [self recorderByParsingData:[templateString dataUsingEncoding:NSUTF8StringEncoding] encoding:NSUTF8StringEncoding chunkLength:2];
+        STAssertNotNil(streamRecorder.error, @"%@", templateString);
+        STAssertEqualObjects(streamRecorder.error.localizedDescription, stringRecorder.error.localizedDescription, @"%@", templateString);
+    }
+}
+
+- (void)testStreamEncodingErrors
+{
+    uint8_t bytes[] = { 'a', 0xFF, 'b' };
+    GRMustacheStreamTokenRecorder *recorder = [self recorderByParsingData:[NSData dataWithBytes:bytes length:sizeof(bytes)] encoding:NSUTF8StringEncoding chunkLength:2];
+    STAssertNotNil(recorder.error, @"");
+    STAssertEqualObjects(recorder.error.domain, NSCocoaErrorDomain, @"");
+}
+
+- (void)testSpooledString
+{
+    NSError *error;
+    GRMustacheSpooledString *string = [GRMustacheSpooledString spooledStringReturningError:&error];
+    STAssertNotNil(string, @"%@", error);
+    STAssertEquals(string.length, (NSUInteger)0, @"");
+    STAssertTrue([string appendString:@"été " error:NULL], @"");
+    STAssertTrue([string appendString:@"🎉" error:NULL], @"");
+    STAssertEqualObjects(string, @"été 🎉", @"");
+    STAssertEquals([string characterAtIndex:1], (unichar)0x00E9, @"");
+    STAssertEqualObjects([string substringWithRange:NSMakeRange(1, 2)], @"té", @"");
+}
+
+@end
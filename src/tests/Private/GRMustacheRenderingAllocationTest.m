@@ -0,0 +1,167 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustachePrivateAPITest.h"
+#import "GRMustacheTemplate_private.h"
+#import "GRMustacheTemplateRepository_private.h"
+#import "GRMustacheInstrumentation_private.h"
+
+// Allocation budgets of the rendering path.
+//
+// Those budgets are upper bounds, with some headroom for the differences
+// between platforms and Foundation versions. A test failure means that a
+// change has added allocations to a hot path: fix the change rather than the
+// budget. Should you remove allocations, lower the budgets.
+//
+// Per-tag and per-item budgets are measured as the difference between the
+// renderings of two templates that only differ by the number of tags or items,
+// so that they do not include the fixed cost of a rendering.
+
+static const double GRMustacheRenderingFixedAllocationBudget = 12;      // renderObject:error: of a text-only template
+static const double GRMustacheVariableTagAllocationBudget = 6;          // {{name}}, with a value that needs no escaping
+static const double GRMustacheEscapedVariableTagAllocationBudget = 8;   // {{name}}, with a value that needs escaping
+static const double GRMustacheSectionItemAllocationBudget = 16;         // one item of {{#items}}{{name}}{{/items}}
+static const double GRMustachePartialAllocationBudget = 8;              // {{>partial}}, with a text-only partial
+
+@interface GRMustacheRenderingAllocationTest : GRMustachePrivateAPITest
+- (double)allocationsPerRenderingOfTemplate:(GRMustacheTemplate *)template object:(id)object;
+- (double)allocationsPerTagWithTemplateString:(NSString *)templateString object:(id)object;
+@end
+
+@implementation GRMustacheRenderingAllocationTest
+
+- (void)setUp
+{
+    [super setUp];
+    GRMustacheInstrumentationStartCountingAllocations();
+    
+    // Without allocation hooks, all counts would be 0, and all budgets would
+    // be met.
+    STAssertTrue(GRMustacheInstrumentationIsCountingAllocations(), @"Allocations are not counted: build the tests with GRMUSTACHE_COUNT_ALLOCATIONS defined.");
+}
+
+- (void)tearDown
+{
+    GRMustacheInstrumentationStopCountingAllocations();
+    [super tearDown];
+}
+
+- (double)allocationsPerRenderingOfTemplate:(GRMustacheTemplate *)template object:(id)object
+{
+    static const NSUInteger batchCount = 5;
+    static const NSUInteger renderingCount = 10;
+    
+    // Warm up: lazy initializations must not be counted.
+    [template renderObject:object error:NULL];
+    
+    // Keep the best batch, so that allocations performed by other threads are
+    // unlikely to be counted.
+    uint64_t bestAllocationCount = UINT64_MAX;
+    for (NSUInteger batch = 0; batch < batchCount; ++batch) {
+        GRMustacheAllocationStats before = GRMustacheInstrumentationAllocationStats();
+        for (NSUInteger i = 0; i < renderingCount; ++i) {
+            @autoreleasepool {
+                [template renderObject:object error:NULL];
+            }
+        }
+        GRMustacheAllocationStats after = GRMustacheInstrumentationAllocationStats();
+        bestAllocationCount = MIN(bestAllocationCount, after.count - before.count);
+    }
+    return (double)bestAllocationCount / renderingCount;
+}
+
+- (double)allocationsPerTagWithTemplateString:(NSString *)templateString object:(id)object
+{
+    static const NSUInteger tagCount = 100;
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    NSString *shortTemplateString = [@"" stringByPaddingToLength:templateString.length * tagCount withString:templateString startingAtIndex:0];
+    NSString *longTemplateString = [@"" stringByPaddingToLength:templateString.length * tagCount * 2 withString:templateString startingAtIndex:0];
+    GRMustacheTemplate *shortTemplate = [repository templateFromString:shortTemplateString error:NULL];
+    GRMustacheTemplate *longTemplate = [repository templateFromString:longTemplateString error:NULL];
+    STAssertNotNil(shortTemplate, @"");
+    STAssertNotNil(longTemplate, @"");
+    
+    double shortAllocationCount = [self allocationsPerRenderingOfTemplate:shortTemplate object:object];
+    double longAllocationCount = [self allocationsPerRenderingOfTemplate:longTemplate object:object];
+    return (longAllocationCount - shortAllocationCount) / tagCount;
+}
+
+- (void)testRenderingFixedAllocations
+{
+    GRMustacheTemplate *template = [[GRMustacheTemplateRepository templateRepository] templateFromString:@"Hello world" error:NULL];
+    double allocationCount = [self allocationsPerRenderingOfTemplate:template object:nil];
+    STAssertTrue(allocationCount <= GRMustacheRenderingFixedAllocationBudget, @"%.1f allocations per rendering, budget is %.1f", allocationCount, GRMustacheRenderingFixedAllocationBudget);
+}
+
+- (void)testVariableTagAllocations
+{
+    id object = @{ @"name": @"Arthur" };
+    double allocationCount = [self allocationsPerTagWithTemplateString:@"{{name}}" object:object];
+    STAssertTrue(allocationCount <= GRMustacheVariableTagAllocationBudget, @"%.1f allocations per tag, budget is %.1f", allocationCount, GRMustacheVariableTagAllocationBudget);
+}
+
+- (void)testEscapedVariableTagAllocations
+{
+    id object = @{ @"name": @"<Arthur & Zaphod>" };
+    double allocationCount = [self allocationsPerTagWithTemplateString:@"{{name}}" object:object];
+    STAssertTrue(allocationCount <= GRMustacheEscapedVariableTagAllocationBudget, @"%.1f allocations per tag, budget is %.1f", allocationCount, GRMustacheEscapedVariableTagAllocationBudget);
+}
+
+- (void)testSectionItemAllocations
+{
+    static const NSUInteger itemCount = 100;
+    
+    NSMutableArray *shortItems = [NSMutableArray array];
+    NSMutableArray *longItems = [NSMutableArray array];
+    for (NSUInteger i = 0; i < itemCount; ++i) {
+        [shortItems addObject:@{ @"name": @"Arthur" }];
+        [longItems addObject:@{ @"name": @"Arthur" }];
+        [longItems addObject:@{ @"name": @"Zaphod" }];
+    }
+    
+    GRMustacheTemplate *template = [[GRMustacheTemplateRepository templateRepository] templateFromString:@"{{#items}}{{name}}{{/items}}" error:NULL];
+    double shortAllocationCount = [self allocationsPerRenderingOfTemplate:template object:@{ @"items": shortItems }];
+    double longAllocationCount = [self allocationsPerRenderingOfTemplate:template object:@{ @"items": longItems }];
+    double allocationCount = (longAllocationCount - shortAllocationCount) / itemCount;
+    STAssertTrue(allocationCount <= GRMustacheSectionItemAllocationBudget, @"%.1f allocations per item, budget is %.1f", allocationCount, GRMustacheSectionItemAllocationBudget);
+}
+
+- (void)testPartialAllocations
+{
+    static const NSUInteger partialCount = 100;
+    
+    NSMutableString *shortTemplateString = [NSMutableString string];
+    for (NSUInteger i = 0; i < partialCount; ++i) {
+        [shortTemplateString appendString:@"{{>partial}}"];
+    }
+    NSString *longTemplateString = [shortTemplateString stringByAppendingString:shortTemplateString];
+    NSDictionary *templates = @{ @"short": shortTemplateString, @"long": longTemplateString, @"partial": @"Hello world" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    
+    double shortAllocationCount = [self allocationsPerRenderingOfTemplate:[repository templateNamed:@"short" error:NULL] object:nil];
+    double longAllocationCount = [self allocationsPerRenderingOfTemplate:[repository templateNamed:@"long" error:NULL] object:nil];
+    double allocationCount = (longAllocationCount - shortAllocationCount) / partialCount;
+    STAssertTrue(allocationCount <= GRMustachePartialAllocationBudget, @"%.1f allocations per partial, budget is %.1f", allocationCount, GRMustachePartialAllocationBudget);
+}
+
+@end
@@ -0,0 +1,63 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "GRMustachePrivateAPITest.h"
+#import "GRMustacheTemplateRepository_private.h"
+
+@interface GRMustacheTemplateIDCacheTest : GRMustachePrivateAPITest
+@end
+
+@implementation GRMustacheTemplateIDCacheTest
+
+- (void)testDirectoryRepositoryMemoizesTemplateIDs
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDirectory:@"/path/to/templates"];
+    id<GRMustacheTemplateRepositoryDataSource> dataSource = repository.dataSource;
+    
+    id templateID1 = [dataSource templateRepository:repository templateIDForName:@"partial" relativeToTemplateID:nil];
+    id templateID2 = [dataSource templateRepository:repository templateIDForName:@"partial" relativeToTemplateID:nil];
+    STAssertEqualObjects(templateID1, @"/path/to/templates/partial.mustache", @"");
+    STAssertTrue(templateID1 == templateID2, @"");
+    
+    // Resolution depends on the base template ID
+    id templateID3 = [dataSource templateRepository:repository templateIDForName:@"partial" relativeToTemplateID:@"/path/to/templates/dir/main.mustache"];
+    STAssertEqualObjects(templateID3, @"/path/to/templates/dir/partial.mustache", @"");
+    id templateID4 = [dataSource templateRepository:repository templateIDForName:@"/partial" relativeToTemplateID:@"/path/to/templates/dir/main.mustache"];
+    STAssertEqualObjects(templateID4, @"/path/to/templates/partial.mustache", @"");
+}
+
+- (void)testBaseURLRepositoryMemoizesTemplateIDs
+{
+    NSURL *baseURL = [NSURL fileURLWithPath:@"/path/to/templates"];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithBaseURL:baseURL];
+    id<GRMustacheTemplateRepositoryDataSource> dataSource = repository.dataSource;
+    
+    id templateID1 = [dataSource templateRepository:repository templateIDForName:@"partial" relativeToTemplateID:nil];
+    id templateID2 = [dataSource templateRepository:repository templateIDForName:@"partial" relativeToTemplateID:nil];
+    STAssertEqualObjects([templateID1 path], @"/path/to/templates/partial.mustache", @"");
+    STAssertTrue(templateID1 == templateID2, @"");
+    
+    id templateID3 = [dataSource templateRepository:repository templateIDForName:@"../partial" relativeToTemplateID:templateID1];
+    STAssertEqualObjects([templateID3 path], @"/path/to/partial.mustache", @"");
+}
+
+@end
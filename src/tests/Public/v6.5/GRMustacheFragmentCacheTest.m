@@ -0,0 +1,177 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheFragmentCacheTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheFragmentCacheTest
+
+- (void)testCachedSectionIsRenderedOnce
+{
+    __block NSUInteger renderCount = 0;
+    id counter = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        renderCount++;
+        return [NSString stringWithFormat:@"%lu", (unsigned long)renderCount];
+    }];
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#cache(key)}}{{name}}:{{counter}}{{/}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"cache": cache, @"counter": counter, @"key": @"a", @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"foo:1", @"");
+    
+    rendering = [template renderObject:@{ @"cache": cache, @"counter": counter, @"key": @"a", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"foo:1", @"");
+    STAssertEquals(renderCount, (NSUInteger)1, @"");
+    
+    rendering = [template renderObject:@{ @"cache": cache, @"counter": counter, @"key": @"b", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"bar:2", @"");
+    STAssertEquals(renderCount, (NSUInteger)2, @"");
+}
+
+- (void)testRemoveAllFragments
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#cache(key)}}{{name}}{{/}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"foo", @"");
+    
+    [cache removeAllFragments];
+    rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"bar", @"");
+}
+
+- (void)testSectionsWithNilKeyAreNotCached
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#cache(missing)}}{{name}}{{/}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"cache": cache, @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"foo", @"");
+    
+    rendering = [template renderObject:@{ @"cache": cache, @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"bar", @"");
+    STAssertEquals(cache.cache.countLimit, (NSUInteger)1000, @"");
+}
+
+- (void)testRenderingsAreKeyedByTemplateID
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{
+        @"a": @"{{#cache(key)}}a:{{name}}{{/}}",
+        @"b": @"{{#cache(key)}}b:{{name}}{{/}}" }];
+    repository.configuration.baseContext = [repository.configuration.baseContext contextByAddingObject:@{ @"cache": cache }];
+    
+    NSString *rendering = [[repository templateNamed:@"a" error:NULL] renderObject:@{ @"key": @"k", @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"a:foo", @"");
+    
+    rendering = [[repository templateNamed:@"b" error:NULL] renderObject:@{ @"key": @"k", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"b:bar", @"");
+    
+    rendering = [[repository templateNamed:@"a" error:NULL] renderObject:@{ @"key": @"k", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"a:foo", @"");
+}
+
+- (void)testRenderingsAreKeyedBySection
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{
+        @"main": @"{{#cache(key)}}header:{{name}}{{/}}, {{#cache(key)}}footer:{{name}}{{/}}" }];
+    repository.configuration.baseContext = [repository.configuration.baseContext contextByAddingObject:@{ @"cache": cache }];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"key": @"k", @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"header:foo, footer:foo", @"");
+    
+    rendering = [template renderObject:@{ @"key": @"k", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"header:foo, footer:foo", @"");
+}
+
+- (void)testSectionsOfOverridablePartialsAreNotCached
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{
+        @"layout": @"{{#cache(key)}}<nav>{{$nav}}default{{/nav}}</nav>{{/}}",
+        @"page1": @"{{<layout}}{{$nav}}page1{{/nav}}{{/layout}}",
+        @"page2": @"{{<layout}}{{$nav}}page2{{/nav}}{{/layout}}" }];
+    repository.configuration.baseContext = [repository.configuration.baseContext contextByAddingObject:@{ @"cache": cache }];
+    
+    NSString *rendering = [[repository templateNamed:@"page1" error:NULL] renderObject:@{ @"key": @"k" } error:NULL];
+    STAssertEqualObjects(rendering, @"<nav>page1</nav>", @"");
+    
+    rendering = [[repository templateNamed:@"page2" error:NULL] renderObject:@{ @"key": @"k" } error:NULL];
+    STAssertEqualObjects(rendering, @"<nav>page2</nav>", @"");
+    
+    rendering = [[repository templateNamed:@"layout" error:NULL] renderObject:@{ @"key": @"k" } error:NULL];
+    STAssertEqualObjects(rendering, @"<nav>default</nav>", @"");
+}
+
+- (void)testRenderingsAreKeyedByContentType
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    id data = @{ @"cache": cache, @"key": @"k", @"name": @"&" };
+    
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#cache(key)}}{{name}}{{/}}" error:NULL];
+    STAssertEqualObjects(rendering, @"&amp;", @"");
+    
+    rendering = [GRMustacheTemplate renderObject:data fromString:@"{{%CONTENT_TYPE:TEXT}}{{#cache(key)}}{{name}}{{/}}" error:NULL];
+    STAssertEqualObjects(rendering, @"&", @"");
+}
+
+- (void)testCachedRenderingIsNotEscapedAgain
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#cache(key)}}<{{name}}>{{/}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"&" } error:NULL];
+    STAssertEqualObjects(rendering, @"<&amp;>", @"");
+    
+    rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"&" } error:NULL];
+    STAssertEqualObjects(rendering, @"<&amp;>", @"");
+}
+
+- (void)testCustomCache
+{
+    NSCache *store = [[[NSCache alloc] init] autorelease];
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCacheWithCache:store];
+    STAssertEquals(cache.cache, store, @"");
+    
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#cache(key)}}{{name}}{{/}}" error:NULL];
+    NSString *rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"foo" } error:NULL];
+    STAssertEqualObjects(rendering, @"foo", @"");
+    
+    [store removeAllObjects];
+    rendering = [template renderObject:@{ @"cache": cache, @"key": @"a", @"name": @"bar" } error:NULL];
+    STAssertEqualObjects(rendering, @"bar", @"");
+}
+
+- (void)testVariableAndInvertedTagsRenderNothing
+{
+    GRMustacheFragmentCache *cache = [GRMustacheFragmentCache fragmentCache];
+    NSString *rendering = [GRMustacheTemplate renderObject:@{ @"cache": cache, @"key": @"a" } fromString:@"<{{cache(key)}}{{^cache(key)}}inverted{{/}}>" error:NULL];
+    STAssertEqualObjects(rendering, @"<>", @"");
+}
+
+@end
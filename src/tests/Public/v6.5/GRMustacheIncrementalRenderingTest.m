@@ -0,0 +1,214 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheIncrementalRenderingTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheIncrementalRenderingTest
+
+- (id)counterWithCount:(NSUInteger *)count
+{
+    return [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        *count += 1;
+        return [tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }];
+}
+
+- (void)testInitialRendering
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"Hello {{name}}, {{#user}}{{name}}{{/user}}!" error:NULL];
+    id data = @{ @"name": @"Arthur", @"user": @{ @"name": @"Barbara" } };
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"Hello Arthur, Barbara!", @"");
+    STAssertEqualObjects(rendering.string, [template renderObject:data error:NULL], @"");
+}
+
+- (void)testOnlyAffectedSegmentsAreRenderedAgain
+{
+    NSUInteger nameCount = 0;
+    NSUInteger userCount = 0;
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"<{{#nameCounter}}{{name}}{{/nameCounter}}|{{#userCounter}}{{user.name}}{{/userCounter}}>" error:NULL];
+    NSMutableDictionary *user = [NSMutableDictionary dictionaryWithObject:@"Barbara" forKey:@"name"];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:@{
+        @"name": @"Arthur",
+        @"user": user,
+        @"nameCounter": [self counterWithCount:&nameCount],
+        @"userCounter": [self counterWithCount:&userCount] }];
+    
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"<Arthur|Barbara>", @"");
+    STAssertEquals(nameCount, (NSUInteger)1, @"");
+    STAssertEquals(userCount, (NSUInteger)1, @"");
+    
+    [user setObject:@"Craig" forKey:@"name"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"user.name"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<Arthur|Craig>", @"");
+    STAssertEquals(nameCount, (NSUInteger)1, @"");
+    STAssertEquals(userCount, (NSUInteger)2, @"");
+    
+    [data setObject:@"David" forKey:@"name"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"name"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<David|Craig>", @"");
+    STAssertEquals(nameCount, (NSUInteger)2, @"");
+    STAssertEquals(userCount, (NSUInteger)2, @"");
+    
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"unused"] error:NULL], @"");
+    STAssertEquals(nameCount, (NSUInteger)2, @"");
+    STAssertEquals(userCount, (NSUInteger)2, @"");
+}
+
+- (void)testChangeOfParentKeyPathRendersChildren
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{user.name}}" error:NULL];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithObject:@{ @"name": @"Arthur" } forKey:@"user"];
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    
+    [data setObject:@{ @"name": @"Barbara" } forKey:@"user"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"user"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"Barbara", @"");
+}
+
+- (void)testChangeOfChildKeyPathRendersParents
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#users}}{{name}},{{/users}}" error:NULL];
+    NSMutableDictionary *user = [NSMutableDictionary dictionaryWithObject:@"Arthur" forKey:@"name"];
+    id data = @{ @"users": @[user] };
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    
+    [user setObject:@"Barbara" forKey:@"name"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"users.name"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"Barbara,", @"");
+}
+
+- (void)testKeyPathsOfPartialsAndFiltersAreTracked
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{
+        @"main": @"{{>partial}}-{{uppercase(title)}}",
+        @"partial": @"{{name}}" }];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:@{ @"name": @"Arthur", @"title": @"mr" }];
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"Arthur-MR", @"");
+    
+    [data setObject:@"Barbara" forKey:@"name"];
+    [data setObject:@"ms" forKey:@"title"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObjects:@"name", @"title", nil] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"Barbara-MS", @"");
+}
+
+- (id)variableCounterWithCount:(NSUInteger *)count
+{
+    return [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        *count += 1;
+        return @"";
+    }];
+}
+
+- (void)testSectionItemsAreUpdatedInPlace
+{
+    NSUInteger count = 0;
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#page}}<h1>{{title}}</h1>{{#items}}<li>{{name}}{{counter}}</li>{{/items}}{{/page}}" error:NULL];
+    NSMutableDictionary *item1 = [NSMutableDictionary dictionaryWithObject:@"a" forKey:@"name"];
+    NSMutableDictionary *item2 = [NSMutableDictionary dictionaryWithObject:@"b" forKey:@"name"];
+    NSMutableDictionary *page = [NSMutableDictionary dictionaryWithDictionary:@{ @"title": @"Title", @"items": @[item1, item2] }];
+    id data = @{ @"page": page, @"counter": [self variableCounterWithCount:&count] };
+    
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"<h1>Title</h1><li>a</li><li>b</li>", @"");
+    STAssertEquals(count, (NSUInteger)2, @"");
+    
+    [page setObject:@"New title" forKey:@"title"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"title"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<h1>New title</h1><li>a</li><li>b</li>", @"");
+    STAssertEquals(count, (NSUInteger)2, @"");
+    
+    [item2 setObject:@"bb" forKey:@"name"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"name"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<h1>New title</h1><li>a</li><li>bb</li>", @"");
+    STAssertEquals(count, (NSUInteger)2, @"");
+    STAssertEqualObjects(rendering.string, [template renderObject:data error:NULL], @"");
+    
+    [page setObject:@[item1] forKey:@"items"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"page.items"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<h1>New title</h1><li>a</li>", @"");
+}
+
+- (void)testOverriddenLayoutsAreUpdatedInPlace
+{
+    NSUInteger count = 0;
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{
+        @"layout": @"{{counter}}<title>{{title}}</title>{{$body}}{{/body}}",
+        @"page": @"{{<layout}}{{$body}}<p>{{text}}</p>{{/body}}{{/layout}}" }];
+    GRMustacheTemplate *template = [repository templateNamed:@"page" error:NULL];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:@{
+        @"title": @"Title",
+        @"text": @"foo",
+        @"counter": [self variableCounterWithCount:&count] }];
+    
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"<title>Title</title><p>foo</p>", @"");
+    STAssertEquals(count, (NSUInteger)1, @"");
+    
+    [data setObject:@"bar" forKey:@"text"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"text"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"<title>Title</title><p>bar</p>", @"");
+    STAssertEquals(count, (NSUInteger)1, @"");
+}
+
+- (void)testProcessedSectionsAreRenderedAgainAsAWhole
+{
+    id uppercase = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        return [[tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error] uppercaseString];
+    }];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#uppercase}}{{name}}{{/uppercase}}" error:NULL];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:@{ @"name": @"123", @"uppercase": uppercase }];
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"123", @"");
+    
+    [data setObject:@"abc" forKey:@"name"];
+    STAssertTrue([rendering updateWithChangedKeyPaths:[NSSet setWithObject:@"name"] error:NULL], @"");
+    STAssertEqualObjects(rendering.string, @"ABC", @"");
+}
+
+- (void)testFailedUpdateLeavesRenderingUnchanged
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{name}}-{{f(value)}}" error:NULL];
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:@{
+        @"name": @"Arthur",
+        @"value": @"foo",
+        @"f": [GRMustacheFilter filterWithBlock:^id(id value) { return value; }] }];
+    GRMustacheIncrementalRendering *rendering = [GRMustacheIncrementalRendering incrementalRenderingWithTemplate:template object:data error:NULL];
+    STAssertEqualObjects(rendering.string, @"Arthur-foo", @"");
+    
+    // Missing filter
+    [data setObject:@"Barbara" forKey:@"name"];
+    [data removeObjectForKey:@"f"];
+    NSError *error;
+    STAssertFalse([rendering updateWithChangedKeyPaths:[NSSet setWithObjects:@"name", @"f", nil] error:&error], @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEqualObjects(rendering.string, @"Arthur-foo", @"");
+}
+
+@end
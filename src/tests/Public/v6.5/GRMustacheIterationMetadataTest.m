@@ -0,0 +1,137 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheIterationMetadataTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheIterationMetadataTest
+
+- (void)testIndexAndLast
+{
+    id data = @{ @"items": @[@"a", @"b", @"c"] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{@index}}{{.}}{{^@last}}, {{/@last}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0a, 1b, 2c", @"");
+}
+
+- (void)testFirstOddAndEven
+{
+    id data = @{ @"items": @[@"a", @"b", @"c"] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{#@first}}[{{/@first}}{{#@odd}}odd{{/@odd}}{{#@even}}even{{/@even}}{{#@last}}]{{/@last}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"[evenoddeven]", @"");
+}
+
+- (void)testSingleItemIsFirstAndLast
+{
+    id data = @{ @"items": @[@"a"] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{#@first}}first{{/@first}}{{#@last}}last{{/@last}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"firstlast", @"");
+}
+
+- (void)testMetadataInFilteredExpressions
+{
+    id data = @{ @"items": @[@"a", @"b"], @"f": [GRMustacheFilter filterWithBlock:^id(id value) {
+        return [NSNumber numberWithInteger:[value integerValue] + 1];
+    }] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{f(@index)}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"12", @"");
+}
+
+- (void)testNestedLoopsHaveTheirOwnMetadata
+{
+    id data = @{ @"rows": @[@{ @"cells": @[@"a", @"b"] }, @{ @"cells": @[@"c"] }] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#rows}}{{@index}}:{{#cells}}{{@index}}{{/cells}};{{/rows}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0:01;1:0;", @"");
+}
+
+- (void)testMetadataIsAvailableInNestedNonEnumerableSections
+{
+    id data = @{ @"items": @[@{ @"name": @"a" }, @{ @"name": @"b" }] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{#name}}{{@index}}{{.}}{{/name}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0a1b", @"");
+}
+
+- (void)testMetadataIsAvailableInPartials
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{ @"item": @"{{@index}}{{.}}" }];
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#items}}{{>item}}{{/items}}" error:NULL];
+    NSString *rendering = [template renderObject:@{ @"items": @[@"a", @"b"] } error:NULL];
+    STAssertEqualObjects(rendering, @"0a1b", @"");
+}
+
+- (void)testMetadataIsAvailableInOverridingSections
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{ @"layout": @"{{#items}}{{$item}}{{.}}{{/item}}{{/items}}" }];
+    GRMustacheTemplate *template = [repository templateFromString:@"{{<layout}}{{$item}}{{@index}}{{.}}{{/item}}{{/layout}}" error:NULL];
+    NSString *rendering = [template renderObject:@{ @"items": @[@"a", @"b"] } error:NULL];
+    STAssertEqualObjects(rendering, @"0a1b", @"");
+}
+
+- (void)testMetadataIsAvailableInDynamicPartials
+{
+    GRMustacheTemplate *partial = [GRMustacheTemplate templateFromString:@"{{@index}}{{.}}{{^@last}},{{/@last}}" error:NULL];
+    id data = @{ @"items": @[@"a", @"b"], @"partial": partial };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{partial}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0a,1b", @"");
+}
+
+- (void)testMetadataIsAvailableToRenderingObjects
+{
+    id renderingObject = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{@index}}{{#@last}}!{{/@last}}" error:NULL];
+        return [template renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }];
+    id data = @{ @"items": @[@"a", @"b"], @"index": renderingObject };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{index}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"01!", @"");
+}
+
+- (void)testLastIsAvailableForEnumerableObjectsWithoutCount
+{
+    id data = @{ @"items": [@[@"a", @"b"] objectEnumerator] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{@index}}{{.}}{{^@last}},{{/@last}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0a,1b", @"");
+}
+
+- (void)testMetadataIsAvailableForAllEnumerableObjects
+{
+    id data = @{ @"items": [NSOrderedSet orderedSetWithObjects:@"a", @"b", nil] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{@index}}{{.}}{{^@last}},{{/@last}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"0a,1b", @"");
+}
+
+- (void)testMetadataIsMissingOutsideOfLoops
+{
+    NSString *rendering = [GRMustacheTemplate renderObject:@{ @"item": @"a" } fromString:@"<{{@index}}{{#@first}}first{{/@first}}{{#item}}{{@index}}{{/item}}>" error:NULL];
+    STAssertEqualObjects(rendering, @"<>", @"");
+}
+
+- (void)testSectionsThatDoNotReadMetadataRenderAsBefore
+{
+    id data = @{ @"items": @[@"a", @"b"] };
+    NSString *rendering = [GRMustacheTemplate renderObject:data fromString:@"{{#items}}{{.}}{{/items}}" error:NULL];
+    STAssertEqualObjects(rendering, @"ab", @"");
+}
+
+@end
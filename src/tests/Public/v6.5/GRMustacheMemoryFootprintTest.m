@@ -0,0 +1,98 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheMemoryFootprintTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheMemoryFootprintTest
+
+- (void)testTemplateMemoryFootprint
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:[NSString stringWithFormat:@"%@", @"a{{x}}b{{#s}}c{{/s}}"] error:NULL];
+    GRMustacheMemoryFootprint *memoryFootprint = template.memoryFootprint;
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTemplates], (NSUInteger)1, @"");
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTextComponents], (NSUInteger)3, @"");
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTags], (NSUInteger)2, @"");
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryExpressions], (NSUInteger)2, @"");
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTemplateStrings], (NSUInteger)1, @"");
+    STAssertTrue([memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTemplates] > 0, @"");
+    STAssertTrue([memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTags] > 0, @"");
+    
+    NSUInteger totalBytes = 0;
+    for (NSUInteger category = 0; category < GRMustacheMemoryCategoryCount; ++category) {
+        totalBytes += [memoryFootprint bytesInCategory:category];
+    }
+    STAssertEquals(memoryFootprint.totalBytes, totalBytes, @"");
+}
+
+- (void)testSharedPartialsAreCountedOnce
+{
+    NSDictionary *templates = @{ @"main": @"{{>partial}}{{>partial}}{{<partial}}{{/partial}}", @"partial": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    
+    GRMustacheMemoryFootprint *memoryFootprint = template.memoryFootprint;
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTemplates], (NSUInteger)3, @"");   // main, partial, override
+    STAssertEquals([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTags], (NSUInteger)1, @"");
+    
+    GRMustacheMemoryFootprint *repositoryMemoryFootprint = repository.memoryFootprint;
+    STAssertEquals(repositoryMemoryFootprint.totalBytes, memoryFootprint.totalBytes, @"");
+}
+
+- (void)testRepositoryMemoryFootprintIgnoresTemplatesFromStrings
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    [repository templateFromString:@"{{name}}" error:NULL];
+    STAssertEquals(repository.memoryFootprint.totalBytes, (NSUInteger)0, @"");
+}
+
+- (void)testMappedTemplateStringsAreNotCountedAsHeapCharacters
+{
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheMemoryFootprintTest"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:NULL];
+    NSString *text = [@"" stringByPaddingToLength:10000 withString:@"a" startingAtIndex:0];
+    NSString *templateString = [NSString stringWithFormat:@"%@{{name}}%@", text, text];
+    [templateString writeToFile:[directory stringByAppendingPathComponent:@"main.mustache"] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDirectory:directory];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+    
+    GRMustacheMemoryFootprint *memoryFootprint = template.memoryFootprint;
+    STAssertTrue([memoryFootprint objectCountInCategory:GRMustacheMemoryCategoryTemplateStrings] > 0, @"");
+    STAssertTrue([memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTemplateStrings] < templateString.length, @"");
+}
+
+- (void)testDictionaryRepresentation
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{name}}" error:NULL];
+    GRMustacheMemoryFootprint *memoryFootprint = template.memoryFootprint;
+    NSDictionary *dictionary = [memoryFootprint dictionaryRepresentation];
+    STAssertEqualObjects([dictionary objectForKey:@"totalBytes"], @(memoryFootprint.totalBytes), @"");
+    STAssertEqualObjects([[dictionary objectForKey:@"tags"] objectForKey:@"count"], @1, @"");
+    STAssertEqualObjects([[dictionary objectForKey:@"tags"] objectForKey:@"bytes"], @([memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTags]), @"");
+}
+
+@end
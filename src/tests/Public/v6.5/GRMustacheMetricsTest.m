@@ -0,0 +1,120 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheMetricsTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheMetricsTest
+
+- (void)testCompilationAndCacheMetrics
+{
+    NSDictionary *templates = @{ @"main": @"{{>partial}}{{>partial}}", @"partial": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheMetrics *metrics = repository.metrics;
+    STAssertEquals(metrics.compiledTemplateCount, (uint64_t)0, @"");
+    
+    [repository templateNamed:@"main" error:NULL];
+    STAssertEquals(metrics.compiledTemplateCount, (uint64_t)2, @"");
+    STAssertEquals(metrics.templateCacheMissCount, (uint64_t)2, @"");
+    STAssertEquals(metrics.templateCacheHitCount, (uint64_t)1, @"");
+    STAssertEquals(metrics.templateSourceLength, (uint64_t)(@"{{>partial}}{{>partial}}".length + @"{{name}}".length), @"");
+    STAssertEquals(metrics.compileLatencyHistogram.count, (uint64_t)2, @"");
+    STAssertEquals(metrics.loadLatencyHistogram.count, (uint64_t)2, @"");
+    
+    [repository templateNamed:@"main" error:NULL];
+    STAssertEquals(metrics.compiledTemplateCount, (uint64_t)2, @"");
+    STAssertEquals(metrics.templateCacheHitCount, (uint64_t)2, @"");
+}
+
+- (void)testRenderingMetrics
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheTemplate *template = [repository templateFromString:@"<{{name}}>" error:NULL];
+    [template renderObject:@{ @"name": @"foo" } error:NULL];
+    [template renderObjectsFromArray:@[@{ @"name": @"bar" }] error:NULL];
+    
+    GRMustacheMetrics *metrics = repository.metrics;
+    STAssertEquals(metrics.renderCount, (uint64_t)2, @"");
+    STAssertEquals(metrics.renderedLength, (uint64_t)10, @"");
+    STAssertEquals(metrics.renderLatencyHistogram.count, (uint64_t)2, @"");
+}
+
+- (void)testFailedRenderingsAreNotCounted
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheTemplate *template = [repository templateFromString:@"{{missingFilter(name)}}" error:NULL];
+    STAssertNil([template renderObject:nil error:NULL], @"");
+    STAssertEquals(repository.metrics.renderCount, (uint64_t)0, @"");
+}
+
+- (void)testHistogramBuckets
+{
+    STAssertEquals([GRMustacheHistogram upperBoundOfBucketAtIndex:0], (uint64_t)0, @"");
+    STAssertEquals([GRMustacheHistogram upperBoundOfBucketAtIndex:1], (uint64_t)1, @"");
+    STAssertEquals([GRMustacheHistogram upperBoundOfBucketAtIndex:10], (uint64_t)1023, @"");
+    STAssertEquals([GRMustacheHistogram upperBoundOfBucketAtIndex:GRMustacheHistogramBucketCount - 1], (uint64_t)UINT64_MAX, @"");
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheTemplate *template = [repository templateFromString:@"" error:NULL];
+    [template renderObject:nil error:NULL];
+    GRMustacheHistogram *histogram = repository.metrics.renderLatencyHistogram;
+    uint64_t count = 0;
+    for (NSUInteger index = 0; index < GRMustacheHistogramBucketCount; ++index) {
+        count += [histogram countInBucketAtIndex:index];
+    }
+    STAssertEquals(count, (uint64_t)1, @"");
+}
+
+- (void)testReset
+{
+    NSDictionary *templates = @{ @"main": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    [template renderObject:nil error:NULL];
+    
+    GRMustacheMetrics *metrics = repository.metrics;
+    [metrics reset];
+    STAssertEquals(metrics.compiledTemplateCount, (uint64_t)0, @"");
+    STAssertEquals(metrics.templateCacheMissCount, (uint64_t)0, @"");
+    STAssertEquals(metrics.renderCount, (uint64_t)0, @"");
+    STAssertEquals(metrics.renderLatencyHistogram.count, (uint64_t)0, @"");
+    STAssertEquals(metrics.templateSourceLength, (uint64_t)@"{{name}}".length, @"templateSourceLength is not reset");
+}
+
+- (void)testDictionaryRepresentation
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheTemplate *template = [repository templateFromString:@"foo" error:NULL];
+    [template renderObject:nil error:NULL];
+    
+    NSDictionary *dictionary = [repository.metrics dictionaryRepresentation];
+    STAssertEqualObjects([dictionary objectForKey:@"renderCount"], @1, @"");
+    STAssertEqualObjects([dictionary objectForKey:@"compiledTemplateCount"], @1, @"");
+    STAssertEqualObjects([[dictionary objectForKey:@"renderLatency"] objectForKey:@"count"], @1, @"");
+    STAssertEquals([[[dictionary objectForKey:@"renderLatency"] objectForKey:@"buckets"] count], (NSUInteger)1, @"");
+    STAssertTrue([NSPropertyListSerialization propertyList:dictionary isValidForFormat:NSPropertyListXMLFormat_v1_0], @"");
+}
+
+@end
@@ -0,0 +1,153 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheMissingTemplateCacheTest : GRMustachePublicAPITest
+@end
+
+@interface GRMustacheMissingTemplateCacheTestDataSource : NSObject<GRMustacheTemplateRepositoryDataSource> {
+    NSUInteger _templateStringForTemplateIDCount;
+}
+@property (nonatomic) NSUInteger templateStringForTemplateIDCount;
+@end
+
+@implementation GRMustacheMissingTemplateCacheTestDataSource
+@synthesize templateStringForTemplateIDCount=_templateStringForTemplateIDCount;
+
+- (id)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateIDForName:(NSString *)name relativeToTemplateID:(id)baseTemplateID
+{
+    return name;
+}
+
+- (NSString *)templateRepository:(GRMustacheTemplateRepository *)templateRepository templateStringForTemplateID:(id)templateID error:(NSError **)error
+{
+    _templateStringForTemplateIDCount++;
+    if ([templateID hasPrefix:@"missing"]) {
+        return nil;
+    }
+    if ([templateID isEqualToString:@"error"]) {
+        if (error != NULL) {
+            *error = [NSError errorWithDomain:@"GRMustacheMissingTemplateCacheTestDataSource" code:0 userInfo:nil];
+        }
+        return nil;
+    }
+    return templateID;
+}
+
+@end
+
+@implementation GRMustacheMissingTemplateCacheTest
+
+- (void)testMissingTemplatesAreNotRememberedByDefault
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    
+    STAssertEquals([GRMustacheConfiguration configuration].missingTemplateLifetime, (NSTimeInterval)0, @"");
+    STAssertNil([repository templateNamed:@"missing" error:NULL], @"");
+    STAssertNil([repository templateNamed:@"missing" error:NULL], @"");
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)2, @"");
+    STAssertEquals(repository.metrics.missingTemplateCacheHitCount, (uint64_t)0, @"");
+}
+
+- (void)testMissingTemplatesAreRemembered
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    repository.configuration.missingTemplateLifetime = 60;
+    
+    NSError *error;
+    STAssertNil([repository templateNamed:@"missing" error:&error], @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeTemplateNotFound, @"");
+    
+    error = nil;
+    STAssertNil([repository templateNamed:@"missing" error:&error], @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeTemplateNotFound, @"");
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)1, @"");
+    STAssertEquals(repository.metrics.missingTemplateCacheHitCount, (uint64_t)1, @"");
+    STAssertEqualObjects([repository.metrics.dictionaryRepresentation objectForKey:@"missingTemplateCacheHitCount"], @1, @"");
+}
+
+- (void)testMissingPartialsAreRemembered
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    repository.configuration.missingTemplateLifetime = 60;
+    
+    STAssertNil([repository templateFromString:@"{{>missing}}" error:NULL], @"");
+    STAssertNil([repository templateFromString:@"{{>missing}}" error:NULL], @"");
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)1, @"");
+}
+
+- (void)testLoadingErrorsAreNotRemembered
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    repository.configuration.missingTemplateLifetime = 60;
+    
+    STAssertNil([repository templateNamed:@"error" error:NULL], @"");
+    STAssertNil([repository templateNamed:@"error" error:NULL], @"");
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)2, @"");
+}
+
+- (void)testMissingTemplatesAreForgottenAfterLifetime
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    repository.configuration.missingTemplateLifetime = 0.05;
+    
+    STAssertNil([repository templateNamed:@"missing" error:NULL], @"");
+    [NSThread sleepForTimeInterval:0.1];
+    STAssertNil([repository templateNamed:@"missing" error:NULL], @"");
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)2, @"");
+}
+
+- (void)testOldestMissingTemplatesAreForgottenFirst
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheMissingTemplateCacheTestDataSource *dataSource = [[[GRMustacheMissingTemplateCacheTestDataSource alloc] init] autorelease];
+    repository.dataSource = dataSource;
+    repository.configuration.missingTemplateLifetime = 60;
+    repository.configuration.maximumMissingTemplateCount = 2;
+    
+    [repository templateNamed:@"missing1" error:NULL];
+    [repository templateNamed:@"missing2" error:NULL];
+    [repository templateNamed:@"missing3" error:NULL];
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)3, @"");
+    
+    [repository templateNamed:@"missing3" error:NULL];
+    [repository templateNamed:@"missing2" error:NULL];
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)3, @"");
+    
+    [repository templateNamed:@"missing1" error:NULL];
+    STAssertEquals(dataSource.templateStringForTemplateIDCount, (NSUInteger)4, @"");
+}
+
+@end
@@ -0,0 +1,158 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheProfilerTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheProfilerTest
+
+- (void)testProfilerDoesNotAlterRendering
+{
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"<{{#items}}{{name}}{{/items}}>" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingProfiler:profiler];
+    id data = @{ @"items": @[@{ @"name": @"a" }, @{ @"name": @"b" }] };
+    NSString *rendering = [template renderObject:data error:NULL];
+    STAssertEqualObjects(rendering, @"<ab>", @"");
+}
+
+- (void)testProfilerReportsTagsAndLines
+{
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#items}}\n{{name}}\n{{/items}}" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingProfiler:profiler];
+    id data = @{ @"items": @[@{ @"name": @"a" }, @{ @"name": @"b" }] };
+    [template renderObject:data error:NULL];
+    
+    NSString *report = [profiler report];
+    STAssertTrue([report rangeOfString:@"{{#items}} at line 1"].location != NSNotFound, @"");
+    STAssertTrue([report rangeOfString:@"{{name}} at line 2"].location != NSNotFound, @"");
+    
+    // {{name}} is rendered twice
+    for (NSString *line in [report componentsSeparatedByString:@"\n"]) {
+        if ([line hasSuffix:@"{{name}} at line 2"]) {
+            NSArray *columns = [[line componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length > 0"]];
+            STAssertEqualObjects([columns objectAtIndex:2], @"2", @"");
+        }
+    }
+}
+
+- (void)testProfilerReportsPartials
+{
+    NSDictionary *partials = @{ @"main": @"{{>partial}}", @"partial": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:partials];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    template.baseContext = [template.baseContext contextByAddingProfiler:profiler];
+    [template renderObject:@{ @"name": @"a" } error:NULL];
+    
+    NSString *report = [profiler report];
+    STAssertTrue([report rangeOfString:@"template main"].location != NSNotFound, @"");
+    STAssertTrue([report rangeOfString:@"template partial"].location != NSNotFound, @"");
+    STAssertTrue([report rangeOfString:@"{{name}} at partial:1"].location != NSNotFound, @"");
+}
+
+- (void)testCollapsedStacks
+{
+    NSDictionary *partials = @{ @"main": @"{{#items}}{{>partial}}{{/items}}", @"partial": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:partials];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    template.baseContext = [template.baseContext contextByAddingProfiler:profiler];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSUInteger i=0; i<1000; ++i) {
+        [items addObject:@{ @"name": @"a" }];
+    }
+    [template renderObject:@{ @"items": items } error:NULL];
+    
+    NSString *collapsedStacks = [profiler collapsedStacks];
+    STAssertTrue([collapsedStacks hasSuffix:@"\n"], @"");
+    
+    // Stacks with a self time below one microsecond are omitted. Tags and
+    // partials rendered 1000 times are not.
+    NSString *mainStack = @"template main";
+    NSString *sectionStack = [mainStack stringByAppendingString:@";{{#items}} at main:1"];
+    NSString *partialStack = [sectionStack stringByAppendingString:@";template partial"];
+    NSString *variableStack = [partialStack stringByAppendingString:@";{{name}} at partial:1"];
+    NSSet *expectedStacks = [NSSet setWithObjects:mainStack, sectionStack, partialStack, variableStack, nil];
+    
+    NSMutableDictionary *microsecondsForStack = [NSMutableDictionary dictionary];
+    for (NSString *line in [collapsedStacks componentsSeparatedByString:@"\n"]) {
+        if (line.length == 0) continue;
+        NSRange lastSpace = [line rangeOfString:@" " options:NSBackwardsSearch];
+        NSString *stack = [line substringToIndex:lastSpace.location];
+        long long microseconds = [[line substringFromIndex:lastSpace.location+1] longLongValue];
+        STAssertTrue([expectedStacks containsObject:stack], @"unexpected stack %@", stack);
+        STAssertNil([microsecondsForStack objectForKey:stack], @"duplicated stack %@", stack);
+        STAssertTrue(microseconds > 0, @"");
+        [microsecondsForStack setObject:[NSNumber numberWithLongLong:microseconds] forKey:stack];
+    }
+    STAssertNotNil([microsecondsForStack objectForKey:sectionStack], @"");
+    STAssertNotNil([microsecondsForStack objectForKey:partialStack], @"");
+    STAssertNotNil([microsecondsForStack objectForKey:variableStack], @"");
+    
+    // Self times add up to the total time of the template, as given by the
+    // report. Each stack is rounded down to the microsecond, and the report
+    // is rounded to the microsecond.
+    long long collapsedMicroseconds = 0;
+    for (NSNumber *microseconds in [microsecondsForStack allValues]) {
+        collapsedMicroseconds += [microseconds longLongValue];
+    }
+    long long reportedMicroseconds = -1;
+    for (NSString *line in [[profiler report] componentsSeparatedByString:@"\n"]) {
+        if ([line hasSuffix:@"  template main"]) {
+            NSArray *columns = [[line componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length > 0"]];
+            reportedMicroseconds = llround([[columns objectAtIndex:1] doubleValue] * 1000);
+            STAssertEqualObjects([columns objectAtIndex:2], @"1", @"template main is rendered once");
+        }
+    }
+    STAssertTrue(reportedMicroseconds >= 0, @"");
+    STAssertTrue(llabs(collapsedMicroseconds - reportedMicroseconds) <= (long long)expectedStacks.count + 1, @"");
+}
+
+- (void)testReset
+{
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{name}}" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingProfiler:profiler];
+    [template renderObject:nil error:NULL];
+    STAssertTrue([[profiler report] rangeOfString:@"{{name}}"].location != NSNotFound, @"");
+    [profiler reset];
+    STAssertTrue([[profiler report] rangeOfString:@"{{name}}"].location == NSNotFound, @"");
+}
+
+- (void)testProfilerIsPreservedByDerivedContexts
+{
+    GRMustacheProfiler *profiler = [GRMustacheProfiler profiler];
+    GRMustacheContext *context = [[GRMustacheContext context] contextByAddingProfiler:profiler];
+    context = [context contextByAddingObject:@{ @"name": @"a" }];
+    context = [context contextByAddingProtectedObject:@{ @"foo": @"b" }];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{name}}" error:NULL];
+    template.baseContext = context;
+    [template renderObject:nil error:NULL];
+    STAssertTrue([[profiler report] rangeOfString:@"{{name}}"].location != NSNotFound, @"");
+}
+
+@end
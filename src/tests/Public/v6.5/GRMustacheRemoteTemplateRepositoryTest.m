@@ -0,0 +1,219 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+/**
+ * A stand-in for an HTTP template server, that serves the URLs of the
+ * grmustache-test scheme, and honors the If-None-Match header.
+ */
+@interface GRMustacheTestTemplateServer : NSURLProtocol
++ (void)reset;
++ (void)setTemplateString:(NSString *)templateString forPath:(NSString *)path;
++ (NSUInteger)requestCount;
++ (NSUInteger)notModifiedCount;
+@end
+
+static NSMutableDictionary *GRMustacheTestTemplateServerTemplateStrings;
+static NSMutableDictionary *GRMustacheTestTemplateServerEntityTags;
+static NSUInteger GRMustacheTestTemplateServerVersion;
+static NSUInteger GRMustacheTestTemplateServerRequestCount;
+static NSUInteger GRMustacheTestTemplateServerNotModifiedCount;
+
+@implementation GRMustacheTestTemplateServer
+
++ (void)reset
+{
+    @synchronized(self) {
+        [GRMustacheTestTemplateServerTemplateStrings release];
+        GRMustacheTestTemplateServerTemplateStrings = [[NSMutableDictionary alloc] init];
+        [GRMustacheTestTemplateServerEntityTags release];
+        GRMustacheTestTemplateServerEntityTags = [[NSMutableDictionary alloc] init];
+        GRMustacheTestTemplateServerRequestCount = 0;
+        GRMustacheTestTemplateServerNotModifiedCount = 0;
+    }
+}
+
++ (void)setTemplateString:(NSString *)templateString forPath:(NSString *)path
+{
+    @synchronized(self) {
+        [GRMustacheTestTemplateServerTemplateStrings setObject:templateString forKey:path];
+        [GRMustacheTestTemplateServerEntityTags setObject:[NSString stringWithFormat:@"\"%lu\"", (unsigned long)++GRMustacheTestTemplateServerVersion] forKey:path];
+    }
+}
+
++ (NSUInteger)requestCount
+{
+    @synchronized(self) {
+        return GRMustacheTestTemplateServerRequestCount;
+    }
+}
+
++ (NSUInteger)notModifiedCount
+{
+    @synchronized(self) {
+        return GRMustacheTestTemplateServerNotModifiedCount;
+    }
+}
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return [request.URL.scheme isEqualToString:@"grmustache-test"];
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+- (void)startLoading
+{
+    NSString *path = self.request.URL.path;
+    NSInteger statusCode;
+    NSDictionary *headerFields = nil;
+    NSData *body = [NSData data];
+    @synchronized([GRMustacheTestTemplateServer class]) {
+        ++GRMustacheTestTemplateServerRequestCount;
+        NSString *templateString = [GRMustacheTestTemplateServerTemplateStrings objectForKey:path];
+        NSString *entityTag = [GRMustacheTestTemplateServerEntityTags objectForKey:path];
+        if (templateString == nil) {
+            statusCode = 404;
+        } else if ([[self.request valueForHTTPHeaderField:@"If-None-Match"] isEqualToString:entityTag]) {
+            ++GRMustacheTestTemplateServerNotModifiedCount;
+            statusCode = 304;
+        } else {
+            statusCode = 200;
+            headerFields = @{ @"ETag": entityTag };
+            body = [templateString dataUsingEncoding:NSUTF8StringEncoding];
+        }
+    }
+    
+    NSHTTPURLResponse *response = [[[NSHTTPURLResponse alloc] initWithURL:self.request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headerFields] autorelease];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    [self.client URLProtocol:self didLoadData:body];
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading
+{
+}
+
+@end
+
+
+@interface GRMustacheRemoteTemplateRepositoryTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheRemoteTemplateRepositoryTest
+
+- (void)setUp
+{
+    [super setUp];
+    [NSURLProtocol registerClass:[GRMustacheTestTemplateServer class]];
+    [GRMustacheTestTemplateServer reset];
+    [GRMustacheTestTemplateServer setTemplateString:@"<{{>partial}}>" forPath:@"/main.mustache"];
+    [GRMustacheTestTemplateServer setTemplateString:@"{{name}}" forPath:@"/partial.mustache"];
+}
+
+- (void)tearDown
+{
+    [NSURLProtocol unregisterClass:[GRMustacheTestTemplateServer class]];
+    [super tearDown];
+}
+
+- (GRMustacheTemplateRepository *)repositoryWithTemplateCache:(GRMustacheTemplateCache *)templateCache
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithBaseURL:[NSURL URLWithString:@"grmustache-test://templates"]];
+    repository.configuration.templateCache = templateCache;
+    return repository;
+}
+
+- (void)testRemoteTemplatesAreLoaded
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplateCache:nil];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:@{ @"name": @"Arthur" } error:NULL], @"<Arthur>", @"");
+    STAssertEquals([GRMustacheTestTemplateServer requestCount], (NSUInteger)2, @"");
+}
+
+- (void)testRemoteTemplatesAreNotRevalidatedWithoutTemplateCache
+{
+    [[self repositoryWithTemplateCache:nil] templateNamed:@"main" error:NULL];
+    [[self repositoryWithTemplateCache:nil] templateNamed:@"main" error:NULL];
+    STAssertEquals([GRMustacheTestTemplateServer requestCount], (NSUInteger)4, @"");
+    STAssertEquals([GRMustacheTestTemplateServer notModifiedCount], (NSUInteger)0, @"");
+}
+
+- (void)testRemoteTemplatesAreRevalidatedThroughTemplateCache
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    [[self repositoryWithTemplateCache:templateCache] templateNamed:@"main" error:NULL];
+    STAssertEquals([GRMustacheTestTemplateServer requestCount], (NSUInteger)2, @"");
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+    
+    // The template and its partial are revalidated, and not parsed again.
+    GRMustacheTemplate *template = [[self repositoryWithTemplateCache:templateCache] templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:@{ @"name": @"Arthur" } error:NULL], @"<Arthur>", @"");
+    STAssertEquals([GRMustacheTestTemplateServer requestCount], (NSUInteger)4, @"");
+    STAssertEquals([GRMustacheTestTemplateServer notModifiedCount], (NSUInteger)2, @"");
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+}
+
+- (void)testModifiedRemoteTemplatesAreLoadedAgain
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    [[self repositoryWithTemplateCache:templateCache] templateNamed:@"main" error:NULL];
+    [GRMustacheTestTemplateServer setTemplateString:@"{{name}}!" forPath:@"/partial.mustache"];
+    
+    GRMustacheTemplate *template = [[self repositoryWithTemplateCache:templateCache] templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:@{ @"name": @"Arthur" } error:NULL], @"<Arthur!>", @"");
+    STAssertEquals([GRMustacheTestTemplateServer notModifiedCount], (NSUInteger)1, @"");
+}
+
+- (void)testUnusedPrefetchedTemplatesAreForgotten
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    [[self repositoryWithTemplateCache:templateCache] templateNamed:@"main" error:NULL];
+    [GRMustacheTestTemplateServer setTemplateString:@"<>" forPath:@"/main.mustache"];
+    
+    // The partial is prefetched along with main, but no longer used by main.
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplateCache:templateCache];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:nil error:NULL], @"<>", @"");
+    
+    // The stale prefetched partial is not used.
+    [GRMustacheTestTemplateServer setTemplateString:@"{{name}}!" forPath:@"/partial.mustache"];
+    template = [repository templateNamed:@"partial" error:NULL];
+    STAssertEqualObjects([template renderObject:@{ @"name": @"Arthur" } error:NULL], @"Arthur!", @"");
+}
+
+- (void)testMissingRemoteTemplates
+{
+    NSError *error;
+    GRMustacheTemplate *template = [[self repositoryWithTemplateCache:[GRMustacheTemplateCache templateCache]] templateNamed:@"missing" error:&error];
+    STAssertNil(template, @"");
+    STAssertEqualObjects(error.domain, NSCocoaErrorDomain, @"");
+    STAssertEquals(error.code, (NSInteger)NSFileReadNoSuchFileError, @"");
+}
+
+@end
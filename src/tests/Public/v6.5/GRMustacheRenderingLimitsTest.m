@@ -0,0 +1,205 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheRenderingLimitsTest : GRMustachePublicAPITest
+- (GRMustacheTemplateRepository *)repositoryWithTemplates:(NSDictionary *)templates;
+- (id)treeWithDepth:(NSUInteger)depth;
+@end
+
+@implementation GRMustacheRenderingLimitsTest
+
+- (GRMustacheTemplateRepository *)repositoryWithTemplates:(NSDictionary *)templates
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    repository.configuration = [GRMustacheConfiguration configuration];
+    return repository;
+}
+
+- (id)treeWithDepth:(NSUInteger)depth
+{
+    NSMutableDictionary *tree = [NSMutableDictionary dictionaryWithObject:@"node" forKey:@"name"];
+    if (depth > 0) {
+        [tree setObject:@[[self treeWithDepth:depth - 1]] forKey:@"children"];
+    }
+    return tree;
+}
+
+- (void)testNoLimitByDefault
+{
+    GRMustacheConfiguration *configuration = [GRMustacheConfiguration configuration];
+    STAssertEquals(configuration.maximumRenderedLength, (NSUInteger)0, @"");
+    STAssertEquals(configuration.maximumRenderingDuration, (NSTimeInterval)0, @"");
+    STAssertEquals(configuration.maximumPartialDepth, (NSUInteger)0, @"");
+    STAssertEquals(configuration.maximumIterationCount, (NSUInteger)0, @"");
+}
+
+- (void)testLimitsAreCopied
+{
+    GRMustacheConfiguration *configuration = [GRMustacheConfiguration configuration];
+    configuration.maximumRenderedLength = 1;
+    configuration.maximumRenderingDuration = 2;
+    configuration.maximumPartialDepth = 3;
+    configuration.maximumIterationCount = 4;
+    GRMustacheConfiguration *copy = [[configuration copy] autorelease];
+    STAssertEquals(copy.maximumRenderedLength, (NSUInteger)1, @"");
+    STAssertEquals(copy.maximumRenderingDuration, (NSTimeInterval)2, @"");
+    STAssertEquals(copy.maximumPartialDepth, (NSUInteger)3, @"");
+    STAssertEquals(copy.maximumIterationCount, (NSUInteger)4, @"");
+}
+
+- (void)testMaximumPartialDepth
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{ @"tree": @"{{name}}{{#children}}{{>tree}}{{/children}}" }];
+    repository.configuration.maximumPartialDepth = 3;
+    GRMustacheTemplate *template = [repository templateNamed:@"tree" error:NULL];
+    
+    NSString *rendering = [template renderObject:[self treeWithDepth:3] error:NULL];
+    STAssertEqualObjects(rendering, @"nodenodenodenode", @"");
+    
+    NSError *error;
+    rendering = [template renderObject:[self treeWithDepth:4] error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+}
+
+- (void)testMaximumIterationCount
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumIterationCount = 3;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#items}}{{.}}{{/items}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"items": @[@1, @2, @3] } error:NULL];
+    STAssertEqualObjects(rendering, @"123", @"");
+    
+    NSError *error;
+    rendering = [template renderObject:@{ @"items": @[@1, @2, @3, @4] } error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+}
+
+- (void)testMaximumIterationCountAppliesToEachRendering
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumIterationCount = 3;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#items}}{{.}}{{/items}}" error:NULL];
+    
+    id data = @{ @"items": @[@1, @2, @3] };
+    STAssertEqualObjects([template renderObject:data error:NULL], @"123", @"");
+    STAssertEqualObjects([template renderObject:data error:NULL], @"123", @"");
+    STAssertEqualObjects([template renderObjectsFromArray:@[data] error:NULL], @"123", @"");
+}
+
+- (void)testMaximumRenderedLength
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumRenderedLength = 6;
+    GRMustacheTemplate *template = [repository templateFromString:@"<{{name}}>" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"name": @"1234" } error:NULL];
+    STAssertEqualObjects(rendering, @"<1234>", @"");
+    
+    NSError *error;
+    rendering = [template renderObject:@{ @"name": @"12345" } error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+}
+
+- (void)testMaximumRenderedLengthCountsSectionContentOnce
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumRenderedLength = 6;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#items}}<{{.}}>{{/items}}" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"items": @[@1, @2] } error:NULL];
+    STAssertEqualObjects(rendering, @"<1><2>", @"");
+}
+
+- (void)testMaximumRenderedLengthCountsDynamicPartialsOnce
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{ @"partial": @"<{{name}}>" }];
+    repository.configuration.maximumRenderedLength = 7;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{partial}}!" error:NULL];
+    GRMustacheTemplate *partial = [repository templateNamed:@"partial" error:NULL];
+    
+    NSString *rendering = [template renderObject:@{ @"partial": partial, @"name": @"1234" } error:NULL];
+    STAssertEqualObjects(rendering, @"<1234>!", @"");
+    
+    NSError *error;
+    rendering = [template renderObject:@{ @"partial": partial, @"name": @"12345" } error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+}
+
+- (void)testMaximumRenderedLengthCountsSectionRenderingObjects
+{
+    id renderingObject = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        return [[tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error] stringByAppendingString:@"1234567890"];
+    }];
+    
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumRenderedLength = 6;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#object}}<>{{/object}}" error:NULL];
+    
+    NSError *error;
+    NSString *rendering = [template renderObject:@{ @"object": renderingObject } error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+    
+    repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumRenderedLength = 12;
+    template = [repository templateFromString:@"{{#object}}<>{{/object}}" error:NULL];
+    rendering = [template renderObject:@{ @"object": renderingObject } error:NULL];
+    STAssertEqualObjects(rendering, @"<>1234567890", @"");
+}
+
+- (void)testMaximumRenderingDuration
+{
+    id slow = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        [NSThread sleepForTimeInterval:0.02];
+        return @"";
+    }];
+    
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumRenderingDuration = 0.01;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#items}}{{slow}}{{/items}}" error:NULL];
+    
+    NSError *error;
+    NSString *rendering = [template renderObject:@{ @"items": @[@1, @2], @"slow": slow } error:&error];
+    STAssertNil(rendering, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeRenderingLimitExceeded, @"");
+}
+
+- (void)testLimitedRepositoryDoesNotAffectOtherRepositories
+{
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplates:@{}];
+    repository.configuration.maximumIterationCount = 1;
+    
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#items}}{{.}}{{/items}}" error:NULL];
+    NSString *rendering = [template renderObject:@{ @"items": @[@1, @2, @3] } error:NULL];
+    STAssertEqualObjects(rendering, @"123", @"");
+}
+
+@end
@@ -0,0 +1,177 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateAnalysisTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateAnalysisTest
+
+- (void)testTagCounts
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{a}}{{{b}}}{{#c}}{{d}}{{/c}}{{^e}}{{f}}{{/e}}{{$g}}{{/g}}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.variableTagCount, (NSUInteger)4, @"");
+    STAssertEquals(analysis.sectionTagCount, (NSUInteger)1, @"");
+    STAssertEquals(analysis.invertedSectionTagCount, (NSUInteger)1, @"");
+    STAssertEquals(analysis.overridableSectionTagCount, (NSUInteger)1, @"");
+    STAssertEquals(analysis.partialCount, (NSUInteger)0, @"");
+    STAssertEquals(analysis.maximumPartialDepth, (NSUInteger)0, @"");
+    STAssertFalse(analysis.hasRecursivePartials, @"");
+}
+
+- (void)testMaximumSectionDepth
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{a}}{{#b}}{{#c}}{{^d}}{{/d}}{{/c}}{{/b}}{{#e}}{{/e}}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.maximumSectionDepth, (NSUInteger)3, @"");
+}
+
+- (void)testFilterCallCount
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{ f(x) }}{{ f(x,y) }}{{# f(g(x)) }}{{/ f(g(x)) }}{{ a.b }}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.filterCallCount, (NSUInteger)4, @"");
+}
+
+- (void)testPartials
+{
+    NSDictionary *templates = @{ @"main": @"{{>a}}{{>a}}{{#items}}{{>b}}{{/items}}",
+                                 @"a": @"{{>c}}",
+                                 @"b": @"{{#x}}{{y}}{{/x}}",
+                                 @"c": @"{{z}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.partialCount, (NSUInteger)3, @"");
+    STAssertEquals(analysis.maximumPartialFanOut, (NSUInteger)3, @"");
+    STAssertEquals(analysis.maximumPartialDepth, (NSUInteger)2, @"");
+    STAssertEquals(analysis.maximumSectionDepth, (NSUInteger)2, @"");
+    STAssertEquals(analysis.variableTagCount, (NSUInteger)3, @"partials are counted as many times as they are embedded");
+    STAssertEquals(analysis.sectionTagCount, (NSUInteger)2, @"");
+    STAssertFalse(analysis.hasRecursivePartials, @"");
+}
+
+- (void)testRecursivePartials
+{
+    NSDictionary *templates = @{ @"main": @"{{>node}}",
+                                 @"node": @"{{name}}{{#children}}{{>node}}{{/children}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertTrue(analysis.hasRecursivePartials, @"");
+    STAssertEquals(analysis.partialCount, (NSUInteger)1, @"");
+    STAssertEquals(analysis.variableTagCount, (NSUInteger)1, @"");
+}
+
+- (void)testCombinatorialPartialsAreAnalyzedQuickly
+{
+    // Each partial embeds the next one twice: a naive expansion would visit
+    // 2^64 tags.
+    NSMutableDictionary *templates = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 64; ++i) {
+        [templates setObject:[NSString stringWithFormat:@"{{>p%lu}}{{>p%lu}}", (unsigned long)(i+1), (unsigned long)(i+1)] forKey:[NSString stringWithFormat:@"p%lu", (unsigned long)i]];
+    }
+    [templates setObject:@"{{name}}" forKey:@"p64"];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"p0" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.maximumPartialDepth, (NSUInteger)64, @"");
+    STAssertEquals(analysis.partialCount, (NSUInteger)64, @"");
+    STAssertEquals(analysis.variableTagCount, NSUIntegerMax, @"counts saturate");
+}
+
+- (void)testOverrideDepth
+{
+    NSDictionary *templates = @{ @"main": @"{{<layout}}{{$content}}main{{/content}}{{/layout}}",
+                                 @"layout": @"{{<base}}{{$body}}{{$content}}{{/content}}{{/body}}{{/base}}",
+                                 @"base": @"{{$body}}{{/body}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    STAssertEquals(analysis.maximumOverrideDepth, (NSUInteger)2, @"");
+    STAssertEquals(analysis.partialCount, (NSUInteger)2, @"");
+}
+
+- (void)testEstimatedCost
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#items}}{{name}}{{#tags}}{{ uppercase(.) }}{{/tags}}{{/items}}{{^items}}empty{{/items}}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    
+    // items: 1 + 10 * (name: 1 + tags: 1 + 3 * (1 tag + 1 filter call)) = 81
+    // ^items: 1
+    double cost = [analysis estimatedCostWithCardinalities:@{ @"items": @10, @"tags": @3 } defaultCardinality:1];
+    STAssertEquals(cost, 82., @"");
+    
+    // Unknown cardinalities default to the defaultCardinality argument.
+    cost = [analysis estimatedCostWithCardinalities:@{ @"items": @10 } defaultCardinality:0];
+    STAssertEquals(cost, 22., @"");
+}
+
+- (void)testEstimatedCostKeys
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{# user.friends }}{{a}}{{/ user.friends }}{{# reverse(items) }}{{b}}{{/ reverse(items) }}{{# f(x, y) }}{{c}}{{/ f(x, y) }}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    double cost = [analysis estimatedCostWithCardinalities:@{ @"user.friends": @10, @"reverse(items)": @100, @"f(x,y)": @1000 } defaultCardinality:0];
+    
+    // 3 section tags, 2 filter calls, 1110 variable tags
+    STAssertEquals(cost, 1115., @"");
+}
+
+- (void)testDataRequirements
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{user.name}}{{#items}}{{price}}{{^@last}},{{/}}{{/items}}{{^empty}}{{.}}{{/empty}}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    NSDictionary *expected = @{ @"user": @{ @"name": @{} },
+                                @"items": @{ @"price": @{} },
+                                @"empty": @{} };
+    STAssertEqualObjects([analysis dataRequirements], expected, @"");
+}
+
+- (void)testDataRequirementsOfFilters
+{
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{ uppercase(user.name) }}{{# reverse(items) }}{{ f(price, .tax) }}{{/}}" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    NSDictionary *expected = @{ @"uppercase": @{},
+                                @"user": @{ @"name": @{} },
+                                @"reverse": @{},
+                                @"items": @{ @"f": @{}, @"price": @{}, @"tax": @{} } };
+    STAssertEqualObjects([analysis dataRequirements], expected, @"");
+}
+
+- (void)testDataRequirementsOfPartials
+{
+    NSDictionary *templates = @{ @"main": @"{{#user}}{{>card}}{{/user}}{{<layout}}{{$body}}{{content}}{{/body}}{{/layout}}",
+                                 @"card": @"{{name}}{{#friends}}{{>card}}{{/friends}}",
+                                 @"layout": @"{{title}}{{$body}}{{/body}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheTemplateAnalysis *analysis = [GRMustacheTemplateAnalysis analysisWithTemplate:template];
+    NSDictionary *expected = @{ @"user": @{ @"name": @{}, @"friends": @{ @"name": @{}, @"friends": @{} } },
+                                @"title": @{},
+                                @"body": @{ @"content": @{} } };
+    STAssertEqualObjects([analysis dataRequirements], expected, @"");
+}
+
+@end
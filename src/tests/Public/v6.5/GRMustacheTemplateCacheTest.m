@@ -0,0 +1,172 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateCacheTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateCacheTest
+
+- (GRMustacheTemplateRepository *)repositoryWithTemplateCache:(GRMustacheTemplateCache *)templateCache name:(NSString *)name
+{
+    NSDictionary *partials = @{ @"main": @"{{name}}: {{>partial}}", @"partial": @"{{#items}}{{.}}{{/items}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:partials];
+    repository.configuration.templateCache = templateCache;
+    repository.configuration.baseContext = [repository.configuration.baseContext contextByAddingObject:@{ @"name": name }];
+    return repository;
+}
+
+- (void)testTemplateCacheIsNilByDefault
+{
+    STAssertNil([GRMustacheConfiguration configuration].templateCache, @"");
+    STAssertNil([GRMustacheConfiguration defaultConfiguration].templateCache, @"");
+}
+
+- (void)testConfigurationCopySharesTemplateCache
+{
+    GRMustacheConfiguration *configuration = [GRMustacheConfiguration configuration];
+    configuration.templateCache = [GRMustacheTemplateCache templateCache];
+    GRMustacheConfiguration *copy = [[configuration copy] autorelease];
+    STAssertEquals(copy.templateCache, configuration.templateCache, @"");
+}
+
+- (void)testRepositoriesShareParsings
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    GRMustacheTemplateRepository *repository1 = [self repositoryWithTemplateCache:templateCache name:@"tenant1"];
+    GRMustacheTemplateRepository *repository2 = [self repositoryWithTemplateCache:templateCache name:@"tenant2"];
+    
+    GRMustacheTemplate *template1 = [repository1 templateNamed:@"main" error:NULL];
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+    GRMustacheTemplate *template2 = [repository2 templateNamed:@"main" error:NULL];
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+    
+    // Each repository keeps its own base context
+    id data = @{ @"items": @[@1, @2] };
+    STAssertEqualObjects([template1 renderObject:data error:NULL], @"tenant1: 12", @"");
+    STAssertEqualObjects([template2 renderObject:data error:NULL], @"tenant2: 12", @"");
+}
+
+- (void)testTagsReferToTheirOwnRepository
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    GRMustacheTemplateRepository *repository1 = [self repositoryWithTemplateCache:templateCache name:@"tenant1"];
+    GRMustacheTemplateRepository *repository2 = [self repositoryWithTemplateCache:templateCache name:@"tenant2"];
+    
+    __block GRMustacheTemplateRepository *tagRepository = nil;
+    id data = @{ @"items": [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        tagRepository = tag.templateRepository;
+        return nil;
+    }] };
+    
+    [[repository1 templateNamed:@"main" error:NULL] renderObject:data error:NULL];
+    STAssertEquals(tagRepository, repository1, @"");
+    [[repository2 templateNamed:@"main" error:NULL] renderObject:data error:NULL];
+    STAssertEquals(tagRepository, repository2, @"");
+}
+
+- (void)testDelimitersAreNotShared
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    
+    GRMustacheTemplateRepository *repository1 = [GRMustacheTemplateRepository templateRepository];
+    repository1.configuration.templateCache = templateCache;
+    
+    GRMustacheTemplateRepository *repository2 = [GRMustacheTemplateRepository templateRepository];
+    repository2.configuration.templateCache = templateCache;
+    repository2.configuration.tagStartDelimiter = @"<%";
+    repository2.configuration.tagEndDelimiter = @"%>";
+    
+    id data = @{ @"name": @"Arthur" };
+    STAssertEqualObjects([[repository1 templateFromString:@"{{name}}<%name%>" error:NULL] renderObject:data error:NULL], @"Arthur<%name%>", @"");
+    STAssertEqualObjects([[repository2 templateFromString:@"{{name}}<%name%>" error:NULL] renderObject:data error:NULL], @"{{name}}Arthur", @"");
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+}
+
+- (void)testContentTypeIsNotShared
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    
+    GRMustacheTemplateRepository *repository1 = [GRMustacheTemplateRepository templateRepository];
+    repository1.configuration.templateCache = templateCache;
+    
+    GRMustacheTemplateRepository *repository2 = [GRMustacheTemplateRepository templateRepository];
+    repository2.configuration.templateCache = templateCache;
+    repository2.configuration.contentType = GRMustacheContentTypeText;
+    
+    id data = @{ @"name": @"<>" };
+    STAssertEqualObjects([[repository1 templateFromString:@"{{name}}" error:NULL] renderObject:data error:NULL], @"&lt;&gt;", @"");
+    STAssertEqualObjects([[repository2 templateFromString:@"{{name}}" error:NULL] renderObject:data error:NULL], @"<>", @"");
+    STAssertEquals(templateCache.count, (NSUInteger)1, @"");
+}
+
+- (void)testParseErrorsAreNotCached
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    repository.configuration.templateCache = templateCache;
+    
+    NSError *error;
+    STAssertNil([repository templateFromString:@"{{" error:&error], @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEquals(templateCache.count, (NSUInteger)0, @"");
+}
+
+- (void)testMaximumTemplateCount
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    STAssertEquals(templateCache.maximumTemplateCount, (NSUInteger)1000, @"");
+    templateCache.maximumTemplateCount = 2;
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    repository.configuration.templateCache = templateCache;
+    
+    [repository templateFromString:@"a" error:NULL];
+    [repository templateFromString:@"b" error:NULL];
+    [repository templateFromString:@"a" error:NULL];    // a is now more recent than b
+    [repository templateFromString:@"c" error:NULL];    // b is forgotten
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+    [repository templateFromString:@"a" error:NULL];    // a is still cached
+    STAssertEquals(templateCache.count, (NSUInteger)2, @"");
+    
+    templateCache.maximumTemplateCount = 1;             // c is forgotten
+    STAssertEquals(templateCache.count, (NSUInteger)1, @"");
+    
+    templateCache.maximumTemplateCount = 0;
+    STAssertEquals(templateCache.count, (NSUInteger)0, @"");
+    STAssertEqualObjects([[repository templateFromString:@"{{name}}" error:NULL] renderObject:@{ @"name": @"Arthur" } error:NULL], @"Arthur", @"");
+    STAssertEquals(templateCache.count, (NSUInteger)0, @"");
+}
+
+- (void)testRemoveAllTemplates
+{
+    GRMustacheTemplateCache *templateCache = [GRMustacheTemplateCache templateCache];
+    GRMustacheTemplateRepository *repository = [self repositoryWithTemplateCache:templateCache name:@"tenant"];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    [templateCache removeAllTemplates];
+    STAssertEquals(templateCache.count, (NSUInteger)0, @"");
+    STAssertEqualObjects([template renderObject:@{ @"items": @[@1] } error:NULL], @"tenant: 1", @"");
+}
+
+@end
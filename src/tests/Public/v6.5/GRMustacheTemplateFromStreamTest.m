@@ -0,0 +1,81 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateFromStreamTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateFromStreamTest
+
+- (GRMustacheTemplate *)templateFromStreamedString:(NSString *)templateString repository:(GRMustacheTemplateRepository *)repository error:(NSError **)error
+{
+    NSInputStream *stream = [NSInputStream inputStreamWithData:[templateString dataUsingEncoding:NSUTF8StringEncoding]];
+    return [repository templateFromStream:stream encoding:NSUTF8StringEncoding error:error];
+}
+
+- (void)testTemplateFromStream
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{ @"partial": @"[{{.}}]" }];
+    NSError *error;
+    GRMustacheTemplate *template = [self templateFromStreamedString:@"{{#items}}{{>partial}}{{/items}} {{name}}" repository:repository error:&error];
+    STAssertNotNil(template, @"%@", error);
+    STAssertEqualObjects([template renderObject:@{ @"items": @[@1, @2], @"name": @"été" } error:NULL], @"[1][2] été", @"");
+}
+
+- (void)testLargeTemplateFromStream
+{
+    // Larger than a stream chunk
+    NSMutableString *templateString = [NSMutableString string];
+    for (NSUInteger i = 0; i < 20000; ++i) {
+        [templateString appendFormat:@"{{#a}}<{{b}}>{{/a}}{{=[[ ]]=}}%lu[[={{ }}=]]\n", (unsigned long)i];
+    }
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    GRMustacheTemplate *streamedTemplate = [self templateFromStreamedString:templateString repository:repository error:NULL];
+    GRMustacheTemplate *template = [repository templateFromString:templateString error:NULL];
+    id data = @{ @"a": @YES, @"b": @"é" };
+    STAssertEqualObjects([streamedTemplate renderObject:data error:NULL], [template renderObject:data error:NULL], @"");
+}
+
+- (void)testInnerTemplateStringOfStreamedSection
+{
+    __block NSString *innerTemplateString = nil;
+    id data = @{ @"section": [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        innerTemplateString = [[tag.innerTemplateString copy] autorelease];
+        return nil;
+    }] };
+    GRMustacheTemplate *template = [self templateFromStreamedString:@"{{#section}}é {{name}}{{/section}}" repository:[GRMustacheTemplateRepository templateRepository] error:NULL];
+    [template renderObject:data error:NULL];
+    STAssertEqualObjects(innerTemplateString, @"é {{name}}", @"");
+}
+
+- (void)testParseErrorFromStream
+{
+    NSError *error;
+    GRMustacheTemplate *template = [self templateFromStreamedString:@"\n{{#a}}" repository:[GRMustacheTemplateRepository templateRepository] error:&error];
+    STAssertNil(template, @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeParseError, @"");
+}
+
+@end
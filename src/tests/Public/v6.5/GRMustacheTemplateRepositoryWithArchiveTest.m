@@ -0,0 +1,163 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateRepositoryWithArchiveTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateRepositoryWithArchiveTest
+
+// Writes an archive, as src/bin/buildGRMustacheArchive would.
+- (NSString *)archivePathWithTemplates:(NSDictionary *)templates
+{
+    NSMutableDictionary *index = [NSMutableDictionary dictionary];
+    NSMutableData *contents = [NSMutableData data];
+    for (NSString *path in templates) {
+        NSData *data = [[templates objectForKey:path] dataUsingEncoding:NSUTF8StringEncoding];
+        [index setObject:@[@(contents.length), @(data.length)] forKey:path];
+        [contents appendData:data];
+    }
+    NSData *indexData = [NSJSONSerialization dataWithJSONObject:index options:0 error:NULL];
+    NSMutableData *archive = [NSMutableData data];
+    [archive appendData:[[NSString stringWithFormat:@"GRMustacheArchive 1\n%lu\n", (unsigned long)indexData.length] dataUsingEncoding:NSUTF8StringEncoding]];
+    [archive appendData:indexData];
+    [archive appendData:contents];
+    
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.archive"];
+    [archive writeToFile:path atomically:YES];
+    return path;
+}
+
+- (void)testTemplatesAndRelativePartials
+{
+    NSDictionary *templates = @{ @"main.mustache": @"main {{>partials/a}}",
+                                 @"partials/a.mustache": @"a {{>../b}} {{>/partials/c}}",
+                                 @"partials/c.mustache": @"c",
+                                 @"b.mustache": @"b" };
+    NSError *error;
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:[self archivePathWithTemplates:templates] error:&error];
+    STAssertNotNil(repository, @"%@", error);
+    
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:nil error:NULL], @"main a b c", @"");
+    
+    template = [repository templateFromString:@"{{>partials/c}}" error:NULL];
+    STAssertEqualObjects([template renderObject:nil error:NULL], @"c", @"");
+}
+
+- (void)testTemplateExtension
+{
+    NSDictionary *templates = @{ @"main.txt": @"main {{>partial}}", @"partial.txt": @"partial" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:[self archivePathWithTemplates:templates]
+                                                                                               templateExtension:@"txt"
+                                                                                                        encoding:NSUTF8StringEncoding
+                                                                                                           error:NULL];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    STAssertEqualObjects([template renderObject:nil error:NULL], @"main partial", @"");
+}
+
+- (void)testMissingTemplates
+{
+    NSDictionary *templates = @{ @"main.mustache": @"{{>missing}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:[self archivePathWithTemplates:templates] error:NULL];
+    
+    NSError *error;
+    STAssertNil([repository templateNamed:@"missing" error:&error], @"");
+    STAssertEqualObjects(error.domain, GRMustacheErrorDomain, @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeTemplateNotFound, @"");
+    
+    STAssertNil([repository templateNamed:@"main" error:&error], @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeTemplateNotFound, @"");
+    
+    STAssertNil([repository templateNamed:@"../main" error:&error], @"");
+    STAssertEquals(error.code, (NSInteger)GRMustacheErrorCodeTemplateNotFound, @"");
+}
+
+- (void)testInvalidArchive
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.invalid"];
+    [[@"GRMustacheArchive 1\n1000\n{}" dataUsingEncoding:NSUTF8StringEncoding] writeToFile:path atomically:YES];
+    
+    NSError *error;
+    STAssertNil([GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:path error:&error], @"");
+    STAssertNotNil(error, @"");
+    
+    STAssertNil([GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:@"/GRMustacheTemplateRepositoryWithArchiveTest/missing" error:&error], @"");
+    STAssertNotNil(error, @"");
+}
+
+- (void)testMalformedArchiveIndex
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.invalid"];
+    NSArray *indexes = @[@"{\"a.mustache\":null}",
+                         @"{\"a.mustache\":\"0,1\"}",
+                         @"{\"a.mustache\":[0]}",
+                         @"{\"a.mustache\":[null,1]}",
+                         @"{\"a.mustache\":[\"0\",\"1\"]}",
+                         @"{\"a.mustache\":[-1,1]}",
+                         @"[[0,1]]"];
+    for (NSString *index in indexes) {
+        NSString *archive = [NSString stringWithFormat:@"GRMustacheArchive 1\n%lu\n%@a", (unsigned long)index.length, index];
+        [[archive dataUsingEncoding:NSUTF8StringEncoding] writeToFile:path atomically:YES];
+        
+        NSError *error = nil;
+        STAssertNil([GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:path error:&error], @"%@", index);
+        STAssertEqualObjects(error.domain, NSCocoaErrorDomain, @"%@", index);
+        STAssertEquals(error.code, (NSInteger)NSFileReadCorruptFileError, @"%@", index);
+    }
+}
+
+- (void)testWriteArchiveWithDirectory
+{
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest"];
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [fileManager removeItemAtPath:directoryPath error:NULL];
+    [fileManager createDirectoryAtPath:[directoryPath stringByAppendingPathComponent:@"partials"] withIntermediateDirectories:YES attributes:nil error:NULL];
+    [@"main {{>partials/a}}" writeToFile:[directoryPath stringByAppendingPathComponent:@"main.mustache"] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [@"a {{>../b}}" writeToFile:[directoryPath stringByAppendingPathComponent:@"partials/a.mustache"] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [@"b" writeToFile:[directoryPath stringByAppendingPathComponent:@"b.mustache"] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [@"ignored" writeToFile:[directoryPath stringByAppendingPathComponent:@"main.txt"] atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    
+    NSString *archivePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.written.archive"];
+    NSError *error;
+    STAssertTrue([GRMustacheTemplateRepository writeArchiveWithDirectory:directoryPath templateExtension:@"mustache" toPath:archivePath error:&error], @"%@", error);
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:archivePath error:&error];
+    STAssertNotNil(repository, @"%@", error);
+    STAssertEqualObjects([[repository templateNamed:@"main" error:NULL] renderObject:nil error:NULL], @"main a b", @"");
+    
+    repository = [GRMustacheTemplateRepository templateRepositoryWithArchiveAtPath:archivePath templateExtension:@"txt" encoding:NSUTF8StringEncoding error:NULL];
+    STAssertNil([repository templateNamed:@"main" error:NULL], @"");
+}
+
+- (void)testWriteArchiveWithMissingDirectory
+{
+    NSString *directoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.missing"];
+    NSString *archivePath = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateRepositoryWithArchiveTest.missing.archive"];
+    NSError *error = nil;
+    STAssertFalse([GRMustacheTemplateRepository writeArchiveWithDirectory:directoryPath templateExtension:@"mustache" toPath:archivePath error:&error], @"");
+    STAssertNotNil(error, @"");
+}
+
+@end
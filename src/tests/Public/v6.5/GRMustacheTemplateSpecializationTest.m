@@ -0,0 +1,90 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateSpecializationTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateSpecializationTest
+
+- (void)testFrozenVariableTagsArePrerendered
+{
+    NSMutableDictionary *constants = [NSMutableDictionary dictionaryWithObject:@"A&B" forKey:@"brand"];
+    GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:constants];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{brand}} {{{brand}}} {{name}}" error:NULL];
+    GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+    
+    [constants setObject:@"C&D" forKey:@"brand"];
+    NSString *rendering = [residual renderObject:@{ @"brand": @"ignored", @"name": @"<Arthur>" } error:NULL];
+    STAssertEqualObjects(rendering, @"A&amp;B A&B &lt;Arthur&gt;", @"");
+}
+
+- (void)testFrozenSectionsArePrunedOrUnrolled
+{
+    NSMutableDictionary *constants = [NSMutableDictionary dictionaryWithObject:@NO forKey:@"beta"];
+    GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:constants];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#beta}}beta{{/beta}}{{^beta}}stable {{name}}{{/beta}}{{#missing}}missing{{/missing}}" error:NULL];
+    GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+    
+    [constants setObject:@YES forKey:@"beta"];
+    NSString *rendering = [residual renderObject:@{ @"name": @"Arthur" } error:NULL];
+    STAssertEqualObjects(rendering, @"stable Arthur", @"");
+}
+
+- (void)testRuntimeDataIsStillRendered
+{
+    GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:@{ @"beta": @YES, @"separator": @", " }];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{#beta}}{{name}}{{/beta}}: {{#items}}{{.}}{{^@last}}{{separator}}{{/}}{{/items}}" error:NULL];
+    GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+    
+    NSString *rendering = [residual renderObject:@{ @"name": @"Arthur", @"items": @[@"a", @"b"] } error:NULL];
+    STAssertEqualObjects(rendering, @"Arthur: a, b", @"");
+}
+
+- (void)testPartialsAreSpecialized
+{
+    NSMutableDictionary *constants = [NSMutableDictionary dictionaryWithObject:@"Acme" forKey:@"brand"];
+    GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:constants];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:@{ @"main": @"{{>header}}{{>node}}",
+                                                                                                               @"header": @"{{brand}}: ",
+                                                                                                               @"node": @"{{name}}{{#children}}({{>node}}){{/children}}" }];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+    
+    [constants setObject:@"Other" forKey:@"brand"];
+    id data = @{ @"name": @"a", @"children": @[@{ @"name": @"b" }] };
+    NSString *rendering = [residual renderObject:data error:NULL];
+    STAssertEqualObjects(rendering, @"Acme: a(b)", @"");
+}
+
+- (void)testResidualTemplateHasFrozenContextAsBaseContext
+{
+    GRMustacheContext *context = [GRMustacheContext contextWithProtectedObject:@{ @"brand": @"Acme" }];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"{{brand}}" error:NULL];
+    GRMustacheTemplate *residual = [template templateBySpecializingWithContext:context];
+    STAssertEquals(residual.baseContext, context, @"");
+    STAssertEqualObjects([template renderObject:nil error:NULL], @"", @"");
+}
+
+@end
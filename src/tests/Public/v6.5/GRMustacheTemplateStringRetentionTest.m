@@ -0,0 +1,148 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTemplateStringRetentionTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTemplateStringRetentionTest
+
+- (void)tearDown
+{
+    [super tearDown];
+    [GRMustacheConfiguration defaultConfiguration].retainsTemplateStrings = YES;
+}
+
+- (void)testDefaultConfigurationRetainsTemplateStrings
+{
+    STAssertTrue([GRMustacheConfiguration configuration].retainsTemplateStrings, @"");
+}
+
+- (void)testCopyOfConfigurationHasSameRetainsTemplateStrings
+{
+    GRMustacheConfiguration *configuration = [GRMustacheConfiguration configuration];
+    configuration.retainsTemplateStrings = NO;
+    GRMustacheConfiguration *copy = [[configuration copy] autorelease];
+    STAssertFalse(copy.retainsTemplateStrings, @"");
+}
+
+- (void)testInnerTemplateStringIsLoadedAgainFromDataSource
+{
+    NSDictionary *templates = @{ @"main": @"<{{#wrap}}{{name}}{{/wrap}}>" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    repository.configuration.retainsTemplateStrings = NO;
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    
+    __block NSString *innerTemplateString = nil;
+    id wrap = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        innerTemplateString = [[tag.innerTemplateString copy] autorelease];
+        return [tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }];
+    NSString *rendering = [template renderObject:@{ @"wrap": wrap, @"name": @"Arthur" } error:NULL];
+    STAssertEqualObjects(rendering, @"<Arthur>", @"");
+    STAssertEqualObjects(innerTemplateString, @"{{name}}", @"");
+}
+
+- (void)testTemplatesOutliveTheRepositoryTheyAreLoadedFrom
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateStringRetentionTest.mustache"];
+    [@"<{{#wrap}}{{name}}{{/wrap}}>" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    [GRMustacheConfiguration defaultConfiguration].retainsTemplateStrings = NO;
+    
+    // The class constructor uses a repository which is deallocated with the
+    // autorelease pool.
+    GRMustacheTemplate *template = nil;
+    @autoreleasepool {
+        template = [[GRMustacheTemplate templateFromContentsOfFile:path error:NULL] retain];
+    }
+    [template autorelease];
+    
+    __block NSString *innerTemplateString = nil;
+    id wrap = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        innerTemplateString = [[tag.innerTemplateString copy] autorelease];
+        return [tag renderContentWithContext:context HTMLSafe:HTMLSafe error:error];
+    }];
+    NSString *rendering = [template renderObject:@{ @"wrap": wrap, @"name": @"Arthur" } error:NULL];
+    STAssertEqualObjects(rendering, @"<Arthur>", @"");
+    STAssertEqualObjects(innerTemplateString, @"{{name}}", @"");
+}
+
+- (void)testChangedTemplateStringsRaise
+{
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"GRMustacheTemplateStringRetentionTest.mustache"];
+    [@"<{{#wrap}}{{name}}{{/wrap}}>" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithBaseURL:[NSURL fileURLWithPath:NSTemporaryDirectory()]];
+    repository.configuration.retainsTemplateStrings = NO;
+    GRMustacheTemplate *template = [repository templateNamed:@"GRMustacheTemplateStringRetentionTest" error:NULL];
+    
+    id wrap = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        return [[tag.innerTemplateString copy] autorelease];
+    }];
+    id data = @{ @"wrap": wrap };
+    STAssertEqualObjects([template renderObject:data error:NULL], @"<{{name}}>", @"");
+    
+    // Same length
+    [@"<{{#wrap}}{{nick}}{{/wrap}}>" writeToFile:path atomically:YES encoding:NSUTF8StringEncoding error:NULL];
+    STAssertThrowsSpecificNamed([template renderObject:data error:NULL], NSException, GRMustacheRenderingException, @"");
+    
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+    STAssertThrowsSpecificNamed([template renderObject:data error:NULL], NSException, GRMustacheRenderingException, @"");
+}
+
+- (void)testTemplatesThatDoNotRetainTemplateStringsUseLessMemory
+{
+    NSString *templateString = @"{{#items}}{{name}}{{/items}}{{#items}}{{name}}{{/items}}";
+    NSDictionary *templates = @{ @"main": templateString };
+    
+    GRMustacheTemplateRepository *retainingRepository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *retainingTemplate = [retainingRepository templateNamed:@"main" error:NULL];
+    
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    repository.configuration.retainsTemplateStrings = NO;
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    
+    NSUInteger retainingBytes = [retainingTemplate.memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTemplateStrings];
+    NSUInteger bytes = [template.memoryFootprint bytesInCategory:GRMustacheMemoryCategoryTemplateStrings];
+    STAssertTrue(bytes < retainingBytes, @"");
+    
+    id data = @{ @"items": @[@{ @"name": @"a" }, @{ @"name": @"b" }] };
+    STAssertEqualObjects([template renderObject:data error:NULL], [retainingTemplate renderObject:data error:NULL], @"");
+}
+
+- (void)testTemplatesFromStringsRetainTheirTemplateString
+{
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepository];
+    repository.configuration.retainsTemplateStrings = NO;
+    GRMustacheTemplate *template = [repository templateFromString:@"{{#wrap}}{{name}}{{/wrap}}" error:NULL];
+    
+    __block NSString *innerTemplateString = nil;
+    id wrap = [GRMustache renderingObjectWithBlock:^NSString *(GRMustacheTag *tag, GRMustacheContext *context, BOOL *HTMLSafe, NSError **error) {
+        innerTemplateString = [[tag.innerTemplateString copy] autorelease];
+        return nil;
+    }];
+    [template renderObject:@{ @"wrap": wrap } error:NULL];
+    STAssertEqualObjects(innerTemplateString, @"{{name}}", @"");
+}
+
+@end
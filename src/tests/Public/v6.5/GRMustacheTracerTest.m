@@ -0,0 +1,135 @@
+// The MIT License
+// 
+// Copyright (c) 2013 Gwendal Roué
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#define GRMUSTACHE_VERSION_MAX_ALLOWED GRMUSTACHE_VERSION_6_5
+#import "GRMustachePublicAPITest.h"
+
+@interface GRMustacheTracerTestRecorder : NSObject<GRMustacheTracer> {
+    NSMutableArray *_events;
+}
+@property (nonatomic, retain, readonly) NSMutableArray *events;
+@end
+
+@implementation GRMustacheTracerTestRecorder
+@synthesize events=_events;
+
+- (id)init
+{
+    self = [super init];
+    if (self) {
+        _events = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_events release];
+    [super dealloc];
+}
+
+- (void)mustacheTemplate:(GRMustacheTemplate *)template willBeginSpanWithTemplateID:(id)templateID
+{
+    [_events addObject:[NSString stringWithFormat:@"begin %@", templateID ?: @"-"]];
+}
+
+- (void)mustacheTemplate:(GRMustacheTemplate *)template didEndSpanWithTemplateID:(id)templateID duration:(NSTimeInterval)duration renderedLength:(NSUInteger)renderedLength success:(BOOL)success
+{
+    if (duration < 0) {
+        [_events addObject:@"negative duration"];
+    }
+    [_events addObject:[NSString stringWithFormat:@"end %@ %lu%@", templateID ?: @"-", (unsigned long)renderedLength, success ? @"" : @" failed"]];
+}
+
+@end
+
+@interface GRMustacheTracerTest : GRMustachePublicAPITest
+@end
+
+@implementation GRMustacheTracerTest
+
+- (void)testTemplateFromStringSpan
+{
+    GRMustacheTracerTestRecorder *tracer = [[[GRMustacheTracerTestRecorder alloc] init] autorelease];
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"<{{name}}>" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingTracer:tracer];
+    [template renderObject:@{ @"name": @"foo" } error:NULL];
+    
+    NSArray *expected = @[@"begin -", @"end - 5"];
+    STAssertEqualObjects(tracer.events, expected, @"");
+}
+
+- (void)testPartialSpansNest
+{
+    GRMustacheTracerTestRecorder *tracer = [[[GRMustacheTracerTestRecorder alloc] init] autorelease];
+    NSDictionary *templates = @{ @"main": @"<{{>partial}}{{>partial}}>", @"partial": @"{{name}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingTracer:tracer];
+    [template renderObject:@{ @"name": @"foo" } error:NULL];
+    
+    NSArray *expected = @[@"begin main", @"begin partial", @"end partial 3", @"begin partial", @"end partial 3", @"end main 8"];
+    STAssertEqualObjects(tracer.events, expected, @"");
+}
+
+- (void)testOverridablePartialSpansNest
+{
+    GRMustacheTracerTestRecorder *tracer = [[[GRMustacheTracerTestRecorder alloc] init] autorelease];
+    NSDictionary *templates = @{ @"main": @"{{<layout}}{{$content}}{{>partial}}{{/content}}{{/layout}}",
+                                 @"layout": @"<{{$content}}{{/content}}>",
+                                 @"partial": @"foo" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingTracer:tracer];
+    NSString *rendering = [template renderObject:nil error:NULL];
+    STAssertEqualObjects(rendering, @"<foo>", @"");
+    
+    NSArray *expected = @[@"begin main", @"begin layout", @"begin partial", @"end partial 3", @"end layout 5", @"end main 5"];
+    STAssertEqualObjects(tracer.events, expected, @"");
+}
+
+- (void)testSpansAreBalancedWhenRenderingFails
+{
+    GRMustacheTracerTestRecorder *tracer = [[[GRMustacheTracerTestRecorder alloc] init] autorelease];
+    NSDictionary *templates = @{ @"main": @"<{{>partial}}>", @"partial": @"{{missingFilter(name)}}" };
+    GRMustacheTemplateRepository *repository = [GRMustacheTemplateRepository templateRepositoryWithDictionary:templates];
+    GRMustacheTemplate *template = [repository templateNamed:@"main" error:NULL];
+    template.baseContext = [template.baseContext contextByAddingTracer:tracer];
+    STAssertNil([template renderObject:nil error:NULL], @"");
+    
+    NSArray *expected = @[@"begin main", @"begin partial", @"end partial 0 failed", @"end main 1 failed"];
+    STAssertEqualObjects(tracer.events, expected, @"");
+}
+
+- (void)testTracerCanBeRemoved
+{
+    GRMustacheTracerTestRecorder *tracer = [[[GRMustacheTracerTestRecorder alloc] init] autorelease];
+    GRMustacheContext *context = [[GRMustacheContext context] contextByAddingTracer:tracer];
+    STAssertTrue([context contextByAddingTracer:tracer] == context, @"");
+    
+    GRMustacheTemplate *template = [GRMustacheTemplate templateFromString:@"foo" error:NULL];
+    template.baseContext = [context contextByAddingTracer:nil];
+    [template renderObject:nil error:NULL];
+    STAssertEquals(tracer.events.count, (NSUInteger)0, @"");
+}
+
+@end